@@ -0,0 +1,37 @@
+// BenchUtil.h
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+#include <string>
+
+// Timing and argument helpers shared by the benchmark programs
+namespace Bench {
+    // Milliseconds taken by fn()
+    template <typename Fn>
+    double timeMs(Fn fn) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+
+    // Positional argument `index` as a count, or fallback if it is absent
+    inline size_t argCount(int argc, char** argv, int index, size_t fallback) {
+        return argc > index ? static_cast<size_t>(std::strtoull(argv[index], nullptr, 10)) : fallback;
+    }
+
+    // FNV-1a, for comparing results between runs
+    inline uint64_t fingerprint(uint64_t hash, const std::string& text) {
+        for (unsigned char c : text) {
+            hash = (hash ^ c) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    const uint64_t FINGERPRINT_SEED = 14695981039346656037ull;
+}
+
+#endif // BENCH_UTIL_H
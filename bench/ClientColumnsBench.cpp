@@ -0,0 +1,134 @@
+// Client analytics over ClientColumns against a walk over the Client objects.
+//
+// Usage: ClientColumnsBench [clients] [repetitions]
+//
+// Generates `clients` clients (default 1,000,000) and shuffles the objects
+// so that heap order differs from iteration order, as it does after a
+// service has been running for a while. Each analytic is timed both ways
+// (averaged over `repetitions`, default 20) and the two results must agree.
+#include "include/services/ClientColumns.h"
+#include "bench/BenchUtil.h"
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <algorithm>
+
+namespace {
+    bool allAgree = true;
+
+    template <typename Result, typename Walk, typename Scan>
+    void compare(const char* name, size_t repetitions, Walk walk, Scan scan) {
+        Result walked = Result();
+        Result scanned = Result();
+        double walkMs = Bench::timeMs([&]() {
+            for (size_t i = 0; i < repetitions; i++) {
+                walked = walk();
+            }
+        }) / repetitions;
+        double scanMs = Bench::timeMs([&]() {
+            for (size_t i = 0; i < repetitions; i++) {
+                scanned = scan();
+            }
+        }) / repetitions;
+
+        bool agree = walked == scanned;
+        allAgree = allAgree && agree;
+        std::printf("%-18s %12.2f %12.2f %9.1fx%s\n", name, walkMs, scanMs, walkMs / scanMs,
+                    agree ? "" : "  MISMATCH");
+    }
+
+    std::vector<int> sorted(std::vector<int> ids) {
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t count = Bench::argCount(argc, argv, 1, 1000000);
+    size_t repetitions = std::max<size_t>(1, Bench::argCount(argc, argv, 2, 20));
+
+    std::mt19937 random(1);
+    std::vector<std::shared_ptr<Client>> objects;
+    objects.reserve(count);
+    for (size_t i = 1; i <= count; i++) {
+        auto client = std::make_shared<Client>(static_cast<int>(i), "First" + std::to_string(i), "Last",
+                                               "user@example.com", "555-123-4567", "Company", "Engineer");
+        char date[16];
+        std::snprintf(date, sizeof(date), "20%02d-%02d-%02d", 10 + static_cast<int>(random() % 15),
+                      1 + static_cast<int>(random() % 12), 1 + static_cast<int>(random() % 28));
+        client->setRegistrationDate(date);
+        if (random() % 10 != 0) {
+            client->setLastSessionDate(date);
+        }
+        client->setSessionsCompleted(static_cast<int>(random() % 40));
+        client->setBudget((random() % 100000) / 4.0);
+        objects.push_back(client);
+    }
+    std::shuffle(objects.begin(), objects.end(), random);
+
+    ClientColumns columns;
+    for (const auto& client : objects) {
+        columns.upsert(*client);
+    }
+
+    std::printf("%zu clients, ms per run\n", count);
+    std::printf("%-18s %12s %12s %10s\n", "analytic", "objects", "columns", "speedup");
+
+    compare<long long>("sum sessions", repetitions,
+        [&]() {
+            long long total = 0;
+            for (const auto& client : objects) {
+                total += client->getSessionsCompleted();
+            }
+            return total;
+        },
+        [&]() { return columns.sumSessions(); });
+
+    // Budgets are multiples of 0.25, so both summation orders are exact
+    compare<double>("sum budget", repetitions,
+        [&]() {
+            double total = 0.0;
+            for (const auto& client : objects) {
+                total += client->getBudget();
+            }
+            return total;
+        },
+        [&]() { return columns.sumBudget(); });
+
+    compare<std::vector<int>>("budget >= 20000", repetitions,
+        [&]() {
+            std::vector<int> ids;
+            for (const auto& client : objects) {
+                if (client->getBudget() >= 20000.0) {
+                    ids.push_back(client->getClientId());
+                }
+            }
+            return sorted(ids);
+        },
+        [&]() { return sorted(columns.findBudgetAtLeast(20000.0)); });
+
+    compare<std::vector<int>>("inactive since", repetitions,
+        [&]() {
+            std::vector<int> ids;
+            for (const auto& client : objects) {
+                std::string last = client->getLastSessionDate();
+                if (last.empty() || last < "2015-01-01") {
+                    ids.push_back(client->getClientId());
+                }
+            }
+            return sorted(ids);
+        },
+        [&]() { return sorted(columns.findInactiveSince(ClientColumns::encodeDate("2015-01-01"))); });
+
+    compare<std::vector<size_t>>("session histogram", repetitions,
+        [&]() {
+            std::vector<size_t> buckets(10);
+            for (const auto& client : objects) {
+                buckets[std::min<size_t>(client->getSessionsCompleted() / 5, 9)]++;
+            }
+            return buckets;
+        },
+        [&]() { return columns.sessionHistogram(5, 10); });
+
+    return allAgree ? 0 : 1;
+}
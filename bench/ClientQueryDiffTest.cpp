@@ -0,0 +1,409 @@
+// Differential check of ClientService::findClients, whose planner picks
+// and combines indexes, against evaluating every condition on every
+// client.
+//
+// Usage: ClientQueryDiffTest [clients] [queries] [seed]
+//
+// Run from a directory with data/ and logs/ subdirectories; every client
+// in data/ is removed first. Adds `clients` clients (default 20,000) with
+// random names, companies, interests, budgets, session counts and dates.
+// Each of `queries` rounds (default 2,000) applies a random mutation,
+// then builds a query from a random mix of every condition ClientQuery
+// offers, some repeated, some with malformed dates, and some with
+// where() conditions and a limit. The result must equal the scan, and
+// the plan findClients reports must have the same steps as
+// explainClientQuery's.
+#include "include/services/ClientService.h"
+#include "include/utils/Validation.h"
+#include "bench/BenchUtil.h"
+#include <cstdio>
+#include <random>
+#include <algorithm>
+
+namespace {
+    const char* const MODELS[] = {"GPT-4", "BERT", "DALL-E 3", "Claude", "Llama", "Whisper"};
+    const size_t MODEL_COUNT = sizeof(MODELS) / sizeof(MODELS[0]);
+    const char* const WORDS[] = {"Tech", "Data", "Labs", "Ana", "Ber", "Ka", "Nova", "Ri"};
+    const size_t WORD_COUNT = sizeof(WORDS) / sizeof(WORDS[0]);
+
+    size_t checked = 0;
+    size_t mismatches = 0;
+
+    // Every condition of a query, kept so the scan can test each on its own
+    struct Conditions {
+        std::vector<std::vector<int>> idLists;
+        std::vector<std::string> nameTexts;
+        std::vector<std::string> companyTexts;
+        std::vector<std::string> allOf;
+        std::vector<std::string> anyOf;
+        std::vector<std::string> noneOf;
+        std::vector<std::pair<double, bool>> budgetMinimums;    // (minimum, inclusive)
+        std::vector<double> budgetMaximums;
+        std::vector<std::pair<int, int>> sessionRanges;
+        std::vector<std::pair<std::string, std::string>> registrationRanges;
+        std::vector<std::string> inactiveSince;
+        bool evenSessions;
+        bool engineersOnly;
+        size_t limit;
+
+        Conditions() : evenSessions(false), engineersOnly(false), limit(0) {}
+    };
+
+    std::string randomDate(std::mt19937& random) {
+        char date[16];
+        std::snprintf(date, sizeof(date), "%04d-%02d-%02d", 2023 + static_cast<int>(random() % 3),
+                      1 + static_cast<int>(random() % 12), 1 + static_cast<int>(random() % 28));
+        return date;
+    }
+
+    // Mostly valid; malformed bounds must be ignored, not matched against
+    std::string randomBound(std::mt19937& random) {
+        static const char* const MALFORMED[] = {"", "2024-13-01", "2023-02-29", "soon", "2024-1-5"};
+        return random() % 8 == 0 ? MALFORMED[random() % 5] : randomDate(random);
+    }
+
+    std::string randomText(std::mt19937& random) {
+        std::string text = WORDS[random() % WORD_COUNT];
+        if (random() % 2 == 0) {
+            text += WORDS[random() % WORD_COUNT];
+        }
+        return text;
+    }
+
+    std::string randomModel(std::mt19937& random) {
+        return MODELS[random() % MODEL_COUNT];
+    }
+
+    double randomBudget(std::mt19937& random) {
+        return static_cast<double>(random() % 40) * 50.0;
+    }
+
+    std::shared_ptr<Client> makeClient(std::mt19937& random, size_t serial) {
+        auto client = std::make_shared<Client>(0, randomText(random), randomText(random),
+                                               "user" + std::to_string(serial) + "@example.com", "555-123-4567",
+                                               randomText(random) + " " + randomText(random),
+                                               random() % 3 == 0 ? "Engineer" : "Analyst");
+        client->setRegistrationDate(randomDate(random));
+        client->setSessionsCompleted(static_cast<int>(random() % 20));
+        if (random() % 4 != 0) {
+            client->setLastSessionDate(randomDate(random));
+        }
+        client->setBudget(randomBudget(random));
+        for (size_t model = 0; model < MODEL_COUNT; model++) {
+            if (random() % 3 == 0) {
+                client->addAIModel(std::string(MODELS[model]));
+            }
+        }
+        return client;
+    }
+
+    void mutate(ClientService& service, std::mt19937& random, size_t& serial) {
+        std::vector<std::shared_ptr<Client>> all = service.getAllClients();
+        if (all.empty()) {
+            service.addClient(makeClient(random, serial++));
+            return;
+        }
+
+        const Client& client = *all[random() % all.size()];
+        int clientId = client.getClientId();
+        switch (random() % 7) {
+            case 0:
+                service.updateClientBudget(clientId, randomBudget(random), random() % 2 == 0);
+                break;
+            case 1:
+                service.updateClientSessionInfo(clientId, randomDate(random));
+                break;
+            case 2:
+                service.addClientInterest(clientId, randomModel(random));
+                break;
+            case 3:
+                service.removeClientInterest(clientId, randomModel(random));
+                break;
+            case 4:
+                service.updateClientDetails(clientId, randomText(random), randomText(random), client.getEmail(),
+                                            client.getPhone(), randomText(random), client.getPosition());
+                break;
+            case 5:
+                service.removeClient(clientId);
+                break;
+            default:
+                service.addClient(makeClient(random, serial++));
+                break;
+        }
+    }
+
+    void addUnindexedConditions(std::mt19937& random, ClientQuery& query, Conditions& conditions) {
+        if (random() % 4 == 0) {
+            conditions.evenSessions = true;
+            query.where("even session count", [](const Client& client) {
+                return client.getSessionsCompleted() % 2 == 0;
+            });
+        }
+        if (random() % 4 == 0) {
+            conditions.engineersOnly = true;
+            query.where("engineers", [](const Client& client) { return client.getPosition() == "Engineer"; });
+        }
+        if (random() % 4 == 0) {
+            conditions.limit = 1 + random() % 50;
+            query.limit(conditions.limit);
+        }
+    }
+
+    // One in ten queries has no indexed condition, so the planner scans
+    ClientQuery makeQuery(std::mt19937& random, const std::vector<std::shared_ptr<Client>>& all,
+                          Conditions& conditions) {
+        ClientQuery query;
+        if (random() % 10 == 0) {
+            addUnindexedConditions(random, query, conditions);
+            return query;
+        }
+        for (size_t i = random() % 2 == 0 ? 0 : random() % 3; i > 0; i--) {
+            std::vector<int> ids;
+            size_t count = random() % 200;
+            for (size_t k = 0; k < count && !all.empty(); k++) {
+                // Some listed IDs do not exist
+                int clientId = all[random() % all.size()]->getClientId();
+                ids.push_back(random() % 10 == 0 ? -static_cast<int>(k) : clientId);
+            }
+            query.idIn(ids);
+            conditions.idLists.push_back(ids);
+        }
+        for (size_t i = random() % 3; i > 0; i--) {
+            std::string text = randomText(random).substr(0, 1 + random() % 6);
+            query.nameContains(text);
+            conditions.nameTexts.push_back(text);
+        }
+        for (size_t i = random() % 3; i > 0; i--) {
+            std::string text = randomText(random).substr(random() % 2, 1 + random() % 6);
+            query.companyContains(text);
+            conditions.companyTexts.push_back(text);
+        }
+        for (size_t i = random() % 3; i > 0; i--) {
+            conditions.allOf.push_back(randomModel(random));
+            query.interestedIn(conditions.allOf.back());
+        }
+        if (random() % 3 == 0) {
+            std::vector<std::string> models;
+            for (size_t i = 1 + random() % 3; i > 0; i--) {
+                models.push_back(randomModel(random));
+            }
+            query.interestedInAny(models);
+            conditions.anyOf.insert(conditions.anyOf.end(), models.begin(), models.end());
+        }
+        for (size_t i = random() % 2; i > 0; i--) {
+            conditions.noneOf.push_back(randomModel(random));
+            query.notInterestedIn(conditions.noneOf.back());
+        }
+        for (size_t i = random() % 3; i > 0; i--) {
+            double minimum = randomBudget(random);
+            bool inclusive = random() % 2 == 0;
+            if (inclusive) {
+                query.budgetAtLeast(minimum);
+            } else {
+                query.budgetAbove(minimum);
+            }
+            conditions.budgetMinimums.push_back(std::make_pair(minimum, inclusive));
+        }
+        if (random() % 3 == 0) {
+            conditions.budgetMaximums.push_back(randomBudget(random));
+            query.budgetAtMost(conditions.budgetMaximums.back());
+        }
+        if (random() % 3 == 0) {
+            int minimum = static_cast<int>(random() % 15);
+            int maximum = minimum + static_cast<int>(random() % 10);
+            query.sessionsBetween(minimum, maximum);
+            conditions.sessionRanges.push_back(std::make_pair(minimum, maximum));
+        }
+        if (random() % 3 == 0) {
+            std::string from = randomBound(random);
+            std::string to = randomBound(random);
+            query.registeredBetween(from, to);
+            conditions.registrationRanges.push_back(std::make_pair(from, to));
+        }
+        if (random() % 3 == 0) {
+            conditions.inactiveSince.push_back(randomBound(random));
+            query.noSessionSince(conditions.inactiveSince.back());
+        }
+        addUnindexedConditions(random, query, conditions);
+        return query;
+    }
+
+    std::string lowered(const std::string& text) {
+        std::string lower = text;
+        std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+        return lower;
+    }
+
+    bool contains(const std::string& text, const std::string& part) {
+        return lowered(text).find(lowered(part)) != std::string::npos;
+    }
+
+    bool hasInterest(const std::vector<std::string>& interests, const std::string& model) {
+        return std::find(interests.begin(), interests.end(), model) != interests.end();
+    }
+
+    bool matches(const Client& client, const Conditions& conditions) {
+        for (const auto& ids : conditions.idLists) {
+            if (std::find(ids.begin(), ids.end(), client.getClientId()) == ids.end()) {
+                return false;
+            }
+        }
+        for (const auto& text : conditions.nameTexts) {
+            if (!contains(client.getFullName(), text)) {
+                return false;
+            }
+        }
+        for (const auto& text : conditions.companyTexts) {
+            if (!contains(client.getCompany(), text)) {
+                return false;
+            }
+        }
+
+        std::vector<std::string> interests = client.getAIModelsOfInterest();
+        for (const auto& model : conditions.allOf) {
+            if (!hasInterest(interests, model)) {
+                return false;
+            }
+        }
+        bool anyOf = conditions.anyOf.empty();
+        for (const auto& model : conditions.anyOf) {
+            anyOf = anyOf || hasInterest(interests, model);
+        }
+        if (!anyOf) {
+            return false;
+        }
+        for (const auto& model : conditions.noneOf) {
+            if (hasInterest(interests, model)) {
+                return false;
+            }
+        }
+
+        double budget = client.getBudget();
+        for (const auto& minimum : conditions.budgetMinimums) {
+            if (minimum.second ? budget < minimum.first : budget <= minimum.first) {
+                return false;
+            }
+        }
+        for (double maximum : conditions.budgetMaximums) {
+            if (budget > maximum) {
+                return false;
+            }
+        }
+        int sessions = client.getSessionsCompleted();
+        for (const auto& range : conditions.sessionRanges) {
+            if (sessions < range.first || sessions > range.second) {
+                return false;
+            }
+        }
+
+        // Dates are compared as text, which orders valid YYYY-MM-DD dates;
+        // an unset date is empty and sorts first
+        std::string registered = client.getRegistrationDate();
+        for (const auto& range : conditions.registrationRanges) {
+            if ((Validation::isValidDate(range.first) && registered < range.first) ||
+                (Validation::isValidDate(range.second) && registered > range.second)) {
+                return false;
+            }
+        }
+        for (const auto& date : conditions.inactiveSince) {
+            if (Validation::isValidDate(date) && client.getLastSessionDate() >= date) {
+                return false;
+            }
+        }
+
+        if (conditions.evenSessions && sessions % 2 != 0) {
+            return false;
+        }
+        return !conditions.engineersOnly || client.getPosition() == "Engineer";
+    }
+
+    std::vector<int> scan(const std::vector<std::shared_ptr<Client>>& all, const Conditions& conditions) {
+        std::vector<int> ids;
+        for (const auto& client : all) {
+            if (matches(*client, conditions)) {
+                ids.push_back(client->getClientId());
+            }
+        }
+        std::sort(ids.begin(), ids.end());
+        if (conditions.limit > 0 && ids.size() > conditions.limit) {
+            ids.resize(conditions.limit);
+        }
+        return ids;
+    }
+
+    bool sameSteps(const ClientQueryPlan& left, const ClientQueryPlan& right) {
+        if (left.steps.size() != right.steps.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < left.steps.size(); i++) {
+            if (left.steps[i].access != right.steps[i].access || left.steps[i].source != right.steps[i].source ||
+                left.steps[i].condition != right.steps[i].condition) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void check(const std::string& what, bool same, const ClientQueryPlan& plan) {
+        checked++;
+        if (!same) {
+            mismatches++;
+            if (mismatches <= 10) {
+                std::printf("MISMATCH %s\n%s", what.c_str(), plan.toString().c_str());
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t clientCount = Bench::argCount(argc, argv, 1, 20000);
+    size_t rounds = Bench::argCount(argc, argv, 2, 2000);
+    std::mt19937 random(static_cast<unsigned>(Bench::argCount(argc, argv, 3, 1)));
+
+    Logger::getInstance().setMinLevel(LogLevel::ERROR);
+    ClientService service;
+    service.setJournalSyncPolicy(JournalSyncPolicy::Never);
+    for (const auto& client : service.getAllClients()) {
+        service.removeClient(client->getClientId());
+    }
+
+    size_t serial = 0;
+    std::vector<std::shared_ptr<Client>> batch;
+    for (size_t i = 0; i < clientCount; i++) {
+        batch.push_back(makeClient(random, serial++));
+    }
+    service.addClients(batch);
+
+    size_t accessCounts[ACCESS_LIMIT + 1] = {0};
+    double ms = Bench::timeMs([&]() {
+        for (size_t round = 0; round < rounds; round++) {
+            mutate(service, random, serial);
+            std::vector<std::shared_ptr<Client>> all = service.getAllClients();
+
+            Conditions conditions;
+            ClientQuery query = makeQuery(random, all, conditions);
+            ClientQueryPlan plan;
+            std::vector<int> actual;
+            for (const auto& client : service.findClients(query, &plan)) {
+                actual.push_back(client->getClientId());
+            }
+            std::vector<int> expected = scan(all, conditions);
+            check("findClients: scan " + std::to_string(expected.size()) + " ids, planner " +
+                  std::to_string(actual.size()), actual == expected, plan);
+            check("explainClientQuery differs from the executed plan",
+                  sameSteps(service.explainClientQuery(query), plan), plan);
+            check("last step reports " + std::to_string(plan.steps.back().actualRows) + " rows",
+                  plan.steps.back().actualRows == actual.size(), plan);
+
+            for (const auto& step : plan.steps) {
+                accessCounts[step.access]++;
+            }
+        }
+    });
+
+    std::printf("%zu checks in %.0f ms, %zu mismatches\n", checked, ms, mismatches);
+    std::printf("steps: %zu scan, %zu drive, %zu intersect, %zu probe, %zu filter, %zu limit\n",
+                accessCounts[ACCESS_SCAN], accessCounts[ACCESS_DRIVE], accessCounts[ACCESS_INTERSECT],
+                accessCounts[ACCESS_PROBE], accessCounts[ACCESS_FILTER], accessCounts[ACCESS_LIMIT]);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,197 @@
+// Differential check of ClientService's trigram name and company search
+// against a scan of every client.
+//
+// Usage: ClientSearchDiffTest [clients] [queries] [seed]
+//
+// Run from a directory with data/ and logs/ subdirectories; every client
+// in data/ is removed first. Adds `clients` clients (default 20,000) with
+// names and companies built from a few shared syllables, so that queries
+// hit many overlapping posting lists. Then runs `queries` rounds (default
+// 2,000), each of which renames, removes or adds a client and then
+// searches by name and by company, plain and ranked. Queries are cut from
+// existing text or made up from the same syllables, in mixed case and of
+// every length from 0 up. Plain results must equal the scan in ID order;
+// ranked results must equal the scan sorted by (prefix, word start,
+// anywhere), then text length, then ID.
+#include "include/services/ClientService.h"
+#include "bench/BenchUtil.h"
+#include <cstdio>
+#include <cctype>
+#include <random>
+#include <tuple>
+#include <algorithm>
+
+namespace {
+    const char* const SYLLABLES[] = {"an", "na", "ber", "ta", "li", "mo", "ri", "el", "o", "ka", "tech", "-"};
+    const size_t SYLLABLE_COUNT = sizeof(SYLLABLES) / sizeof(SYLLABLES[0]);
+
+    size_t checked = 0;
+    size_t mismatches = 0;
+
+    std::string word(std::mt19937& random, size_t syllables) {
+        std::string text;
+        for (size_t i = 0; i < syllables; i++) {
+            text += SYLLABLES[random() % SYLLABLE_COUNT];
+        }
+        if (!text.empty() && random() % 2 == 0) {
+            text[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(text[0])));
+        }
+        return text;
+    }
+
+    std::string company(std::mt19937& random) {
+        std::string text = word(random, 1 + random() % 3);
+        if (random() % 2 == 0) {
+            text += " " + word(random, 1 + random() % 2);
+        }
+        return text;
+    }
+
+    std::shared_ptr<Client> makeClient(std::mt19937& random, size_t serial) {
+        return std::make_shared<Client>(0, word(random, 1 + random() % 3), word(random, 1 + random() % 3),
+                                        "user" + std::to_string(serial) + "@example.com", "555-123-4567",
+                                        company(random), "Engineer");
+    }
+
+    std::string lowered(const std::string& text) {
+        std::string lower = text;
+        std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+        return lower;
+    }
+
+    std::string mixedCase(std::mt19937& random, std::string text) {
+        for (char& c : text) {
+            if (random() % 3 == 0) {
+                c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+            }
+        }
+        return text;
+    }
+
+    // A piece of some client's text, or syllables that may match nothing
+    std::string makeQuery(std::mt19937& random, const std::vector<std::shared_ptr<Client>>& all, bool byName) {
+        if (all.empty() || random() % 3 == 0) {
+            return mixedCase(random, word(random, random() % 4));
+        }
+        const Client& client = *all[random() % all.size()];
+        std::string text = byName ? client.getFullName() : client.getCompany();
+        size_t start = random() % (text.size() + 1);
+        size_t length = random() % 9;
+        return mixedCase(random, text.substr(start, length));
+    }
+
+    // Best match quality over every occurrence: 0 at the start of the
+    // text, 1 at the start of a word, 2 anywhere else
+    int matchQuality(const std::string& text, const std::string& query) {
+        int best = 3;
+        for (size_t pos = text.find(query); pos != std::string::npos; pos = text.find(query, pos + 1)) {
+            int quality = pos == 0 ? 0 : (std::isalnum(static_cast<unsigned char>(text[pos - 1])) ? 2 : 1);
+            best = std::min(best, quality);
+        }
+        return best;
+    }
+
+    std::vector<int> idsOf(const std::vector<std::shared_ptr<Client>>& clients) {
+        std::vector<int> ids;
+        for (const auto& client : clients) {
+            ids.push_back(client->getClientId());
+        }
+        return ids;
+    }
+
+    void compare(const char* what, const std::string& query, const std::vector<int>& expected,
+                 const std::vector<int>& actual) {
+        checked++;
+        if (actual != expected) {
+            mismatches++;
+            if (mismatches <= 20) {
+                std::printf("MISMATCH %s(\"%s\"): scan %zu ids, index %zu ids\n", what, query.c_str(),
+                            expected.size(), actual.size());
+            }
+        }
+    }
+
+    void check(const ClientService& service, const std::vector<std::shared_ptr<Client>>& all, bool byName,
+               const std::string& query, size_t limit) {
+        std::string needle = lowered(query);
+        typedef std::tuple<int, size_t, int> Rank;
+        std::vector<Rank> ranked;
+        std::vector<int> expected;
+        for (const auto& client : all) {
+            std::string text = lowered(byName ? client->getFullName() : client->getCompany());
+            if (text.find(needle) != std::string::npos) {
+                expected.push_back(client->getClientId());
+                ranked.push_back(Rank(matchQuality(text, needle), text.size(), client->getClientId()));
+            }
+        }
+        std::sort(expected.begin(), expected.end());
+        std::sort(ranked.begin(), ranked.end());
+
+        std::vector<int> expectedRanked;
+        for (size_t i = 0; i < ranked.size() && i < limit; i++) {
+            expectedRanked.push_back(std::get<2>(ranked[i]));
+        }
+
+        if (byName) {
+            compare("searchClientsByName", query, expected, idsOf(service.searchClientsByName(query)));
+            compare("searchClientsByName ranked", query, expectedRanked,
+                    idsOf(service.searchClientsByName(query, limit)));
+        } else {
+            compare("searchClientsByCompany", query, expected, idsOf(service.searchClientsByCompany(query)));
+            compare("searchClientsByCompany ranked", query, expectedRanked,
+                    idsOf(service.searchClientsByCompany(query, limit)));
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t clientCount = Bench::argCount(argc, argv, 1, 20000);
+    size_t rounds = Bench::argCount(argc, argv, 2, 2000);
+    std::mt19937 random(static_cast<unsigned>(Bench::argCount(argc, argv, 3, 1)));
+
+    Logger::getInstance().setMinLevel(LogLevel::WARNING);
+    ClientService service;
+    service.setJournalSyncPolicy(JournalSyncPolicy::Never);
+    for (const auto& client : service.getAllClients()) {
+        service.removeClient(client->getClientId());
+    }
+
+    size_t serial = 0;
+    std::vector<std::shared_ptr<Client>> batch;
+    for (size_t i = 0; i < clientCount; i++) {
+        batch.push_back(makeClient(random, serial++));
+    }
+    service.addClients(batch);
+
+    double ms = Bench::timeMs([&]() {
+        for (size_t round = 0; round < rounds; round++) {
+            std::vector<std::shared_ptr<Client>> all = service.getAllClients();
+            if (!all.empty()) {
+                const Client& client = *all[random() % all.size()];
+                switch (random() % 3) {
+                    case 0:
+                        service.updateClientDetails(client.getClientId(), word(random, 1 + random() % 3),
+                                                    word(random, 1 + random() % 3), client.getEmail(),
+                                                    client.getPhone(), company(random), client.getPosition());
+                        break;
+                    case 1:
+                        service.removeClient(client.getClientId());
+                        break;
+                    default:
+                        service.addClient(makeClient(random, serial++));
+                        break;
+                }
+                all = service.getAllClients();
+            }
+
+            // Short limits are mostly filled by prefix matches, so some
+            // rounds rank every match
+            size_t limit = random() % 4 == 0 ? all.size() : 1 + random() % 20;
+            check(service, all, true, makeQuery(random, all, true), limit);
+            check(service, all, false, makeQuery(random, all, false), limit);
+        }
+    });
+
+    std::printf("%zu searches checked in %.0f ms, %zu mismatches\n", checked, ms, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
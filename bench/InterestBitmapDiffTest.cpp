@@ -0,0 +1,251 @@
+// Differential check of CompressedBitmap and ClientService's interest
+// index against sorted-vector set algebra and a scan of every client.
+//
+// Usage: InterestBitmapDiffTest [clients] [rounds] [seed]
+//
+// Run from a directory with data/ and logs/ subdirectories; every client
+// in data/ is removed first.
+//
+// The bitmap part runs `rounds` rounds (default 2,000) of random adds and
+// removes on pairs of bitmaps whose values cluster around the 4,096-value
+// point where a container turns from an array into a bitmap, and spread
+// over several containers. Contents and AND, OR and ANDNOT must match
+// std::set_* on sorted vectors.
+//
+// The service part adds `clients` clients (default 20,000) interested in
+// a few of ten models, some popular enough for bitmap containers. Each of
+// `rounds` rounds adds or removes an interest, removes a client or adds
+// one, then runs a random all-of / any-of / none-of query, including a
+// model no client has heard of. Results must match a scan of each
+// client's interests.
+#include "include/services/ClientService.h"
+#include "include/utils/CompressedBitmap.h"
+#include "bench/BenchUtil.h"
+#include <cstdio>
+#include <random>
+#include <iterator>
+#include <algorithm>
+
+namespace {
+    const char* const MODELS[] = {"GPT-4", "BERT", "DALL-E 3", "Claude", "Llama", "T5", "Whisper",
+                                  "Stable Diffusion", "Gemini", "Mistral"};
+    const size_t MODEL_COUNT = sizeof(MODELS) / sizeof(MODELS[0]);
+    const char* const UNKNOWN_MODEL = "No Such Model";
+
+    size_t checked = 0;
+    size_t mismatches = 0;
+
+    void check(const std::string& what, bool same) {
+        checked++;
+        if (!same) {
+            mismatches++;
+            if (mismatches <= 20) {
+                std::printf("MISMATCH %s\n", what.c_str());
+            }
+        }
+    }
+
+    template <typename T>
+    void compare(const std::string& what, const std::vector<T>& expected, const std::vector<T>& actual) {
+        check(what + ": expected " + std::to_string(expected.size()) + " values, got " +
+              std::to_string(actual.size()), actual == expected);
+    }
+
+    // Mostly in one container, near the array/bitmap switch, with a tail
+    // across the next few containers
+    uint32_t randomValue(std::mt19937& random) {
+        if (random() % 8 == 0) {
+            return static_cast<uint32_t>(random() % (4 << 16));
+        }
+        return static_cast<uint32_t>(random() % 8500);
+    }
+
+    void checkBitmaps(std::mt19937& random, size_t rounds) {
+        CompressedBitmap bitmaps[2];
+        std::vector<uint32_t> sets[2];
+        for (size_t round = 0; round < rounds; round++) {
+            // Grow towards the switch point, then shrink back through it
+            for (int side = 0; side < 2; side++) {
+                bool growing = (round / 200 + side) % 2 == 0;
+                for (int i = 0; i < 40; i++) {
+                    uint32_t value = randomValue(random);
+                    std::vector<uint32_t>& set = sets[side];
+                    auto at = std::lower_bound(set.begin(), set.end(), value);
+                    bool present = at != set.end() && *at == value;
+                    if (growing || random() % 4 == 0) {
+                        check("add(" + std::to_string(value) + ") return value",
+                              bitmaps[side].add(value) != present);
+                        if (!present) {
+                            set.insert(at, value);
+                        }
+                    } else {
+                        if (!set.empty()) {
+                            value = set[random() % set.size()];
+                            at = std::lower_bound(set.begin(), set.end(), value);
+                            present = true;
+                        }
+                        check("remove(" + std::to_string(value) + ") return value",
+                              bitmaps[side].remove(value) == present);
+                        if (present) {
+                            set.erase(at);
+                        }
+                    }
+                }
+                compare("bitmap contents", sets[side], bitmaps[side].toVector());
+                check("size()", bitmaps[side].size() == sets[side].size());
+                uint32_t probe = randomValue(random);
+                bool expected = std::binary_search(sets[side].begin(), sets[side].end(), probe);
+                check("contains(" + std::to_string(probe) + ")", bitmaps[side].contains(probe) == expected);
+            }
+
+            std::vector<uint32_t> expected;
+            std::set_intersection(sets[0].begin(), sets[0].end(), sets[1].begin(), sets[1].end(),
+                                  std::back_inserter(expected));
+            compare("AND", expected, bitmaps[0].intersect(bitmaps[1]).toVector());
+            expected.clear();
+            std::set_union(sets[0].begin(), sets[0].end(), sets[1].begin(), sets[1].end(),
+                           std::back_inserter(expected));
+            compare("OR", expected, bitmaps[0].unite(bitmaps[1]).toVector());
+            expected.clear();
+            std::set_difference(sets[0].begin(), sets[0].end(), sets[1].begin(), sets[1].end(),
+                                std::back_inserter(expected));
+            compare("ANDNOT", expected, bitmaps[0].subtract(bitmaps[1]).toVector());
+        }
+    }
+
+    // The first models are popular enough for bitmap containers
+    std::shared_ptr<Client> makeClient(std::mt19937& random, size_t serial) {
+        auto client = std::make_shared<Client>(0, "First" + std::to_string(serial), "Last",
+                                               "user" + std::to_string(serial) + "@example.com",
+                                               "555-123-4567", "Company", "Engineer");
+        for (size_t model = 0; model < MODEL_COUNT; model++) {
+            if (random() % (model + 2) == 0) {
+                client->addAIModel(std::string(MODELS[model]));
+            }
+        }
+        return client;
+    }
+
+    std::string randomModel(std::mt19937& random) {
+        return random() % 20 == 0 ? UNKNOWN_MODEL : MODELS[random() % MODEL_COUNT];
+    }
+
+    std::vector<std::string> randomModels(std::mt19937& random, size_t maxCount) {
+        std::vector<std::string> models;
+        size_t count = random() % (maxCount + 1);
+        for (size_t i = 0; i < count; i++) {
+            models.push_back(randomModel(random));
+        }
+        return models;
+    }
+
+    std::string describe(const std::vector<std::string>& allOf, const std::vector<std::string>& anyOf,
+                         const std::vector<std::string>& noneOf) {
+        std::string text;
+        for (const auto* part : {&allOf, &anyOf, &noneOf}) {
+            text += text.empty() ? "[" : "] [";
+            for (size_t i = 0; i < part->size(); i++) {
+                text += (i > 0 ? ", " : "") + (*part)[i];
+            }
+        }
+        return "getClientsByInterest(" + text + "])";
+    }
+
+    bool hasInterest(const std::vector<std::string>& interests, const std::string& model) {
+        return std::find(interests.begin(), interests.end(), model) != interests.end();
+    }
+
+    std::vector<int> scan(const ClientService& service, const std::vector<std::string>& allOf,
+                          const std::vector<std::string>& anyOf, const std::vector<std::string>& noneOf) {
+        std::vector<int> ids;
+        for (const auto& client : service.getAllClients()) {
+            std::vector<std::string> interests = client->getAIModelsOfInterest();
+            bool matches = anyOf.empty();
+            for (const auto& model : anyOf) {
+                matches = matches || hasInterest(interests, model);
+            }
+            for (const auto& model : allOf) {
+                matches = matches && hasInterest(interests, model);
+            }
+            for (const auto& model : noneOf) {
+                matches = matches && !hasInterest(interests, model);
+            }
+            if (matches) {
+                ids.push_back(client->getClientId());
+            }
+        }
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    }
+
+    std::vector<int> idsOf(const std::vector<std::shared_ptr<Client>>& clients) {
+        std::vector<int> ids;
+        for (const auto& client : clients) {
+            ids.push_back(client->getClientId());
+        }
+        return ids;
+    }
+
+    void checkService(std::mt19937& random, size_t clientCount, size_t rounds) {
+        ClientService service;
+        service.setJournalSyncPolicy(JournalSyncPolicy::Never);
+        for (const auto& client : service.getAllClients()) {
+            service.removeClient(client->getClientId());
+        }
+
+        size_t serial = 0;
+        std::vector<std::shared_ptr<Client>> batch;
+        for (size_t i = 0; i < clientCount; i++) {
+            batch.push_back(makeClient(random, serial++));
+        }
+        service.addClients(batch);
+
+        for (size_t round = 0; round < rounds; round++) {
+            std::vector<std::shared_ptr<Client>> all = service.getAllClients();
+            if (!all.empty()) {
+                int clientId = all[random() % all.size()]->getClientId();
+                switch (random() % 6) {
+                    case 0:
+                    case 1:
+                        service.addClientInterest(clientId, randomModel(random));
+                        break;
+                    case 2:
+                    case 3:
+                        service.removeClientInterest(clientId, randomModel(random));
+                        break;
+                    case 4:
+                        service.removeClient(clientId);
+                        break;
+                    default:
+                        service.addClient(makeClient(random, serial++));
+                        break;
+                }
+            }
+
+            std::vector<std::string> allOf = randomModels(random, 2);
+            std::vector<std::string> anyOf = randomModels(random, 3);
+            std::vector<std::string> noneOf = randomModels(random, 2);
+            compare(describe(allOf, anyOf, noneOf), scan(service, allOf, anyOf, noneOf),
+                    idsOf(service.getClientsByInterest(allOf, anyOf, noneOf)));
+
+            std::string model = randomModel(random);
+            compare("getClientsInterestedInModel(" + model + ")", scan(service, {model}, {}, {}),
+                    idsOf(service.getClientsInterestedInModel(model)));
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t clientCount = Bench::argCount(argc, argv, 1, 20000);
+    size_t rounds = Bench::argCount(argc, argv, 2, 2000);
+    std::mt19937 random(static_cast<unsigned>(Bench::argCount(argc, argv, 3, 1)));
+    Logger::getInstance().setMinLevel(LogLevel::WARNING);
+
+    double bitmapMs = Bench::timeMs([&]() { checkBitmaps(random, rounds); });
+    size_t bitmapChecks = checked;
+    double serviceMs = Bench::timeMs([&]() { checkService(random, clientCount, rounds); });
+
+    std::printf("%zu bitmap checks in %.0f ms, %zu interest queries in %.0f ms, %zu mismatches\n",
+                bitmapChecks, bitmapMs, checked - bitmapChecks, serviceMs, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,96 @@
+// Per-lookup latency of the ID indexes behind RecordTable, from 1k records
+// up to maxRecords.
+//
+// Usage: LookupBench [maxRecords] [queries]
+//
+// For each size (1k, 10k, ... up to maxRecords, default 10M) runs
+// `queries` random lookups (default 2M) against:
+//   dense   - source rows with compact IDs (ID-to-row array)
+//   sparse  - source rows with IDs seven apart (hash index)
+//   overlay - records added after load (IndexedRepository)
+// Every queried ID exists, and a lookup of a missing ID must fail.
+#include "include/services/RecordTable.h"
+#include "include/services/IndexedRepository.h"
+#include "include/models/Client.h"
+#include "bench/BenchUtil.h"
+#include <cstdio>
+#include <random>
+
+namespace {
+    // Rows whose IDs are 1, 1 + stride, 1 + 2 * stride, ...; never decoded
+    class GeneratedSource : public RecordSource<Client> {
+    private:
+        size_t rows;
+        int stride;
+
+    public:
+        GeneratedSource(size_t rows, int stride) : rows(rows), stride(stride) {}
+
+        size_t getRecordCount() const override { return rows; }
+        int getRecordId(size_t row) const override { return 1 + static_cast<int>(row) * stride; }
+        Client decodeRecord(size_t row) const override {
+            return Client(getRecordId(row), "First", "Last", "user@example.com", "555-123-4567", "Company", "Engineer");
+        }
+    };
+
+    int clientIdOf(const Client& client) {
+        return client.getClientId();
+    }
+
+    double nsPerLookup(double ms, size_t queries) {
+        return ms * 1e6 / queries;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t maxRecords = Bench::argCount(argc, argv, 1, 10000000);
+    size_t queries = Bench::argCount(argc, argv, 2, 2000000);
+
+    std::printf("%10s %12s %12s %12s\n", "records", "dense ns", "sparse ns", "overlay ns");
+    bool correct = true;
+    for (size_t records = 1000; records <= maxRecords; records *= 10) {
+        std::mt19937 random(1);
+        std::vector<int> ids(queries);
+        for (auto& id : ids) {
+            id = 1 + static_cast<int>(random() % records);
+        }
+
+        size_t found = 0;
+        RecordTable<Client> dense(clientIdOf);
+        dense.attach(std::make_shared<GeneratedSource>(records, 1));
+        double denseMs = Bench::timeMs([&]() {
+            for (int id : ids) {
+                found += dense.contains(id);
+            }
+        });
+
+        RecordTable<Client> sparse(clientIdOf);
+        sparse.attach(std::make_shared<GeneratedSource>(records, 7));
+        double sparseMs = Bench::timeMs([&]() {
+            for (int id : ids) {
+                found += sparse.contains(1 + (id - 1) * 7);
+            }
+        });
+
+        IndexedRepository<Client> overlay(clientIdOf);
+        overlay.reserve(records);
+        auto shared = std::make_shared<Client>(1, "First", "Last", "user@example.com", "555-123-4567", "Company",
+                                               "Engineer");
+        for (size_t id = 1; id <= records; id++) {
+            overlay.put(static_cast<int>(id), shared);
+        }
+        double overlayMs = Bench::timeMs([&]() {
+            for (int id : ids) {
+                found += overlay.get(id) != nullptr;
+            }
+        });
+
+        bool exact = found == 3 * queries && !dense.contains(static_cast<int>(records) + 1) &&
+                           !sparse.contains(2) && !overlay.contains(static_cast<int>(records) + 1);
+        correct = correct && exact;
+        std::printf("%10zu %12.1f %12.1f %12.1f%s\n", records, nsPerLookup(denseMs, queries),
+                    nsPerLookup(sparseMs, queries), nsPerLookup(overlayMs, queries),
+                    exact ? "" : "  WRONG RESULT");
+    }
+    return correct ? 0 : 1;
+}
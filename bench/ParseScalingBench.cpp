@@ -0,0 +1,77 @@
+// Parse scaling of FileService::loadFromFile over a generated text file.
+//
+// Usage: ParseScalingBench [lines] [maxThreads] [file]
+//
+// Writes `lines` client records (default 5,000,000) as pipe-delimited
+// text, then loads the file with 1, 2, 4, ... parse threads up to
+// maxThreads (default: the core count). Every run must return the same
+// records in the same order as the single-threaded one.
+#include "include/services/ClientFileService.h"
+#include "bench/BenchUtil.h"
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <algorithm>
+
+namespace {
+    uint64_t fingerprintOf(const std::vector<Client>& clients) {
+        uint64_t hash = Bench::FINGERPRINT_SEED;
+        for (const auto& client : clients) {
+            hash = Bench::fingerprint(hash, std::to_string(client.getClientId()));
+            hash = Bench::fingerprint(hash, client.getEmail());
+            hash = Bench::fingerprint(hash, client.getCompany());
+            hash = Bench::fingerprint(hash, std::to_string(client.getSessionsCompleted()));
+        }
+        return hash;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t lines = Bench::argCount(argc, argv, 1, 5000000);
+    unsigned maxThreads = static_cast<unsigned>(
+        Bench::argCount(argc, argv, 2, std::max(1u, std::thread::hardware_concurrency())));
+    std::string path = argc > 3 ? argv[3] : "parse_scaling_bench.dat";
+
+    ClientFileService files(path, StorageFormat::Text);
+    double writeMs = Bench::timeMs([&]() {
+        std::ofstream out(path, std::ios::trunc);
+        for (size_t i = 1; i <= lines; i++) {
+            Client client(static_cast<int>(i), "First" + std::to_string(i % 1000), "Last" + std::to_string(i % 3000),
+                          "user" + std::to_string(i) + "@example.com", "555-123-4567",
+                          "Company" + std::to_string(i % 500), "Engineer");
+            client.setSessionsCompleted(static_cast<int>(i % 50));
+            client.setBudget(static_cast<double>(i % 10000));
+            out << files.serialize(client) << '\n';
+        }
+    });
+    std::printf("Generated %zu lines in %.0f ms (%s)\n", lines, writeMs, path.c_str());
+    std::printf("%8s %12s %10s %14s\n", "threads", "ms", "speedup", "records/s");
+
+    std::vector<unsigned> threadCounts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+
+    bool consistent = true;
+    double baseMs = 0.0;
+    uint64_t baseFingerprint = 0;
+    for (unsigned threads : threadCounts) {
+        files.setParseThreads(threads);
+        std::vector<Client> clients;
+        double ms = Bench::timeMs([&]() { clients = files.loadFromFile(); });
+
+        uint64_t hash = fingerprintOf(clients);
+        if (threads == 1) {
+            baseMs = ms;
+            baseFingerprint = hash;
+        }
+        bool same = clients.size() == lines && hash == baseFingerprint;
+        consistent = consistent && same;
+        std::printf("%8u %12.1f %9.2fx %14.0f%s\n", threads, ms, baseMs / ms, clients.size() / (ms / 1000.0),
+                    same ? "" : "  MISMATCH");
+    }
+
+    std::remove(path.c_str());
+    return consistent ? 0 : 1;
+}
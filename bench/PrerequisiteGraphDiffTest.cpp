@@ -0,0 +1,306 @@
+// Differential check of AIModelService's prerequisite graph against
+// closures computed from the edge rules by a plain graph walk.
+//
+// Usage: PrerequisiteGraphDiffTest [models] [rounds] [seed]
+//
+// Run from a directory with data/ and logs/ subdirectories; every model
+// in data/ is removed first. Adds `models` models (default 300) spread
+// over categories of about ten, at complexity 1 to 5. Each of `rounds`
+// rounds (default 2,000) adds or removes a prerequisite edit, moves a
+// model to another level or category, renames one, or replaces one.
+// Every 16 rounds, and at the end, each model's prerequisites and
+// dependents must equal the walk, listed prerequisites first, and a few
+// clients' learning paths must hold exactly the models they have not
+// mastered, in the same order. Checks while the edits and levels make a
+// cycle are counted and skipped; the ones after it is broken again must
+// pass. The final graph must also come back the same from journal replay
+// and from a saved snapshot.
+//
+// The expected edges: each model requires the models of its category at
+// the next lower complexity present, less the edges removed for it, plus
+// the ones added for it. Only models no edit names are moved, since an
+// edit made against one level is not meant to follow the model to
+// another.
+#include "include/services/AIModelService.h"
+#include "bench/BenchUtil.h"
+#include <cstdio>
+#include <random>
+#include <set>
+#include <iterator>
+#include <algorithm>
+
+namespace {
+    typedef std::map<int, std::vector<int>> Closures;
+    typedef std::set<std::pair<int, int>> Edges;    // (model, prerequisite)
+
+    size_t checked = 0;
+    size_t mismatches = 0;
+    size_t cyclic = 0;
+
+    void check(const std::string& what, bool same) {
+        checked++;
+        if (!same) {
+            mismatches++;
+            if (mismatches <= 20) {
+                std::printf("MISMATCH %s\n", what.c_str());
+            }
+        }
+    }
+
+    std::vector<int> idsOf(const std::vector<std::shared_ptr<AIModel>>& models) {
+        std::vector<int> ids;
+        for (const auto& model : models) {
+            ids.push_back(model->getModelId());
+        }
+        return ids;
+    }
+
+    std::vector<int> sorted(std::vector<int> ids) {
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    }
+
+    // Transitive prerequisites of every model, in ID order
+    Closures expectedPrerequisites(const AIModelService& service, const Edges& added, const Edges& removed) {
+        std::vector<std::shared_ptr<AIModel>> all = service.getAllModels();
+        std::map<int, std::set<int>> direct;
+        for (const auto& model : all) {
+            int lower = 0;
+            for (const auto& other : all) {
+                if (other->getCategory() == model->getCategory() &&
+                    other->getComplexityLevel() < model->getComplexityLevel()) {
+                    lower = std::max(lower, other->getComplexityLevel());
+                }
+            }
+            std::set<int>& prerequisites = direct[model->getModelId()];
+            for (const auto& other : all) {
+                if (other->getCategory() == model->getCategory() && other->getComplexityLevel() == lower &&
+                    !removed.count(std::make_pair(model->getModelId(), other->getModelId()))) {
+                    prerequisites.insert(other->getModelId());
+                }
+            }
+        }
+        for (const auto& edge : added) {
+            direct[edge.first].insert(edge.second);
+        }
+
+        Closures closures;
+        for (const auto& model : all) {
+            std::set<int> reached;
+            std::vector<int> pending(direct[model->getModelId()].begin(), direct[model->getModelId()].end());
+            while (!pending.empty()) {
+                int id = pending.back();
+                pending.pop_back();
+                if (reached.insert(id).second) {
+                    pending.insert(pending.end(), direct[id].begin(), direct[id].end());
+                }
+            }
+            closures[model->getModelId()].assign(reached.begin(), reached.end());
+        }
+        return closures;
+    }
+
+    bool isCyclic(const Closures& closures) {
+        for (const auto& entry : closures) {
+            if (std::binary_search(entry.second.begin(), entry.second.end(), entry.first)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    Closures invert(const Closures& closures) {
+        Closures inverted;
+        for (const auto& entry : closures) {
+            inverted[entry.first];
+            for (int prerequisite : entry.second) {
+                inverted[prerequisite].push_back(entry.first);
+            }
+        }
+        return inverted;
+    }
+
+    // Every listed model comes after the listed models it requires
+    bool prerequisitesFirst(const std::vector<int>& ids, const Closures& prerequisites) {
+        std::map<int, size_t> positionOf;
+        for (size_t i = 0; i < ids.size(); i++) {
+            positionOf[ids[i]] = i;
+        }
+        for (size_t i = 0; i < ids.size(); i++) {
+            auto required = prerequisites.find(ids[i]);
+            if (required == prerequisites.end()) {
+                return false;
+            }
+            for (int prerequisite : required->second) {
+                auto at = positionOf.find(prerequisite);
+                if (at != positionOf.end() && at->second > i) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    Closures closuresOf(const AIModelService& service, bool prerequisites) {
+        Closures closures;
+        for (const auto& model : service.getAllModels()) {
+            int id = model->getModelId();
+            closures[id] = idsOf(prerequisites ? service.getPrerequisiteModels(id) : service.getNextLevelModels(id));
+        }
+        return closures;
+    }
+
+    void compareClosures(const std::string& what, const Closures& expected, const Closures& actual,
+                         const Closures& prerequisites) {
+        for (const auto& entry : expected) {
+            auto found = actual.find(entry.first);
+            std::vector<int> ids = found == actual.end() ? std::vector<int>() : found->second;
+            check(what + " of model " + std::to_string(entry.first) + ": expected " +
+                  std::to_string(entry.second.size()) + ", got " + std::to_string(ids.size()),
+                  found != actual.end() && sorted(ids) == entry.second && prerequisitesFirst(ids, prerequisites));
+        }
+        check(what + ": model count", expected.size() == actual.size());
+    }
+
+    void checkLearningPaths(std::mt19937& random, const AIModelService& service, std::vector<Client>& clients,
+                            const Closures& prerequisites) {
+        std::vector<std::shared_ptr<AIModel>> all = service.getAllModels();
+        for (Client& client : clients) {
+            // Change some proficiencies, so cached paths are hit and missed
+            for (int i = random() % 3; i > 0 && !all.empty(); i--) {
+                client.setAIModelProficiency(all[random() % all.size()]->getName(), static_cast<int>(random() % 6));
+            }
+            std::vector<int> expected;
+            for (const auto& model : all) {
+                if (client.getAIModelProficiency(model->getName()) < model->getComplexityLevel()) {
+                    expected.push_back(model->getModelId());
+                }
+            }
+            std::sort(expected.begin(), expected.end());
+            std::vector<int> path = idsOf(service.getRecommendedLearningPath(client));
+            check("learning path of client " + std::to_string(client.getClientId()) + ": expected " +
+                  std::to_string(expected.size()) + ", got " + std::to_string(path.size()),
+                  sorted(path) == expected && prerequisitesFirst(path, prerequisites));
+        }
+    }
+
+    std::shared_ptr<AIModel> makeModel(std::mt19937& random, size_t serial, size_t categories) {
+        return std::make_shared<AIModel>(0, "Model" + std::to_string(serial), "1", "Developer",
+                                         "Category" + std::to_string(random() % categories), "2024-01-01",
+                                         "Description", static_cast<int>(1 + random() % 5));
+    }
+
+    void forgetEdits(Edges& edits, int modelId) {
+        for (auto it = edits.begin(); it != edits.end();) {
+            it = it->first == modelId || it->second == modelId ? edits.erase(it) : std::next(it);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t modelCount = std::max<size_t>(1, Bench::argCount(argc, argv, 1, 300));
+    size_t rounds = Bench::argCount(argc, argv, 2, 2000);
+    std::mt19937 random(static_cast<unsigned>(Bench::argCount(argc, argv, 3, 1)));
+    size_t categories = modelCount / 10 + 1;
+
+    Logger::getInstance().setMinLevel(LogLevel::ERROR);
+    Closures live;
+    double ms = Bench::timeMs([&]() {
+        AIModelService service;
+        service.setJournalSyncPolicy(JournalSyncPolicy::Never);
+        for (const auto& model : service.getAllModels()) {
+            service.removeAIModel(model->getModelId());
+        }
+
+        size_t serial = 0;
+        for (size_t i = 0; i < modelCount; i++) {
+            service.addAIModel(makeModel(random, serial++, categories));
+        }
+        std::vector<Client> clients;
+        for (int id = 1; id <= 4; id++) {
+            clients.push_back(Client(id, "First", "Last", "user" + std::to_string(id) + "@example.com",
+                                     "555-123-4567", "Company", "Engineer"));
+        }
+
+        Edges added;
+        Edges removed;
+        std::set<int> edited;
+        auto checkAgainstWalk = [&](const std::string& when) {
+            Closures prerequisites = expectedPrerequisites(service, added, removed);
+            if (isCyclic(prerequisites)) {
+                cyclic++;
+                return;
+            }
+            compareClosures(when + " prerequisites", prerequisites, closuresOf(service, true), prerequisites);
+            compareClosures(when + " dependents", invert(prerequisites), closuresOf(service, false),
+                            prerequisites);
+            checkLearningPaths(random, service, clients, prerequisites);
+        };
+
+        for (size_t round = 0; round < rounds; round++) {
+            std::vector<std::shared_ptr<AIModel>> all = service.getAllModels();
+            std::shared_ptr<AIModel> model = all[random() % all.size()];
+            int modelId = model->getModelId();
+            int otherId = all[random() % all.size()]->getModelId();
+            std::pair<int, int> edge(modelId, otherId);
+            switch (random() % 12) {
+                case 0: case 1: case 2: case 3:
+                    if (service.addModelPrerequisite(modelId, otherId)) {
+                        removed.erase(edge);
+                        added.insert(edge);
+                        edited.insert(modelId);
+                        edited.insert(otherId);
+                    }
+                    break;
+                case 4: case 5: case 6:
+                    if (service.removeModelPrerequisite(modelId, otherId)) {
+                        added.erase(edge);
+                        removed.insert(edge);
+                        edited.insert(modelId);
+                        edited.insert(otherId);
+                    }
+                    break;
+                case 7: case 8:
+                    if (!edited.count(modelId)) {
+                        service.updateModelComplexity(modelId, static_cast<int>(1 + random() % 5));
+                    }
+                    break;
+                case 9:
+                    if (!edited.count(modelId)) {
+                        service.updateAIModel(modelId, model->getName(), "2", "Developer",
+                                              "Category" + std::to_string(random() % categories), "Description");
+                    }
+                    break;
+                case 10:
+                    // Same level, other fields and popularity change
+                    service.updateAIModel(modelId, model->getName(), "3", "Other Developer", model->getCategory(),
+                                          "Changed");
+                    service.updateModelPopularity(modelId, static_cast<int>(round));
+                    break;
+                default:
+                    service.removeAIModel(modelId);
+                    forgetEdits(added, modelId);
+                    forgetEdits(removed, modelId);
+                    service.addAIModel(makeModel(random, serial++, categories));
+                    break;
+            }
+            if (round % 16 == 0) {
+                checkAgainstWalk("round " + std::to_string(round));
+            }
+        }
+        checkAgainstWalk("final");
+
+        // A second service over the same files replays the journal
+        live = closuresOf(service, true);
+        AIModelService replayed;
+        check("replayed prerequisites", closuresOf(replayed, true) == live);
+    });
+
+    // The first service wrote a snapshot on close
+    AIModelService loaded;
+    check("saved prerequisites", closuresOf(loaded, true) == live);
+
+    std::printf("%zu checks in %.0f ms, %zu cyclic checks skipped, %zu mismatches\n", checked, ms, cyclic,
+                mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
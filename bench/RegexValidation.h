@@ -0,0 +1,48 @@
+// RegexValidation.h
+#ifndef REGEX_VALIDATION_H
+#define REGEX_VALIDATION_H
+
+#include <string>
+#include <regex>
+
+// The std::regex validators that Validation's scanners replaced, kept
+// unchanged as the reference for the differential check and the benchmark
+namespace RegexValidation {
+    inline bool isValidEmail(const std::string& email) {
+        const std::regex pattern("(\\w+)(\\.|_)?(\\w*)@(\\w+)(\\.(\\w+))+");
+        return std::regex_match(email, pattern);
+    }
+
+    inline bool isValidPhone(const std::string& phone) {
+        const std::regex pattern("\\(?\\d{3}\\)?[-. ]?\\d{3}[-. ]?\\d{4}");
+        return std::regex_match(phone, pattern);
+    }
+
+    inline bool isValidDate(const std::string& date) {
+        const std::regex pattern("\\d{4}-\\d{2}-\\d{2}");
+        if (!std::regex_match(date, pattern)) {
+            return false;
+        }
+
+        int year = std::stoi(date.substr(0, 4));
+        int month = std::stoi(date.substr(5, 2));
+        int day = std::stoi(date.substr(8, 2));
+
+        if (month < 1 || month > 12) {
+            return false;
+        }
+
+        int daysInMonth[] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        if (year % 4 == 0 && (year % 100 != 0 || year % 400 == 0)) {
+            daysInMonth[2] = 29;
+        }
+        return (day >= 1 && day <= daysInMonth[month]);
+    }
+
+    inline bool isValidTime(const std::string& time) {
+        const std::regex pattern("([01]?[0-9]|2[0-3]):[0-5][0-9]");
+        return std::regex_match(time, pattern);
+    }
+}
+
+#endif // REGEX_VALIDATION_H
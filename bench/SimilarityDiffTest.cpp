@@ -0,0 +1,370 @@
+// Differential check of SimilarityIndex and AIModelService::getRelatedModels
+// against TF-IDF cosines computed in double precision by comparing every
+// pair of records.
+//
+// Usage: SimilarityDiffTest [records] [rounds] [seed]
+//
+// Run from a directory with data/ and logs/ subdirectories; every model
+// in data/ is removed first.
+//
+// The index part fills an index with `records` texts (default 2,000) drawn
+// from a skewed vocabulary, with stop words, one-letter words, mixed case
+// and punctuation, plus a word of its own for some records. Each of
+// `rounds` rounds (default 2,000) adds, re-indexes or removes a record,
+// then runs mostSimilar, search and similarity. Search texts mix in words
+// that are unknown or whose records have all been removed.
+//
+// The service part adds a tenth as many models, whose descriptions,
+// capabilities, limitations and use cases come from the same vocabulary.
+// Each round edits one of those fields, the category or the whole model,
+// or replaces the model, then runs getRelatedModels.
+//
+// Both use SimilarityIndex::tokenize for words. Returned scores must be
+// within 1e-4 of the exact cosine; each result must share a word with the
+// query and be in descending order. No record left out may score above
+// the last one kept, and results are short only when fewer records match.
+#include "include/services/AIModelService.h"
+#include "include/utils/SimilarityIndex.h"
+#include "bench/BenchUtil.h"
+#include <cstdio>
+#include <cmath>
+#include <map>
+#include <random>
+#include <iterator>
+#include <algorithm>
+
+namespace {
+    const char* const FILLERS[] = {"the", "and", "of", "a", "x", "is", "with"};
+    const size_t FILLER_COUNT = sizeof(FILLERS) / sizeof(FILLERS[0]);
+    const size_t VOCABULARY = 300;
+    const double TOLERANCE = 1e-4;
+
+    size_t checked = 0;
+    size_t mismatches = 0;
+
+    void check(const std::string& what, bool same) {
+        checked++;
+        if (!same) {
+            mismatches++;
+            if (mismatches <= 20) {
+                std::printf("MISMATCH %s\n", what.c_str());
+            }
+        }
+    }
+
+    // Low word numbers are far more common than high ones
+    std::string randomWord(std::mt19937& random) {
+        size_t rank = static_cast<size_t>(std::pow(static_cast<double>(random() % 10000) / 10000.0, 3.0) * VOCABULARY);
+        std::string word = "term" + std::to_string(rank);
+        if (random() % 5 == 0) {
+            word[0] = 'T';
+        }
+        return word;
+    }
+
+    std::string randomText(std::mt19937& random, size_t words) {
+        std::string text;
+        for (size_t i = 0; i < words; i++) {
+            if (random() % 6 == 0) {
+                text += FILLERS[random() % FILLER_COUNT];
+                text += random() % 2 == 0 ? ", " : " ";
+            }
+            text += randomWord(random) + (random() % 8 == 0 ? ". " : " ");
+        }
+        return text;
+    }
+
+    // Word counts per record, and exact cosines over them
+    class Corpus {
+    private:
+        std::map<int, std::map<std::string, int>> records;
+        std::map<std::string, size_t> documentFrequency;
+
+        static std::map<std::string, int> countWords(const std::string& text) {
+            std::map<std::string, int> counts;
+            for (const auto& word : SimilarityIndex::tokenize(text)) {
+                counts[word]++;
+            }
+            return counts;
+        }
+
+        double weight(const std::string& word, int count) const {
+            auto found = documentFrequency.find(word);
+            size_t frequency = found == documentFrequency.end() ? 0 : found->second;
+            double idf = std::log((1.0 + records.size()) / (1.0 + frequency)) + 1.0;
+            return (1.0 + std::log(static_cast<double>(count))) * idf;
+        }
+
+        double cosine(const std::map<std::string, int>& query, const std::map<std::string, int>& record) const {
+            double dot = 0.0;
+            double queryNorm = 0.0;
+            double recordNorm = 0.0;
+            for (const auto& entry : query) {
+                double queryWeight = weight(entry.first, entry.second);
+                queryNorm += queryWeight * queryWeight;
+                auto match = record.find(entry.first);
+                if (match != record.end()) {
+                    dot += queryWeight * weight(match->first, match->second);
+                }
+            }
+            for (const auto& entry : record) {
+                double recordWeight = weight(entry.first, entry.second);
+                recordNorm += recordWeight * recordWeight;
+            }
+            return dot == 0.0 ? 0.0 : dot / std::sqrt(queryNorm * recordNorm);
+        }
+
+        // Records sharing a word with the query, by exact cosine
+        std::map<int, double> score(const std::map<std::string, int>& query, int excludeId) const {
+            std::map<int, double> scores;
+            for (const auto& record : records) {
+                double similarity = record.first == excludeId ? 0.0 : cosine(query, record.second);
+                if (similarity > 0.0) {
+                    scores[record.first] = similarity;
+                }
+            }
+            return scores;
+        }
+
+    public:
+        void add(int id, const std::string& text) {
+            remove(id);
+            records[id] = countWords(text);
+            for (const auto& entry : records[id]) {
+                documentFrequency[entry.first]++;
+            }
+        }
+
+        void remove(int id) {
+            auto found = records.find(id);
+            if (found == records.end()) {
+                return;
+            }
+            for (const auto& entry : found->second) {
+                documentFrequency[entry.first]--;
+            }
+            records.erase(found);
+        }
+
+        size_t size() const {
+            return records.size();
+        }
+
+        std::map<int, double> mostSimilar(int id) const {
+            auto found = records.find(id);
+            return found == records.end() ? std::map<int, double>() : score(found->second, id);
+        }
+
+        // Words no record contains cannot match and carry no weight
+        std::map<int, double> search(const std::string& text) const {
+            std::map<std::string, int> query = countWords(text);
+            for (auto it = query.begin(); it != query.end();) {
+                auto found = documentFrequency.find(it->first);
+                it = found == documentFrequency.end() || found->second == 0 ? query.erase(it) : std::next(it);
+            }
+            return score(query, -1);
+        }
+
+        double similarity(int first, int second) const {
+            auto a = records.find(first);
+            auto b = records.find(second);
+            return a == records.end() || b == records.end() ? 0.0 : cosine(a->second, b->second);
+        }
+    };
+
+    // Results as (ID, score); the service gives IDs only, with NAN scores
+    void checkTopK(const std::string& what, const std::map<int, double>& expected,
+                   const std::vector<std::pair<int, float>>& actual, size_t limit) {
+        bool same = actual.size() == std::min(limit, expected.size());
+        double lowest = 0.0;
+        std::vector<int> kept;
+        for (size_t i = 0; same && i < actual.size(); i++) {
+            auto found = expected.find(actual[i].first);
+            same = found != expected.end() &&
+                   (std::isnan(actual[i].second) || std::fabs(actual[i].second - found->second) <= TOLERANCE) &&
+                   (i == 0 || found->second <= lowest + TOLERANCE);
+            lowest = same ? found->second : lowest;
+            kept.push_back(actual[i].first);
+        }
+        std::sort(kept.begin(), kept.end());
+        for (auto it = expected.begin(); same && it != expected.end(); ++it) {
+            same = std::binary_search(kept.begin(), kept.end(), it->first) || it->second <= lowest + TOLERANCE;
+        }
+        check(what + ": " + std::to_string(expected.size()) + " matches, got " + std::to_string(actual.size()), same);
+    }
+
+    void checkIndex(std::mt19937& random, size_t recordCount, size_t rounds) {
+        SimilarityIndex index;
+        Corpus corpus;
+        std::vector<int> ids;
+        int nextId = 1;
+        auto addRecord = [&](int id) {
+            std::string text = randomText(random, 3 + random() % 12);
+            if (random() % 4 == 0) {
+                text += " only" + std::to_string(id);
+            }
+            index.add(id, text);
+            corpus.add(id, text);
+        };
+        for (size_t i = 0; i < recordCount; i++) {
+            ids.push_back(nextId);
+            addRecord(nextId++);
+        }
+
+        for (size_t round = 0; round < rounds; round++) {
+            size_t at = ids.empty() ? 0 : random() % ids.size();
+            switch (random() % 4) {
+                case 0:
+                    ids.push_back(nextId);
+                    addRecord(nextId++);
+                    break;
+                case 1:
+                    if (!ids.empty()) {
+                        addRecord(ids[at]);
+                    }
+                    break;
+                default:
+                    if (!ids.empty()) {
+                        index.remove(ids[at]);
+                        corpus.remove(ids[at]);
+                        ids[at] = ids.back();
+                        ids.pop_back();
+                    }
+                    break;
+            }
+            check("size()", index.size() == corpus.size());
+            if (ids.empty()) {
+                continue;
+            }
+
+            int id = ids[random() % ids.size()];
+            size_t limit = random() % 4 == 0 ? ids.size() : 1 + random() % 20;
+            checkTopK("mostSimilar(" + std::to_string(id) + ")", corpus.mostSimilar(id), index.mostSimilar(id, limit),
+                      limit);
+
+            // Words unknown to the index, or of records since removed
+            std::string text = randomText(random, 1 + random() % 4);
+            for (int extra = random() % 3; extra > 0; extra--) {
+                text += random() % 2 == 0 ? " only" + std::to_string(1 + random() % nextId) : " unheard";
+            }
+            checkTopK("search(\"" + text + "\")", corpus.search(text), index.search(text, limit), limit);
+
+            int other = ids[random() % ids.size()];
+            check("similarity(" + std::to_string(id) + ", " + std::to_string(other) + ")",
+                  std::fabs(index.similarity(id, other) - corpus.similarity(id, other)) <= TOLERANCE);
+        }
+    }
+
+    std::string similarityText(const AIModel& model) {
+        std::string text = model.getCategory() + " " + model.getDescription();
+        for (const auto* values : {&model.getCapabilities(), &model.getLimitations(), &model.getUseCases()}) {
+            for (const auto& value : *values) {
+                text += " " + value;
+            }
+        }
+        return text;
+    }
+
+    std::shared_ptr<AIModel> makeModel(std::mt19937& random, size_t serial) {
+        auto model = std::make_shared<AIModel>(0, "Model" + std::to_string(serial), "1", "Developer",
+                                               randomWord(random), "2024-01-01", randomText(random, 3 + random() % 8),
+                                               static_cast<int>(1 + random() % 5));
+        for (int i = random() % 4; i > 0; i--) {
+            model->addCapability(randomText(random, 1 + random() % 2));
+        }
+        for (int i = random() % 3; i > 0; i--) {
+            model->addLimitation(randomText(random, 1 + random() % 2));
+        }
+        for (int i = random() % 3; i > 0; i--) {
+            model->addUseCase(randomText(random, 1 + random() % 2));
+        }
+        return model;
+    }
+
+    // Takes away one of the values, if there are any
+    template <typename Remove>
+    void removeOne(std::mt19937& random, const std::vector<std::string>& values, Remove remove) {
+        if (!values.empty()) {
+            remove(values[random() % values.size()]);
+        }
+    }
+
+    void checkService(std::mt19937& random, size_t modelCount, size_t rounds) {
+        AIModelService service;
+        service.setJournalSyncPolicy(JournalSyncPolicy::Never);
+        for (const auto& model : service.getAllModels()) {
+            service.removeAIModel(model->getModelId());
+        }
+
+        size_t serial = 0;
+        for (size_t i = 0; i < modelCount; i++) {
+            service.addAIModel(makeModel(random, serial++));
+        }
+
+        for (size_t round = 0; round < rounds; round++) {
+            std::vector<std::shared_ptr<AIModel>> all = service.getAllModels();
+            std::shared_ptr<AIModel> model = all[random() % all.size()];
+            int modelId = model->getModelId();
+            std::string text = randomText(random, 1 + random() % 2);
+            switch (random() % 8) {
+                case 0:
+                    service.addModelCapability(modelId, text);
+                    break;
+                case 1:
+                    removeOne(random, model->getCapabilities(),
+                              [&](const std::string& value) { service.removeModelCapability(modelId, value); });
+                    break;
+                case 2:
+                    service.addModelLimitation(modelId, text);
+                    break;
+                case 3:
+                    removeOne(random, model->getLimitations(),
+                              [&](const std::string& value) { service.removeModelLimitation(modelId, value); });
+                    break;
+                case 4:
+                    service.addModelUseCase(modelId, text);
+                    break;
+                case 5:
+                    removeOne(random, model->getUseCases(),
+                              [&](const std::string& value) { service.removeModelUseCase(modelId, value); });
+                    break;
+                case 6:
+                    service.updateAIModel(modelId, model->getName(), "2", "Developer", randomWord(random),
+                                          randomText(random, 3 + random() % 8));
+                    break;
+                default:
+                    service.removeAIModel(modelId);
+                    service.addAIModel(makeModel(random, serial++));
+                    break;
+            }
+
+            Corpus corpus;
+            all = service.getAllModels();
+            for (const auto& each : all) {
+                corpus.add(each->getModelId(), similarityText(*each));
+            }
+            int queryId = all[random() % all.size()]->getModelId();
+            size_t count = random() % 4 == 0 ? all.size() : 1 + random() % 10;
+            std::vector<std::pair<int, float>> related;
+            for (const auto& match : service.getRelatedModels(queryId, count)) {
+                related.push_back(std::make_pair(match->getModelId(), NAN));
+            }
+            checkTopK("getRelatedModels(" + std::to_string(queryId) + ")", corpus.mostSimilar(queryId), related, count);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t recordCount = std::max<size_t>(1, Bench::argCount(argc, argv, 1, 2000));
+    size_t rounds = Bench::argCount(argc, argv, 2, 2000);
+    std::mt19937 random(static_cast<unsigned>(Bench::argCount(argc, argv, 3, 1)));
+    Logger::getInstance().setMinLevel(LogLevel::WARNING);
+
+    double indexMs = Bench::timeMs([&]() { checkIndex(random, recordCount, rounds); });
+    size_t indexChecks = checked;
+    double serviceMs = Bench::timeMs([&]() { checkService(random, std::max<size_t>(1, recordCount / 10), rounds); });
+
+    std::printf("%zu index checks in %.0f ms, %zu related-model checks in %.0f ms, %zu mismatches\n", indexChecks,
+                indexMs, checked - indexChecks, serviceMs, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
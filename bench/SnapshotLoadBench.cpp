@@ -0,0 +1,102 @@
+// Load time of the text format against the columnar snapshot.
+//
+// Usage: SnapshotLoadBench [records] [file]
+//
+// Saves `records` clients (default 1,000,000) once as pipe-delimited text
+// and once as a snapshot, then measures:
+//   text       loadFromFile() on the text file, one parse thread
+//   text xN    the same with one parse thread per core
+//   snapshot   loadFromFile() on the snapshot, every record materialised
+//   lazy open  openRecordSource() on the snapshot: map it and read the
+//              header, with rows decoded on first access
+// Speedups are against the single-threaded text load. Both full loads
+// must return the same records, and the lazy source must decode rows equal
+// to them.
+#include "include/services/ClientFileService.h"
+#include "bench/BenchUtil.h"
+#include <cstdio>
+#include <thread>
+#include <algorithm>
+
+namespace {
+    uint64_t fingerprintOf(const Client& client, uint64_t hash) {
+        hash = Bench::fingerprint(hash, std::to_string(client.getClientId()));
+        hash = Bench::fingerprint(hash, client.getEmail());
+        hash = Bench::fingerprint(hash, client.getCompany());
+        hash = Bench::fingerprint(hash, std::to_string(client.getSessionsCompleted()));
+        return Bench::fingerprint(hash, FieldParser::formatDouble(client.getBudget()));
+    }
+
+    uint64_t fingerprintOf(const std::vector<Client>& clients) {
+        uint64_t hash = Bench::FINGERPRINT_SEED;
+        for (const auto& client : clients) {
+            hash = fingerprintOf(client, hash);
+        }
+        return hash;
+    }
+
+    void report(const char* name, double ms, double textMs, size_t records, bool same) {
+        std::printf("%-10s %12.1f %9.1fx %14.0f%s\n", name, ms, textMs / ms, records / (ms / 1000.0),
+                    same ? "" : "  MISMATCH");
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t records = Bench::argCount(argc, argv, 1, 1000000);
+    std::string path = argc > 2 ? argv[2] : "snapshot_load_bench.dat";
+
+    std::vector<Client> clients;
+    clients.reserve(records);
+    for (size_t i = 1; i <= records; i++) {
+        Client client(static_cast<int>(i), "First" + std::to_string(i % 1000), "Last" + std::to_string(i % 3000),
+                      "user" + std::to_string(i) + "@example.com", "555-123-4567",
+                      "Company" + std::to_string(i % 500), "Engineer");
+        client.setSessionsCompleted(static_cast<int>(i % 50));
+        client.setBudget(static_cast<double>(i % 10000) + 0.25);
+        clients.push_back(client);
+    }
+    uint64_t expected = fingerprintOf(clients);
+
+    ClientFileService files(path, StorageFormat::Text);
+    std::vector<Client> loaded;
+    if (!files.saveToFile(clients)) {
+        return 1;
+    }
+    files.setParseThreads(1);
+    double textMs = Bench::timeMs([&]() { loaded = files.loadFromFile(); });
+    bool textSame = loaded.size() == records && fingerprintOf(loaded) == expected;
+
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    files.setParseThreads(threads);
+    double parallelMs = Bench::timeMs([&]() { loaded = files.loadFromFile(); });
+    bool parallelSame = loaded.size() == records && fingerprintOf(loaded) == expected;
+
+    files.setFormat(StorageFormat::Snapshot);
+    if (!files.saveToFile(clients)) {
+        return 1;
+    }
+    double snapshotMs = Bench::timeMs([&]() { loaded = files.loadFromFile(); });
+    bool snapshotSame = loaded.size() == records && fingerprintOf(loaded) == expected;
+
+    std::shared_ptr<const RecordSource<Client>> source;
+    double lazyMs = Bench::timeMs([&]() { source = files.openRecordSource(); });
+    bool lazySame = source && source->getRecordCount() == records;
+    size_t step = std::max<size_t>(1, records / 1000);
+    for (size_t row = 0; lazySame && row < records; row += step) {
+        Client client = source->decodeRecord(row);
+        lazySame = source->getRecordId(row) == clients[row].getClientId() &&
+                   fingerprintOf(client, 0) == fingerprintOf(clients[row], 0);
+    }
+
+    std::printf("%zu records (%s)\n", records, path.c_str());
+    std::printf("%-10s %12s %10s %14s\n", "path", "ms", "speedup", "records/s");
+    report("text", textMs, textMs, records, textSame);
+    std::string parallelName = "text x" + std::to_string(threads);
+    report(parallelName.c_str(), parallelMs, textMs, records, parallelSame);
+    report("snapshot", snapshotMs, textMs, records, snapshotSame);
+    report("lazy open", lazyMs, textMs, records, lazySame);
+
+    source.reset();
+    std::remove(path.c_str());
+    return textSame && parallelSame && snapshotSame && lazySame ? 0 : 1;
+}
@@ -0,0 +1,141 @@
+// Availability checks against TutorSchedule's interval trees and against a
+// scan of every booked session.
+//
+// Usage: TutorScheduleBench [sessions] [tutors] [scanChecks]
+//
+// Schedules `sessions` requests (default 1,000,000) across `tutors`
+// tutors (default 5,000) over one year. Each request is checked with
+// isAvailable() and booked if the slot is free, as scheduling a session
+// does. Then `scanChecks` checks (default 1,000) are repeated with a scan
+// of the flat booking list, and week-long conflict queries are timed.
+// Sampled results must match the scan.
+#include "include/services/TutorSchedule.h"
+#include "bench/BenchUtil.h"
+#include <cstdio>
+#include <random>
+#include <algorithm>
+
+namespace {
+    struct Request {
+        int tutorId;
+        std::string date;
+        std::string startTime;
+        int duration;
+    };
+
+    struct FlatBooking {
+        int sessionId;
+        int tutorId;
+        int64_t start;
+        int64_t end;
+    };
+
+    Request makeRequest(std::mt19937& random, int tutors) {
+        static const int durations[] = {30, 45, 60, 90};
+        char date[16];
+        char time[8];
+        std::snprintf(date, sizeof(date), "2025-%02d-%02d", 1 + static_cast<int>(random() % 12),
+                      1 + static_cast<int>(random() % 28));
+        int quarter = static_cast<int>(random() % 48);       // 08:00 to 19:45
+        std::snprintf(time, sizeof(time), "%02d:%02d", 8 + quarter / 4, (quarter % 4) * 15);
+        return Request{static_cast<int>(random() % tutors), date, time, durations[random() % 4]};
+    }
+
+    // The flat-list check that the trees replace
+    std::vector<int> scanConflicts(const std::vector<FlatBooking>& bookings, int tutorId, int64_t start,
+                                   int64_t end) {
+        std::vector<int> found;
+        for (const auto& booking : bookings) {
+            if (booking.tutorId == tutorId && booking.start < end && start < booking.end) {
+                found.push_back(booking.sessionId);
+            }
+        }
+        return found;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t sessions = Bench::argCount(argc, argv, 1, 1000000);
+    int tutors = static_cast<int>(std::max<size_t>(1, Bench::argCount(argc, argv, 2, 5000)));
+    size_t scanChecks = std::max<size_t>(1, Bench::argCount(argc, argv, 3, 1000));
+
+    std::mt19937 random(1);
+    std::vector<Request> requests;
+    requests.reserve(sessions);
+    for (size_t i = 0; i < sessions; i++) {
+        requests.push_back(makeRequest(random, tutors));
+    }
+
+    TutorSchedule schedule;
+    std::vector<FlatBooking> bookings;
+    size_t booked = 0;
+    double scheduleMs = Bench::timeMs([&]() {
+        for (size_t i = 0; i < requests.size(); i++) {
+            const Request& request = requests[i];
+            if (schedule.isAvailable(request.tutorId, request.date, request.startTime, request.duration)) {
+                schedule.book(static_cast<int>(i), request.tutorId, request.date, request.startTime, request.duration);
+                booked++;
+            }
+        }
+    });
+    for (size_t i = 0; i < requests.size(); i++) {
+        int64_t start;
+        if (schedule.isBooked(static_cast<int>(i)) &&
+            TutorSchedule::encode(requests[i].date, requests[i].startTime, start)) {
+            bookings.push_back(FlatBooking{static_cast<int>(i), requests[i].tutorId, start, start + requests[i].duration});
+        }
+    }
+
+    std::printf("%zu requests, %zu booked across %d tutors in %.0f ms (%.2f us per check and book)\n",
+                sessions, booked, tutors, scheduleMs, scheduleMs * 1000.0 / sessions);
+
+    // Fresh requests against the full schedule, both ways
+    std::vector<Request> checks;
+    for (size_t i = 0; i < scanChecks; i++) {
+        checks.push_back(makeRequest(random, tutors));
+    }
+
+    std::vector<char> treeAnswers;
+    double treeMs = Bench::timeMs([&]() {
+        for (const auto& check : checks) {
+            treeAnswers.push_back(schedule.isAvailable(check.tutorId, check.date, check.startTime, check.duration));
+        }
+    });
+
+    std::vector<char> scanAnswers;
+    double scanMs = Bench::timeMs([&]() {
+        for (const auto& check : checks) {
+            int64_t start = 0;
+            TutorSchedule::encode(check.date, check.startTime, start);
+            scanAnswers.push_back(scanConflicts(bookings, check.tutorId, start, start + check.duration).empty());
+        }
+    });
+
+    std::printf("availability check: %.2f us with the trees, %.2f us scanning the list\n",
+                treeMs * 1000.0 / scanChecks, scanMs * 1000.0 / scanChecks);
+
+    // Week-long conflict listings
+    const int week = 7 * 24 * 60;
+    std::vector<std::vector<int>> listings;
+    double weekMs = Bench::timeMs([&]() {
+        for (const auto& check : checks) {
+            listings.push_back(schedule.getConflicts(check.tutorId, check.date, "00:00", week));
+        }
+    });
+    std::printf("week conflict listing: %.2f us per query\n", weekMs * 1000.0 / scanChecks);
+
+    bool listingsMatch = true;
+    for (size_t i = 0; i < checks.size(); i++) {
+        int64_t from = 0;
+        TutorSchedule::encode(checks[i].date, "00:00", from);
+        std::vector<int> found = listings[i];
+        std::sort(found.begin(), found.end());
+        listingsMatch = listingsMatch && found == scanConflicts(bookings, checks[i].tutorId, from, from + week);
+    }
+
+    bool correct = treeAnswers == scanAnswers && listingsMatch;
+    if (!correct) {
+        std::printf("MISMATCH between the trees and the scan\n");
+    }
+    return correct ? 0 : 1;
+}
@@ -0,0 +1,65 @@
+// Per-call cost of Validation's scanners against the regex validators they
+// replaced.
+//
+// Usage: ValidationBench [calls]
+//
+// Runs each validator `calls` times (default 1,000,000 for the scanners;
+// the regex versions run a hundredth as often) over a fixed mix of valid
+// and invalid inputs, and reports nanoseconds per call. Both versions must
+// agree on every input.
+#include "include/utils/Validation.h"
+#include "bench/RegexValidation.h"
+#include "bench/BenchUtil.h"
+#include <cstdio>
+#include <algorithm>
+
+namespace {
+    typedef bool (*StringCheck)(const std::string&);
+
+    bool agree = true;
+
+    void run(const char* name, StringCheck reference, StringCheck scanner, const std::vector<std::string>& inputs,
+             size_t calls) {
+        size_t referenceCalls = std::max<size_t>(inputs.size(), calls / 100);
+        size_t accepted = 0;
+        double referenceMs = Bench::timeMs([&]() {
+            for (size_t i = 0; i < referenceCalls; i++) {
+                accepted += reference(inputs[i % inputs.size()]);
+            }
+        });
+        double scannerMs = Bench::timeMs([&]() {
+            for (size_t i = 0; i < calls; i++) {
+                accepted += scanner(inputs[i % inputs.size()]);
+            }
+        });
+
+        for (const auto& input : inputs) {
+            agree = agree && reference(input) == scanner(input);
+        }
+
+        double referenceNs = referenceMs * 1e6 / referenceCalls;
+        double scannerNs = scannerMs * 1e6 / calls;
+        std::printf("%-14s %12.1f %12.1f %10.0fx  (%zu accepted)\n", name, referenceNs, scannerNs,
+                    referenceNs / scannerNs, accepted);
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t calls = std::max<size_t>(1, Bench::argCount(argc, argv, 1, 1000000));
+
+    std::printf("%-14s %12s %12s %11s\n", "validator", "regex ns", "scanner ns", "speedup");
+    run("isValidEmail", RegexValidation::isValidEmail, Validation::isValidEmail,
+        {"user@example.com", "first.last@mail.example.org", "no-at-sign.example.com", "a@b", "x_y@corp.co.uk"},
+        calls);
+    run("isValidPhone", RegexValidation::isValidPhone, Validation::isValidPhone,
+        {"555-123-4567", "(555) 123-4567", "555.123.4567", "55-1234-567", "5551234567"}, calls);
+    run("isValidDate", RegexValidation::isValidDate, Validation::isValidDate,
+        {"2024-02-29", "2023-02-29", "1999-12-31", "2024-13-01", "24-01-01"}, calls);
+    run("isValidTime", RegexValidation::isValidTime, Validation::isValidTime,
+        {"9:05", "23:59", "24:00", "12:60", "07:30"}, calls);
+
+    if (!agree) {
+        std::printf("MISMATCH between regex and scanner results\n");
+    }
+    return agree ? 0 : 1;
+}
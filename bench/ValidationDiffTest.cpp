@@ -0,0 +1,116 @@
+// Differential check of Validation's scanners against the regex validators
+// they replaced.
+//
+// Usage: ValidationDiffTest [randomInputs]
+//
+// Compares accept/reject on exhaustive date and time sweeps, on known
+// valid inputs with single-character mutations, and on `randomInputs`
+// (default 100,000) random strings per validator. Both overloads of each
+// scanner are checked. Prints every mismatch and fails if there is one.
+#include "include/utils/Validation.h"
+#include "bench/RegexValidation.h"
+#include "bench/BenchUtil.h"
+#include <cstdio>
+#include <random>
+
+namespace {
+    typedef bool (*StringCheck)(const std::string&);
+    typedef bool (*BufferCheck)(const char*, size_t);
+
+    struct Validator {
+        const char* name;
+        StringCheck reference;
+        StringCheck scanner;
+        BufferCheck bufferScanner;
+        const char* alphabet;       // Characters random inputs are drawn from
+        std::vector<std::string> samples;
+    };
+
+    size_t checked = 0;
+    size_t mismatches = 0;
+
+    void check(const Validator& validator, const std::string& input) {
+        bool expected = validator.reference(input);
+        bool actual = validator.scanner(input);
+        bool buffered = validator.bufferScanner(input.data(), input.size());
+        checked++;
+        if (actual != expected || buffered != expected) {
+            mismatches++;
+            if (mismatches <= 20) {
+                std::printf("MISMATCH %s(\"%s\"): regex %d, scanner %d, buffer %d\n", validator.name,
+                            input.c_str(), expected, actual, buffered);
+            }
+        }
+    }
+
+    std::string twoDigits(int value) {
+        return std::string(1, static_cast<char>('0' + value / 10)) + static_cast<char>('0' + value % 10);
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t randomInputs = Bench::argCount(argc, argv, 1, 100000);
+
+    std::vector<Validator> validators = {
+        {"isValidEmail", RegexValidation::isValidEmail, Validation::isValidEmail, Validation::isValidEmail,
+         "ab_Z9.@-", {"user@example.com", "first.last@mail.example.org", "a_b@c.de", "x9@y.z"}},
+        {"isValidPhone", RegexValidation::isValidPhone, Validation::isValidPhone, Validation::isValidPhone,
+         "0123456789()-. x", {"555-123-4567", "(555) 123-4567", "555.123.4567", "5551234567", "(555)1234567"}},
+        {"isValidDate", RegexValidation::isValidDate, Validation::isValidDate, Validation::isValidDate,
+         "0123456789-/ ", {"2024-02-29", "1999-12-31", "2000-01-01"}},
+        {"isValidTime", RegexValidation::isValidTime, Validation::isValidTime, Validation::isValidTime,
+         "0123456789: ", {"9:05", "09:05", "23:59", "0:00"}}};
+
+    // Exhaustive sweeps over the numeric fields, including out-of-range values
+    for (int year : {0, 1, 1900, 1999, 2000, 2023, 2024, 2100, 9999}) {
+        for (int month = 0; month <= 13; month++) {
+            for (int day = 0; day <= 32; day++) {
+                char date[16];
+                std::snprintf(date, sizeof(date), "%04d-%s-%s", year, twoDigits(month).c_str(),
+                              twoDigits(day).c_str());
+                check(validators[2], date);
+            }
+        }
+    }
+    for (int hour = 0; hour <= 29; hour++) {
+        for (int minute = 0; minute <= 69; minute++) {
+            check(validators[3], std::to_string(hour) + ":" + twoDigits(minute));
+            check(validators[3], twoDigits(hour) + ":" + twoDigits(minute));
+            check(validators[3], std::to_string(hour) + ":" + std::to_string(minute));
+        }
+    }
+
+    std::mt19937 random(1);
+    for (const auto& validator : validators) {
+        std::string alphabet = validator.alphabet;
+
+        // Every single-character deletion, substitution and insertion of the samples
+        for (const auto& sample : validator.samples) {
+            check(validator, sample);
+            for (size_t i = 0; i <= sample.size(); i++) {
+                if (i < sample.size()) {
+                    check(validator, sample.substr(0, i) + sample.substr(i + 1));
+                }
+                for (char c : alphabet) {
+                    if (i < sample.size()) {
+                        check(validator, sample.substr(0, i) + c + sample.substr(i + 1));
+                    }
+                    check(validator, sample.substr(0, i) + c + sample.substr(i));
+                }
+            }
+        }
+
+        // Random strings, biased towards the lengths the grammars accept
+        for (size_t n = 0; n < randomInputs; n++) {
+            std::string input;
+            size_t length = random() % 20;
+            for (size_t i = 0; i < length; i++) {
+                input += alphabet[random() % alphabet.size()];
+            }
+            check(validator, input);
+        }
+    }
+
+    std::printf("%zu inputs checked, %zu mismatches\n", checked, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -25,6 +25,8 @@ private:
     int tutorsAvailable;                        // Number of tutors who can teach this
     std::string documentationURL;
     bool isDeprecated;
+    std::vector<int> addedPrerequisites;        // Edits to the prerequisite graph's
+    std::vector<int> removedPrerequisites;      // level edges into this model
     
 public:
     // Constructors
@@ -90,6 +92,14 @@ public:
     bool getIsDeprecated() const;
     void setIsDeprecated(bool deprecated);
     
+    // Prerequisite edits. Adding or removing a prerequisite cancels an
+    // earlier opposite edit of it; forgetting one drops either edit.
+    const std::vector<int>& getAddedPrerequisites() const;
+    const std::vector<int>& getRemovedPrerequisites() const;
+    void addPrerequisite(int modelId);
+    void removePrerequisite(int modelId);
+    void forgetPrerequisite(int modelId);
+    
     // Utility methods
     std::string getComplexityDescription() const;  // Returns text description of complexity
     bool hasCapability(const std::string& capability) const;
@@ -6,6 +6,8 @@
 #include <vector>
 #include <map>
 #include <iostream>
+#include "../utils/SymbolTable.h"
+#include "../utils/SmallVector.h"
 
 class Client {
 private:
@@ -16,9 +18,9 @@ private:
     std::string phone;
     std::string company;
     std::string position;
-    std::vector<std::string> aiModelsOfInterest;    // AI models they want to learn
+    SmallVector<Symbol, 4> aiModelsOfInterest;      // AI models they want to learn (interned)
     std::vector<std::string> learningGoals;         // What they want to accomplish
-    std::map<std::string, int> aiModelProficiency;  // Current proficiency level (1-5)
+    SmallVector<SymbolLevel, 4> aiModelProficiency; // Current proficiency level (1-5) by interned model
     std::string registrationDate;
     int sessionsCompleted;
     std::string lastSessionDate;
@@ -55,11 +57,15 @@ public:
     std::string getPosition() const;
     void setPosition(const std::string& position);
     
-    // AI models of interest
-    const std::vector<std::string>& getAIModelsOfInterest() const;
+    // AI models of interest; names are resolved through the AI model symbol table
+    std::vector<std::string> getAIModelsOfInterest() const;
+    const SmallVector<Symbol, 4>& getAIModelSymbols() const;
     void addAIModel(const std::string& model);
+    void addAIModel(Symbol model);
     void removeAIModel(const std::string& model);
+    void removeAIModel(Symbol model);
     bool isInterestedIn(const std::string& model) const;
+    bool isInterestedIn(Symbol model) const;
     
     // Learning goals
     const std::vector<std::string>& getLearningGoals() const;
@@ -69,7 +75,9 @@ public:
     // AI model proficiency
     int getAIModelProficiency(const std::string& model) const;
     void setAIModelProficiency(const std::string& model, int level);
-    const std::map<std::string, int>& getAllProficiencies() const;
+    void setAIModelProficiency(Symbol model, int level);
+    std::map<std::string, int> getAllProficiencies() const;
+    const SmallVector<SymbolLevel, 4>& getProficiencySymbols() const;
     
     // Session tracking
     std::string getRegistrationDate() const;
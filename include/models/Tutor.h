@@ -5,14 +5,16 @@
 #include "User.h"
 #include <vector>
 #include <map>
+#include "../utils/SymbolTable.h"
+#include "../utils/SmallVector.h"
 
 class Tutor : public User {
 private:
-    std::vector<std::string> aiSpecializations;    // AI systems/models they can tutor
+    SmallVector<Symbol, 4> aiSpecializations;      // AI systems/models they can tutor (interned)
     std::vector<std::string> domainExpertise;      // Subject matter expertise
     std::string qualification;                     // Technical qualification
     int experienceYears;                           // Years of experience with AI
-    std::map<std::string, int> aiModelExperience;  // AI model and experience level (1-5)
+    SmallVector<SymbolLevel, 4> aiModelExperience; // Experience level (1-5) by interned AI model
     double hourlyRate;                             // Hourly rate for tutoring
     int sessionsCompleted;                         // Total sessions completed
     double averageRating;                          // Average rating from clients
@@ -29,10 +31,14 @@ public:
           double hourlyRate);
     
     // Getters and setters
-    const std::vector<std::string>& getAISpecializations() const;
+    // AI specializations; names are resolved through the AI model symbol table
+    std::vector<std::string> getAISpecializations() const;
+    const SmallVector<Symbol, 4>& getAISpecializationSymbols() const;
     void addAISpecialization(const std::string& aiModel);
+    void addAISpecialization(Symbol aiModel);
     void removeAISpecialization(const std::string& aiModel);
     bool hasAISpecialization(const std::string& aiModel) const;
+    bool hasAISpecialization(Symbol aiModel) const;
     
     const std::vector<std::string>& getDomainExpertise() const;
     void addDomainExpertise(const std::string& domain);
@@ -47,7 +53,8 @@ public:
     
     int getAIModelExperience(const std::string& aiModel) const;
     void setAIModelExperience(const std::string& aiModel, int level);
-    const std::map<std::string, int>& getAllAIModelExperience() const;
+    void setAIModelExperience(Symbol aiModel, int level);
+    std::map<std::string, int> getAllAIModelExperience() const;
     
     double getHourlyRate() const;
     void setHourlyRate(double rate);
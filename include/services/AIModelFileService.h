@@ -0,0 +1,32 @@
+// AIModelFileService.h
+#ifndef AI_MODEL_FILE_SERVICE_H
+#define AI_MODEL_FILE_SERVICE_H
+
+#include <string>
+#include "FileService.h"
+#include "../models/AIModel.h"
+
+// Persists AI models as pipe-delimited text or as a columnar snapshot.
+//
+// Text layout:
+//   id|name|version|developer|category|released|description|complexity|
+//   popularity|tutors|docURL|deprecated|capability;...|limitation;...|
+//   useCase;...|param=description;...|addedPrerequisiteId;...|
+//   removedPrerequisiteId;...
+class AIModelFileService : public FileService<AIModel> {
+private:
+    std::string serializeObject(const AIModel& model) const override;
+    AIModel deserializeObject(const std::string& data) const override;
+    
+    bool supportsSnapshot() const override;
+    uint32_t getSnapshotSchemaVersion() const override;
+    bool canReadSnapshotSchema(uint32_t version) const override;
+    void encodeRecord(const AIModel& model, SnapshotBuilder& builder) const override;
+    AIModel decodeRecord(const SnapshotView& view, size_t row) const override;
+    
+public:
+    AIModelFileService(const std::string& filename = "data/aimodels.dat",
+                       StorageFormat format = StorageFormat::Snapshot);
+};
+
+#endif // AI_MODEL_FILE_SERVICE_H
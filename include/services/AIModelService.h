@@ -6,22 +6,147 @@
 #include <vector>
 #include <memory>
 #include <map>
+#include <set>
+#include <unordered_map>
+#include <utility>
 #include "../models/AIModel.h"
+#include "../models/Client.h"
+#include "AIModelFileService.h"
+#include "RecordStore.h"
+#include "../utils/Leaderboard.h"
+#include "../utils/PrerequisiteGraph.h"
+#include "../utils/SimilarityIndex.h"
+#include "../utils/VersionedMemo.h"
+
+// Learning path cache counters
+struct LearningPathCacheStats {
+    size_t entries;
+    size_t hits;
+    size_t misses;
+    
+    LearningPathCacheStats() : entries(0), hits(0), misses(0) {}
+};
 
 class AIModelService {
 private:
-    std::vector<std::shared_ptr<AIModel>> aiModels;
+    RecordStore<AIModel, AIModelFileService> aiModels;
     int nextModelId;
     
+    // Model IDs by popularity rank, lowest rank first. Built by the first
+    // ranking query and then kept current by each mutation.
+    mutable Leaderboard<int, std::less<int>> popularityLeaderboard;
+    mutable bool popularityLeaderboardBuilt;
+    
+    // Secondary indexes over the catalog, following the same build-on-first-
+    // query rule. Within a category models are ordered by (complexity, ID),
+    // so the category lookup and the complexity range lookups of the
+    // learning path queries are both answered from one index.
+    mutable std::unordered_map<std::string, std::set<std::pair<int, int>>> modelsByCategoryLevel;
+    mutable std::unordered_map<std::string, std::set<int>> modelsByDeveloper;
+    mutable std::unordered_map<int, std::set<int>> modelsByComplexity;
+    mutable std::unordered_map<int, std::set<int>> modelsEditingPrerequisite;  // Models with an edit naming it
+    mutable std::map<std::pair<std::string, int>, std::set<int>> modelsRemovingPrerequisites;  // By level
+    mutable bool secondaryIndexesBuilt;
+    
+    // Prerequisite graph over model IDs. It is seeded from the catalog, with
+    // each model requiring the models at the next lower complexity level of
+    // its category. Each (category, complexity) level has an entry hub
+    // leading into its models and an exit hub they all lead into, and a
+    // level's exit hub leads into the next level's entry hub, so the seed
+    // takes a few edges per model rather than one per pair of models. A
+    // model with a level edge removed is linked from the rest of the level
+    // below one by one instead. Models carry their own prerequisite edits,
+    // which are applied on top of the seed. Once built, the graph is only
+    // touched by adds, removes, category and complexity changes and edits,
+    // each of which relinks just the models it moves. Level edges are linked
+    // unchecked, so when edits exist a move can close a cycle through one;
+    // the next query then reseeds the graph, which skips that edit. While
+    // an edit is skipped, any later move reseeds again, so the edit comes
+    // back once nothing conflicts with it.
+    struct PrerequisiteLevelHubs {
+        int entry;
+        int exit;
+    };
+    mutable PrerequisiteGraph prerequisiteGraph;
+    mutable bool prerequisiteGraphBuilt;
+    mutable std::map<std::pair<std::string, int>, PrerequisiteLevelHubs> prerequisiteLevelHubs;
+    mutable int nextPrerequisiteHubId;                      // Hub IDs count down from -1
+    mutable bool prerequisiteCycleCheckPending;             // A move linked level edges next to edits
+    mutable bool prerequisiteGraphStale;                    // A reseed may link other edits
+    mutable bool prerequisiteEditsSkipped;                  // The graph leaves out an edit
+    
+    // Learning path per client, valid while the graph and the client's
+    // proficiencies are the ones it was computed from
+    struct CachedLearningPath {
+        uint64_t graphVersion;
+        std::vector<SymbolLevel> proficiencies;
+        std::vector<int> modelIds;
+    };
+    mutable std::unordered_map<int, CachedLearningPath> learningPathCache;
+    mutable LearningPathCacheStats learningPathCacheStats;
+    
+    // TF-IDF vectors of each model's category, description, capabilities,
+    // limitations and use cases, for related model lookups. Built on first
+    // use; afterwards an edit re-vectorizes only the model it touched.
+    mutable SimilarityIndex modelSimilarity;
+    mutable bool modelSimilarityBuilt;
+    
+    // Bumped by every recorded mutation; the catalog analytics are memoized
+    // against it
+    uint64_t modificationVersion;
+    mutable VersionedMemo<std::map<std::string, int>> countMemo;
+    mutable VersionedMemo<double> figureMemo;
+    
     // Private helper methods
-    void loadAIModels();  // Load AI models from file
-    void saveAIModels();  // Save AI models to file
+    void seedSampleModels();  // Populate sample data on first run
+    void loadAIModels();  // Load snapshots and replay the journals
+    void saveAIModels();  // Write full snapshots and reset the journals
+    void recordMutation(uint8_t type, int modelId, const std::vector<std::string>& fields = {});
+    void applyJournalRecord(const JournalRecord& record);
+    JournalRecord buildUpsertRecord(int modelId) const;
+    void buildPopularityLeaderboard() const;
+    void buildSecondaryIndexes() const;
+    void indexModel(const AIModel& model);
+    void unindexModel(const AIModel& model);
+    void buildPrerequisiteGraph() const;
+    std::vector<int> getLowerLevelModels(const std::string& category, int complexity) const;
+    void linkLowerLevel(const AIModel& model) const;
+    void linkAddedPrerequisite(int prerequisiteId, int modelId) const;
+    void linkPrerequisites(const AIModel& model) const;
+    void unlinkPrerequisites(const AIModel& model) const;
+    void relinkPrerequisites(const AIModel& model) const;
+    void relinkLevel(const std::pair<std::string, int>& levelKey) const;
+    void buildModelSimilarity() const;
+    void vectorizeModel(const AIModel& model);
+    std::vector<std::shared_ptr<AIModel>> resolveModels(const std::set<int>& modelIds) const;
+    std::vector<std::shared_ptr<AIModel>> resolveModels(const std::vector<int>& modelIds) const;
+    std::vector<std::shared_ptr<AIModel>> resolveModels(std::set<std::pair<int, int>>::const_iterator first,
+                                                        std::set<std::pair<int, int>>::const_iterator last) const;
     
 public:
-    // Constructor and Destructor
-    AIModelService();
+    // Constructor and Destructor; the layout splits the data files into shards
+    explicit AIModelService(const ShardLayout& layout = ShardLayout());
     ~AIModelService();
     
+    // Persistence settings
+    void setJournalSyncPolicy(JournalSyncPolicy policy, int intervalMs = 1000);
+    void setCompactionThresholds(size_t maxRecords, uint64_t maxBytes);
+    CompactionStats getCompactionStats() const;
+    const ShardLayout& getShardLayout() const;
+    
+    // Deferred persistence: mutations mark models dirty and are written in
+    // batches by flush(), the flush timer, or the end of a transaction
+    void setDeferredPersistence(bool enabled, int flushIntervalMs = 1000);
+    bool flush();
+    void beginTransaction();
+    bool commitTransaction();
+    PersistenceStats getPersistenceStats() const;
+    
+    // Lazy loading: models are read from the data file on first access. A
+    // limit bounds how many unmodified models stay in memory (0 = no limit).
+    void setResidentLimit(size_t maxModels);
+    RecordCacheStats getCacheStats() const;
+    
     // Model management methods
     bool addAIModel(std::shared_ptr<AIModel> model);
     bool removeAIModel(int modelId);
@@ -33,6 +158,9 @@ public:
     std::shared_ptr<AIModel> getModelById(int modelId) const;
     std::shared_ptr<AIModel> getModelByName(const std::string& name) const;
     std::vector<std::shared_ptr<AIModel>> getAllModels() const;
+    
+    // Indexed lookups. Category results are ordered by complexity and then
+    // ID; developer and complexity results by ID.
     std::vector<std::shared_ptr<AIModel>> getModelsByCategory(const std::string& category) const;
     std::vector<std::shared_ptr<AIModel>> getModelsByDeveloper(const std::string& developer) const;
     std::vector<std::shared_ptr<AIModel>> getModelsByComplexity(int complexityLevel) const;
@@ -63,11 +191,32 @@ public:
     std::map<std::string, int> getDeveloperModelCounts() const;
     double getAverageModelComplexity() const;
     
-    // Learning path recommendations
-    std::vector<std::shared_ptr<AIModel>> getRecommendedLearningPath(int clientId) const;
-    std::vector<std::shared_ptr<AIModel>> getRelatedModels(int modelId) const;
+    // Changes with every mutation, so callers can tell whether results they
+    // kept are still current
+    uint64_t getModificationVersion() const;
+    MemoStats getAnalyticsMemoStats() const;
+    
+    // Learning path recommendations. The path is every model the client
+    // has not mastered yet (proficiency below the model's complexity),
+    // prerequisites first. It is cached per client until that client's
+    // proficiencies or the prerequisite graph change.
+    std::vector<std::shared_ptr<AIModel>> getRecommendedLearningPath(const Client& client) const;
+    LearningPathCacheStats getLearningPathCacheStats() const;
+    
+    // Up to count models whose text is most like this one's, most similar
+    // first; models sharing no words with it are left out
+    std::vector<std::shared_ptr<AIModel>> getRelatedModels(int modelId, size_t count = 10) const;
+    
+    // Everything the model transitively requires, or is required by, in the
+    // prerequisite graph, prerequisites first
     std::vector<std::shared_ptr<AIModel>> getPrerequisiteModels(int modelId) const;
     std::vector<std::shared_ptr<AIModel>> getNextLevelModels(int modelId) const;
+    
+    // Prerequisite graph edits. Adding fails for an unknown model or an edge
+    // that would make a cycle. Edits are stored with the model they apply
+    // to and are dropped when the other model is removed.
+    bool addModelPrerequisite(int modelId, int prerequisiteId);
+    bool removeModelPrerequisite(int modelId, int prerequisiteId);
 };
 
 #endif // AI_MODEL_SERVICE_H
\ No newline at end of file
@@ -8,10 +8,11 @@
 #include "../models/User.h"
 #include "../models/Admin.h"
 #include "../models/Tutor.h"
+#include "IndexedRepository.h"
 
 class AuthService {
 private:
-    std::vector<std::shared_ptr<User>> users;
+    IndexedRepository<User> users;
     std::shared_ptr<User> currentUser;
     bool isLoggedIn;
     
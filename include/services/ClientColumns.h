@@ -0,0 +1,95 @@
+// ClientColumns.h
+#ifndef CLIENT_COLUMNS_H
+#define CLIENT_COLUMNS_H
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+#include "../models/Client.h"
+
+// Range conditions over the columns, all of which a row must meet. Bounds
+// are inclusive unless noted, dates are YYYYMMDD as from encodeDate, and a
+// default-constructed filter matches every row.
+struct ClientColumnFilter {
+    double minBudget;
+    bool minBudgetInclusive;        // false for "budget > minBudget"
+    double maxBudget;
+    int minSessions;
+    int maxSessions;
+    int32_t registeredFrom;
+    int32_t registeredTo;
+    int32_t lastSessionBefore;      // Last session before this date, or none
+
+    ClientColumnFilter();
+
+    bool isEmpty() const;
+
+    // Conditions in readable form, e.g. "budget > 500, sessions <= 3"
+    std::string describe() const;
+};
+
+// Columnar copy of the numeric and date fields of every client.
+//
+// Each field is stored in its own contiguous array, one row per client, so
+// analytics scan only the values they need instead of chasing a pointer to
+// each Client and pulling in its strings. Dates are stored as YYYYMMDD
+// integers (0 when unset), which keeps their order. Rows are unordered; a
+// removed row is replaced by the last one.
+class ClientColumns {
+private:
+    std::vector<int> clientIds;
+    std::vector<int> sessionsCompleted;
+    std::vector<double> budgets;
+    std::vector<int32_t> registrationDates;
+    std::vector<int32_t> lastSessionDates;
+    std::unordered_map<int, size_t> rowById;
+
+    size_t rowFor(int clientId);
+    bool rowMatches(size_t row, const ClientColumnFilter& filter) const;
+
+public:
+    // "YYYY-MM-DD" as YYYYMMDD; 0 for an empty, malformed or non-calendar date
+    static int32_t encodeDate(const std::string& date);
+
+    // Insert or refresh a client's row
+    void upsert(const Client& client);
+    void remove(int clientId);
+    void clear();
+
+    // Single-field updates for the hot mutation paths
+    void setSessions(int clientId, int sessions, const std::string& lastSessionDate);
+    void setBudget(int clientId, double budget);
+
+    size_t size() const;
+    bool contains(int clientId) const;
+
+    // Aggregates
+    long long sumSessions() const;
+    double sumBudget() const;
+
+    // Filters; client IDs in row order
+    std::vector<int> findBudgetAtLeast(double minimum) const;
+    std::vector<int> findRegisteredBetween(int32_t fromDate, int32_t toDate) const;
+    std::vector<int> findInactiveSince(int32_t date) const;     // Last session before date, or none
+
+    // Every condition of filter at once, in one pass over the columns
+    std::vector<int> find(const ClientColumnFilter& filter) const;
+
+    // Approximate number of rows find(filter) returns, from an evenly
+    // spaced sample of about sampleRows rows
+    size_t estimate(const ClientColumnFilter& filter, size_t sampleRows = 1024) const;
+
+    // True if the client's row meets every condition of filter
+    bool matches(int clientId, const ClientColumnFilter& filter) const;
+
+    // Clients per sessions-completed bucket of the given width; the last
+    // bucket also holds everything beyond it
+    std::vector<size_t> sessionHistogram(int bucketWidth, size_t bucketCount) const;
+
+    // True if the row for client matches its current field values
+    bool matches(const Client& client) const;
+};
+
+#endif // CLIENT_COLUMNS_H
@@ -0,0 +1,29 @@
+// ClientFileService.h
+#ifndef CLIENT_FILE_SERVICE_H
+#define CLIENT_FILE_SERVICE_H
+
+#include <string>
+#include "FileService.h"
+#include "../models/Client.h"
+
+// Persists clients as pipe-delimited text or as a columnar snapshot.
+//
+// Text layout:
+//   id|first|last|email|phone|company|position|registered|sessions|
+//   lastSession|budget|interest;...|goal;...|model:level;...
+class ClientFileService : public FileService<Client> {
+private:
+    std::string serializeObject(const Client& client) const override;
+    Client deserializeObject(const std::string& data) const override;
+    
+    bool supportsSnapshot() const override;
+    uint32_t getSnapshotSchemaVersion() const override;
+    void encodeRecord(const Client& client, SnapshotBuilder& builder) const override;
+    Client decodeRecord(const SnapshotView& view, size_t row) const override;
+    
+public:
+    ClientFileService(const std::string& filename = "data/clients.dat",
+                      StorageFormat format = StorageFormat::Snapshot);
+};
+
+#endif // CLIENT_FILE_SERVICE_H
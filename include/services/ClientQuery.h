@@ -0,0 +1,111 @@
+// ClientQuery.h
+#ifndef CLIENT_QUERY_H
+#define CLIENT_QUERY_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <utility>
+#include <cstddef>
+#include "../models/Client.h"
+#include "ClientColumns.h"
+
+// A set of conditions a client must all meet, built by chaining, e.g.
+//
+//   ClientQuery().companyContains("Tech").budgetAbove(500)
+//                .interestedIn("GPT-4").noSessionSince("2024-01-01")
+//
+// ClientService::findClients plans and runs it. Conditions on IDs, names,
+// companies, AI model interests and the numeric columns can be answered
+// from an index; where() conditions need the full client and are checked
+// last, on whatever candidates remain.
+class ClientQuery {
+public:
+    typedef std::function<bool(const Client&)> Predicate;
+
+private:
+    std::vector<int> clientIds;         // Sorted; only used if hasClientIds
+    bool hasClientIds;
+    std::vector<std::string> nameTexts;
+    std::vector<std::string> companyTexts;
+    std::vector<std::string> allOfModels;
+    std::vector<std::string> anyOfModels;
+    std::vector<std::string> noneOfModels;
+    ClientColumnFilter columnFilter;
+    std::vector<std::pair<std::string, Predicate>> predicates;  // (description, test)
+    size_t maxResults;                  // 0 = no limit
+
+    friend class ClientService;
+
+    static bool isUsableDate(const std::string& date);
+
+public:
+    ClientQuery();
+
+    // Only these clients; repeated calls keep the IDs common to all of them
+    ClientQuery& idIn(const std::vector<int>& ids);
+
+    // Case-insensitive substring of the full name or company
+    ClientQuery& nameContains(const std::string& text);
+    ClientQuery& companyContains(const std::string& text);
+
+    // AI model interests: every interestedIn model, at least one of the
+    // interestedInAny models, and none of the notInterestedIn models
+    ClientQuery& interestedIn(const std::string& aiModel);
+    ClientQuery& interestedInAny(const std::vector<std::string>& aiModels);
+    ClientQuery& notInterestedIn(const std::string& aiModel);
+
+    // Numeric and date ranges; dates are "YYYY-MM-DD" and bounds inclusive.
+    // A malformed date is logged and its bound ignored.
+    ClientQuery& budgetAtLeast(double minimum);
+    ClientQuery& budgetAbove(double minimum);
+    ClientQuery& budgetAtMost(double maximum);
+    ClientQuery& sessionsBetween(int minimum, int maximum);
+    ClientQuery& registeredBetween(const std::string& fromDate, const std::string& toDate);
+    ClientQuery& noSessionSince(const std::string& date);   // Last session before date, or none
+
+    // Any other condition; the description is what the plan shows for it
+    ClientQuery& where(const std::string& description, Predicate predicate);
+
+    // At most count clients, lowest IDs first
+    ClientQuery& limit(size_t count);
+};
+
+// How a plan step uses its condition
+enum ClientQueryAccess {
+    ACCESS_SCAN,        // No usable index: start from every client
+    ACCESS_DRIVE,       // Most selective index; gives the first candidates
+    ACCESS_INTERSECT,   // Index result intersected with the candidates
+    ACCESS_PROBE,       // Index looked up once per candidate
+    ACCESS_FILTER,      // Condition tested on each loaded candidate
+    ACCESS_LIMIT        // Result cut to the requested size
+};
+
+// One step of a plan, in the order the steps run
+struct ClientQueryStep {
+    ClientQueryAccess access;
+    std::string source;         // Index or condition used, e.g. "company trigram index"
+    std::string condition;
+    size_t estimatedRows;       // Rows the condition alone would match
+    size_t actualRows;          // Candidates left after the step; set once run
+
+    ClientQueryStep(ClientQueryAccess access, const std::string& source,
+                    const std::string& condition, size_t estimatedRows)
+        : access(access), source(source), condition(condition),
+          estimatedRows(estimatedRows), actualRows(0) {}
+};
+
+// The path chosen for a query, as returned by ClientService::explainClientQuery
+// or filled in by findClients
+struct ClientQueryPlan {
+    size_t totalClients;
+    bool executed;              // actualRows are only meaningful when true
+    std::vector<ClientQueryStep> steps;
+
+    ClientQueryPlan() : totalClients(0), executed(false), steps() {}
+
+    // One line per step, EXPLAIN style
+    std::string toString() const;
+};
+
+#endif // CLIENT_QUERY_H
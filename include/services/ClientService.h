@@ -6,26 +6,136 @@
 #include <vector>
 #include <memory>
 #include <map>
+#include <unordered_map>
 #include "../models/Client.h"
+#include "ClientFileService.h"
+#include "RecordStore.h"
+#include "ClientColumns.h"
+#include "ClientQuery.h"
+#include "../utils/TrigramIndex.h"
+#include "../utils/CompressedBitmap.h"
+#include "../utils/Leaderboard.h"
+#include "../utils/VersionedMemo.h"
+
+// Why one row of a bulk import was rejected
+struct ClientImportError {
+    size_t row;             // Position in the batch
+    std::string message;
+    
+    ClientImportError(size_t row, const std::string& message) : row(row), message(message) {}
+};
+
+// Outcome of a bulk import
+struct ClientImportReport {
+    size_t imported;            // Rows added
+    int firstAssignedId;        // Block of IDs given to rows without one;
+    int lastAssignedId;         // both 0 if none were assigned
+    std::vector<ClientImportError> errors;
+    bool persisted;             // False if the group commit failed; the rows
+                                // are in memory but may not survive a restart
+    
+    ClientImportReport() : imported(0), firstAssignedId(0), lastAssignedId(0), errors(), persisted(true) {}
+};
 
 class ClientService {
 private:
-    std::vector<std::shared_ptr<Client>> clients;
+    RecordStore<Client, ClientFileService> clients;
     int nextClientId;
     
+    // Substring search indexes over full names and companies, built by the
+    // first search so startup stays lazy
+    mutable TrigramIndex nameIndex;
+    mutable TrigramIndex companyIndex;
+    mutable bool searchIndexesBuilt;
+    
+    // Client IDs by AI model of interest, built by the first interest query
+    mutable std::unordered_map<Symbol, CompressedBitmap> interestIndex;
+    mutable CompressedBitmap interestIndexClients;  // Every indexed client
+    mutable bool interestIndexBuilt;
+    
+    // Running totals behind the analytics methods, built by the first
+    // analytics call and then adjusted by every mutation
+    mutable std::unordered_map<Symbol, int> modelInterestCounts;
+    mutable long long totalSessions;
+    mutable Leaderboard<int> sessionLeaderboard;    // Client IDs by sessions completed
+    mutable ClientColumns columns;                  // Numeric and date fields by column
+    mutable bool aggregatesBuilt;
+    
+    // AI model renames already written to the data files
+    uint64_t modelRenamesSaved;
+    
+    // Bumped by every recorded mutation. Analytics results are memoized
+    // against it (plus the AI model rename count, since results name the
+    // models), so repeated calls between mutations are lookups.
+    uint64_t modificationVersion;
+    mutable VersionedMemo<std::map<std::string, int>> countMemo;
+    mutable VersionedMemo<double> figureMemo;
+    mutable VersionedMemo<std::vector<size_t>> histogramMemo;
+    
     // Private helper methods
-    void loadClients();  // Load clients from file
-    void saveClients();  // Save clients to file
+    void seedSampleClients();  // Populate sample data on first run
+    void loadClients();  // Load snapshots and replay the journals
+    void saveClients();  // Write full snapshots and reset the journals
+    void recordMutation(uint8_t type, int clientId, const std::vector<std::string>& fields = {});
+    void applyJournalRecord(const JournalRecord& record);
+    JournalRecord buildUpsertRecord(int clientId) const;
+    void resetDerivedIndexes();
+    void buildSearchIndexes() const;
+    void indexClient(const Client& client);
+    void unindexClient(int clientId);
+    std::vector<std::shared_ptr<Client>> resolveClients(const std::vector<int>& clientIds) const;
+    void buildInterestIndex() const;
+    void indexInterests(const Client& client);
+    void unindexInterests(const Client& client);
+    CompressedBitmap interestedClients(const std::string& aiModel) const;
+    CompressedBitmap interestMatches(const std::vector<std::string>& allOf, const std::vector<std::string>& anyOf,
+                                     const std::vector<std::string>& noneOf) const;
+    std::vector<int> runClientQuery(const ClientQuery& query, bool execute, ClientQueryPlan& plan) const;
+    std::map<std::string, int> countInterestsByName(const std::unordered_map<Symbol, int>& counts) const;
+    void buildAggregates() const;
+    void addToAggregates(const Client& client, int sign);
+    void adjustInterestCount(Symbol aiModel, int delta);
+    uint64_t analyticsVersion() const;
     bool isValidEmail(const std::string& email) const;
     bool isValidPhone(const std::string& phone) const;
     
 public:
-    // Constructor and Destructor
-    ClientService();
+    // Constructor and Destructor; the layout splits the data files into shards
+    explicit ClientService(const ShardLayout& layout = ShardLayout());
     ~ClientService();
     
+    // Persistence settings
+    void setJournalSyncPolicy(JournalSyncPolicy policy, int intervalMs = 1000);
+    void setCompactionThresholds(size_t maxRecords, uint64_t maxBytes);
+    CompactionStats getCompactionStats() const;
+    const ShardLayout& getShardLayout() const;
+    
+    // Deferred persistence: mutations mark clients dirty and are written in
+    // batches by flush(), the flush timer, or the end of a transaction
+    void setDeferredPersistence(bool enabled, int flushIntervalMs = 1000);
+    bool flush();
+    void beginTransaction();
+    bool commitTransaction();
+    PersistenceStats getPersistenceStats() const;
+    
+    // Lazy loading: clients are read from the data file on first access. A
+    // limit bounds how many unmodified clients stay in memory (0 = no limit).
+    void setResidentLimit(size_t maxClients);
+    RecordCacheStats getCacheStats() const;
+    
     // Client management methods
     bool addClient(std::shared_ptr<Client> client);
+    
+    // Bulk import: rows are validated in parallel, valid rows without an ID
+    // get one contiguous block of IDs, and the batch is persisted as one
+    // group commit. Invalid rows are skipped and listed in the report
+    // rather than thrown, and a failed commit clears report.persisted.
+    ClientImportReport addClients(const std::vector<std::shared_ptr<Client>>& batch);
+    
+    template <typename Iterator>
+    ClientImportReport addClients(Iterator first, Iterator last) {
+        return addClients(std::vector<std::shared_ptr<Client>>(first, last));
+    }
     bool removeClient(int clientId);
     bool updateClientDetails(int clientId, const std::string& firstName, 
                            const std::string& lastName, const std::string& email,
@@ -39,6 +149,32 @@ public:
     std::vector<std::shared_ptr<Client>> searchClientsByCompany(const std::string& company) const;
     std::vector<std::shared_ptr<Client>> getClientsInterestedInModel(const std::string& aiModel) const;
     
+    // Interest queries answered from a bitmap index: clients interested in
+    // every model in allOf, in at least one model in anyOf (when given), and
+    // in none of noneOf. Empty allOf and anyOf start from every client.
+    std::vector<std::shared_ptr<Client>> getClientsByInterest(const std::vector<std::string>& allOf,
+                                                              const std::vector<std::string>& anyOf = {},
+                                                              const std::vector<std::string>& noneOf = {}) const;
+    
+    // Client ID sets per model, for composing other AND/OR/ANDNOT queries
+    CompressedBitmap getInterestedClientIds(const std::string& aiModel) const;
+    std::vector<std::shared_ptr<Client>> getClientsByIds(const CompressedBitmap& clientIds) const;
+    
+    // Ranked search: at most limit clients, prefix matches first, then
+    // matches at a word start, then anywhere; shorter text breaks ties
+    std::vector<std::shared_ptr<Client>> searchClientsByName(const std::string& name, size_t limit) const;
+    std::vector<std::shared_ptr<Client>> searchClientsByCompany(const std::string& company, size_t limit) const;
+    
+    // Combined queries. The planner looks at every indexed condition (IDs,
+    // name and company trigrams, interest bitmaps, numeric columns), starts
+    // from the most selective one, then either intersects with or probes
+    // each of the others, and only loads clients for the where() conditions.
+    // Results are in ascending ID order. Pass a plan to see the path taken.
+    std::vector<std::shared_ptr<Client>> findClients(const ClientQuery& query, ClientQueryPlan* plan = nullptr) const;
+    
+    // The plan findClients would follow, from estimates only
+    ClientQueryPlan explainClientQuery(const ClientQuery& query) const;
+    
     // Client progress tracking methods
     bool updateClientProgress(int clientId, const std::string& aiModel, int proficiencyLevel);
     std::map<std::string, int> getClientProficiencies(int clientId) const;
@@ -59,6 +195,25 @@ public:
     std::map<std::string, int> getPopularAIModels() const;
     double getAverageClientSessions() const;
     std::vector<std::shared_ptr<Client>> getTopClients(int count) const;
+    
+    // Columnar analytics over sessions, budgets and dates ("YYYY-MM-DD")
+    double getTotalClientBudget() const;
+    double getAverageClientBudget() const;
+    std::vector<std::shared_ptr<Client>> getClientsWithBudgetAtLeast(double minimum) const;
+    std::vector<std::shared_ptr<Client>> getClientsRegisteredBetween(const std::string& fromDate,
+                                                                     const std::string& toDate) const;
+    std::vector<std::shared_ptr<Client>> getClientsInactiveSince(const std::string& date) const;
+    std::vector<size_t> getSessionHistogram(int bucketWidth, size_t bucketCount) const;
+    
+    // Changes with every mutation, so callers can tell whether results they
+    // kept are still current
+    uint64_t getModificationVersion() const;
+    MemoStats getAnalyticsMemoStats() const;
+    
+    // Recomputes the analytics totals from every client and logs any
+    // difference from the maintained values. Debug builds run it on every
+    // analytics call.
+    bool checkAggregates() const;
 };
 
 #endif // CLIENT_SERVICE_H
\ No newline at end of file
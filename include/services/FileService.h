@@ -8,61 +8,586 @@
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <iterator>
+#include <functional>
+#include <thread>
+#include <exception>
+#include "SnapshotFormat.h"
+#include "RecordSource.h"
+#include "../utils/MappedFile.h"
+#include "../utils/FileSync.h"
+#include "../utils/FieldTokenizer.h"
+#include "../utils/Exception.h"
+
+// On-disk representation used by saveToFile()
+enum class StorageFormat {
+    Text,       // One pipe-delimited line per record
+    Snapshot    // Versioned binary columnar snapshot (see SnapshotFormat.h)
+};
 
 // Generic template class for serialization and deserialization of data
 template <typename T>
 class FileService {
 private:
     std::string filename;
+    StorageFormat format;
+    unsigned parseThreads;
+    
+    // Text files smaller than this are parsed on the calling thread
+    static const size_t PARALLEL_PARSE_MIN_BYTES = 1 << 20;
     
     // Helper methods for serialization
     virtual std::string serializeObject(const T& object) const = 0;
     virtual T deserializeObject(const std::string& data) const = 0;
     
+    // Columnar snapshot hooks. Types that do not override supportsSnapshot()
+    // are always written in the text format.
+    virtual bool supportsSnapshot() const { return false; }
+    virtual uint32_t getSnapshotSchemaVersion() const { return 1; }
+    // Snapshots are written in the current schema; a type whose
+    // decodeRecord() also handles older ones says so here
+    virtual bool canReadSnapshotSchema(uint32_t version) const { return version == getSnapshotSchemaVersion(); }
+    virtual void encodeRecord(const T& /*object*/, SnapshotBuilder& /*builder*/) const {
+        throw FileException("Snapshot format not supported for " + filename);
+    }
+    virtual T decodeRecord(const SnapshotView& /*view*/, size_t /*row*/) const {
+        throw FileException("Snapshot format not supported for " + filename);
+    }
+    
+    // Writes to a temporary file and renames it over the target, so readers
+    // only ever see the previous or the new complete file; true means the
+    // new file is durable. encode() adds one record to a snapshot and
+    // toText() returns its text line.
+    template <typename Range, typename Encode, typename ToText>
+    bool writeRecords(const Range& records, Encode encode, ToText toText) const {
+        std::string tempFilename = filename + ".tmp";
+        
+        if (format == StorageFormat::Snapshot && supportsSnapshot()) {
+            SnapshotBuilder builder;
+            for (const auto& record : records) {
+                encode(record, builder);
+            }
+            
+            if (!builder.writeTo(tempFilename, getSnapshotSchemaVersion())) {
+                std::cerr << "Error: Could not open file for writing: " << tempFilename << std::endl;
+                return false;
+            }
+            return replaceFile(tempFilename, filename);
+        }
+        
+        std::ofstream file(tempFilename);
+        if (!file.is_open()) {
+            std::cerr << "Error: Could not open file for writing: " << tempFilename << std::endl;
+            return false;
+        }
+        
+        for (const auto& record : records) {
+            file << toText(record) << '\n';
+        }
+        
+        file.close();
+        if (file.fail()) {
+            std::cerr << "Error: Could not write file: " << tempFilename << std::endl;
+            return false;
+        }
+        return replaceFile(tempFilename, filename);
+    }
+    
+    template <typename Range, typename Deref>
+    bool writeObjects(const Range& objects, Deref deref) const {
+        return writeRecords(objects,
+            [this, &deref](const typename Range::value_type& object, SnapshotBuilder& builder) {
+                builder.beginRecord();
+                encodeRecord(deref(object), builder);
+            },
+            [this, &deref](const typename Range::value_type& object) {
+                return serializeObject(deref(object));
+            });
+    }
+    
+    // The new contents are synced before the rename and the rename itself
+    // after it, so once this returns true the target survives a crash and
+    // whatever it supersedes (a set-aside journal, old shard files) can go.
+    static bool replaceFile(const std::string& source, const std::string& target) {
+        if (!FileSync::syncFile(source)) {
+            std::cerr << "Error: Could not sync file: " << source << std::endl;
+            return false;
+        }
+#ifdef _WIN32
+        // rename() does not overwrite on Windows
+        std::remove(target.c_str());
+#endif
+        if (std::rename(source.c_str(), target.c_str()) != 0) {
+            std::cerr << "Error: Could not replace file: " << target << std::endl;
+            return false;
+        }
+        if (!FileSync::syncParentDirectory(target)) {
+            std::cerr << "Error: Could not sync directory of: " << target << std::endl;
+            return false;
+        }
+        return true;
+    }
+    
+    std::vector<T> loadFromSnapshot() const {
+        std::vector<T> objects;
+        SnapshotView view(filename);
+        
+        if (!canReadSnapshotSchema(view.getSchemaVersion())) {
+            std::cerr << "Error: Snapshot schema version " << view.getSchemaVersion()
+                      << " is not readable as version " << getSnapshotSchemaVersion()
+                      << ": " << filename << std::endl;
+            return objects;
+        }
+        
+        size_t count = view.getRecordCount();
+        objects.reserve(count);
+        for (size_t row = 0; row < count; row++) {
+            objects.push_back(decodeRecord(view, row));
+        }
+        return objects;
+    }
+    
+    // Parses the lines in [begin, end) in order
+    void parseLines(const char* begin, const char* end, std::vector<T>& objects) const {
+        const char* line = begin;
+        while (line < end) {
+            const char* newline = static_cast<const char*>(std::memchr(line, '\n', end - line));
+            const char* lineEnd = newline ? newline : end;
+            if (lineEnd > line) {
+                objects.push_back(deserializeObject(std::string(line, lineEnd - line)));
+            }
+            line = lineEnd + 1;
+        }
+    }
+    
+    // Splits a mapped text file into chunks at line boundaries, parses them
+    // on separate threads and concatenates the results in file order
+    std::vector<T> loadTextParallel(const MappedFile& file, unsigned threads) const {
+        const char* data = file.getData();
+        size_t size = file.getSize();
+        
+        std::vector<size_t> bounds(1, 0);
+        for (unsigned i = 1; i < threads; i++) {
+            size_t pos = size / threads * i;
+            if (pos <= bounds.back()) {
+                continue;
+            }
+            const char* newline = static_cast<const char*>(std::memchr(data + pos, '\n', size - pos));
+            if (!newline) {
+                break;
+            }
+            bounds.push_back(static_cast<size_t>(newline - data) + 1);
+        }
+        bounds.push_back(size);
+        
+        size_t chunkCount = bounds.size() - 1;
+        std::vector<std::vector<T>> results(chunkCount);
+        std::vector<std::exception_ptr> errors(chunkCount);
+        auto parseChunk = [&](size_t chunk) {
+            try {
+                parseLines(data + bounds[chunk], data + bounds[chunk + 1], results[chunk]);
+            } catch (...) {
+                errors[chunk] = std::current_exception();
+            }
+        };
+        
+        std::vector<std::thread> workers;
+        for (size_t chunk = 1; chunk < chunkCount; chunk++) {
+            workers.emplace_back(parseChunk, chunk);
+        }
+        parseChunk(0);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        
+        for (const auto& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+        
+        size_t total = 0;
+        for (const auto& result : results) {
+            total += result.size();
+        }
+        
+        std::vector<T> objects;
+        objects.reserve(total);
+        for (auto& result : results) {
+            std::move(result.begin(), result.end(), std::back_inserter(objects));
+        }
+        return objects;
+    }
+    
+    // Rows of a mapped snapshot. The record ID is the first column of every
+    // snapshot schema, as it is the first field of every text line.
+    class SnapshotSource : public RecordSource<T> {
+    private:
+        const FileService<T>& service;
+        std::shared_ptr<const SnapshotView> view;
+        
+    public:
+        SnapshotSource(const FileService<T>& service, std::shared_ptr<const SnapshotView> view)
+            : service(service), view(view) {}
+        
+        size_t getRecordCount() const override { return view->getRecordCount(); }
+        int getRecordId(size_t row) const override { return static_cast<int>(view->getInt(0, row)); }
+        T decodeRecord(size_t row) const override { return service.decodeRecord(*view, row); }
+        const SnapshotView* getSnapshot() const override { return view.get(); }
+    };
+    
+    // Lines of a mapped text file, indexed by record ID and line offset.
+    // Building the index parses only the leading ID field of each line.
+    class TextIndexSource : public RecordSource<T> {
+    private:
+        const FileService<T>& service;
+        MappedFile file;
+        std::vector<size_t> offsets;
+        std::vector<int> ids;
+        
+    public:
+        explicit TextIndexSource(const FileService<T>& service) : service(service) {}
+        
+        bool open(const std::string& path) {
+            if (!file.open(path)) {
+                return false;
+            }
+            
+            const char* data = file.getData();
+            size_t size = file.getSize();
+            size_t pos = 0;
+            while (pos < size) {
+                const char* newline = static_cast<const char*>(std::memchr(data + pos, '\n', size - pos));
+                size_t end = newline ? static_cast<size_t>(newline - data) : size;
+                if (end > pos) {
+                    FieldView line(data + pos, end - pos);
+                    int id = 0;
+                    if (!FieldParser::parseInt(line.substr(0, line.find('|')), id)) {
+                        throw FileException("Invalid record ID at offset " + std::to_string(pos) +
+                                            " of " + path);
+                    }
+                    offsets.push_back(pos);
+                    ids.push_back(id);
+                }
+                pos = end + 1;
+            }
+            return true;
+        }
+        
+        size_t getRecordCount() const override { return offsets.size(); }
+        int getRecordId(size_t row) const override { return ids[row]; }
+        
+        T decodeRecord(size_t row) const override {
+            const char* data = file.getData();
+            size_t size = file.getSize();
+            size_t start = offsets[row];
+            const char* newline = static_cast<const char*>(std::memchr(data + start, '\n', size - start));
+            size_t end = newline ? static_cast<size_t>(newline - data) : size;
+            return service.deserializeObject(std::string(data + start, end - start));
+        }
+    };
+    
+protected:
+    // Text format helpers shared by the concrete services. Fields are read
+    // through FieldTokenizer views, so only the final owned strings allocate.
+    static int parseIntField(const FieldView& field, const char* name) {
+        int value = 0;
+        if (!FieldParser::parseInt(field, value)) {
+            throw FileException(std::string("Invalid ") + name + ": " + field.str());
+        }
+        return value;
+    }
+    
+    static double parseDoubleField(const FieldView& field, const char* name) {
+        double value = 0.0;
+        if (!FieldParser::parseDouble(field, value)) {
+            throw FileException(std::string("Invalid ") + name + ": " + field.str());
+        }
+        return value;
+    }
+    
+    static std::string joinFields(const std::vector<std::string>& values, char delimiter) {
+        std::string joined;
+        for (size_t i = 0; i < values.size(); i++) {
+            if (i > 0) {
+                joined += delimiter;
+            }
+            joined += sanitizeField(values[i], delimiter);
+        }
+        return joined;
+    }
+    
+    static std::string joinInts(const std::vector<int>& values, char delimiter) {
+        std::string joined;
+        for (size_t i = 0; i < values.size(); i++) {
+            if (i > 0) {
+                joined += delimiter;
+            }
+            joined += std::to_string(values[i]);
+        }
+        return joined;
+    }
+    
+    // Replaces characters that would break the line/field structure
+    static std::string sanitizeField(const std::string& value, char extraDelimiter = '|') {
+        std::string clean = value;
+        for (auto& c : clean) {
+            if (c == '|' || c == '\n' || c == '\r' || c == extraDelimiter) {
+                c = ' ';
+            }
+        }
+        return clean;
+    }
+    
 public:
     // Constructor
-    FileService(const std::string& filename) : filename(filename) {}
+    FileService(const std::string& filename, StorageFormat format = StorageFormat::Text)
+        : filename(filename), format(format),
+          parseThreads(std::max(1u, std::thread::hardware_concurrency())) {}
     
     // Virtual destructor
     virtual ~FileService() = default;
     
     // File operations
     bool saveToFile(const std::vector<T>& objects) const {
-        std::ofstream file(filename);
-        if (!file.is_open()) {
-            std::cerr << "Error: Could not open file for writing: " << filename << std::endl;
+        return writeObjects(objects, [](const T& object) -> const T& { return object; });
+    }
+    
+    bool saveToFile(const std::vector<std::shared_ptr<T>>& objects) const {
+        return writeObjects(objects, [](const std::shared_ptr<T>& object) -> const T& { return *object; });
+    }
+    
+    // A record to save: either an object or an unchanged row of a record
+    // source. Snapshot rows in the current schema are copied without being
+    // decoded.
+    struct StoredRecord {
+        std::shared_ptr<const T> object;
+        std::shared_ptr<const RecordSource<T>> source;
+        size_t row;
+    };
+    
+    bool saveToFile(const std::vector<StoredRecord>& records) const {
+        return writeRecords(records,
+            [this](const StoredRecord& record, SnapshotBuilder& builder) {
+                const SnapshotView* snapshot = record.object ? nullptr : record.source->getSnapshot();
+                if (snapshot && snapshot->getSchemaVersion() == getSnapshotSchemaVersion()) {
+                    builder.copyRecord(*snapshot, record.row);
+                    return;
+                }
+                builder.beginRecord();
+                encodeRecord(record.object ? *record.object : record.source->decodeRecord(record.row),
+                             builder);
+            },
+            [this](const StoredRecord& record) {
+                return serializeObject(record.object ? *record.object
+                                                     : record.source->decodeRecord(record.row));
+            });
+    }
+    
+    // Maps the file if it is a snapshot in a schema this type reads, for
+    // callers that read rows on demand; returns null otherwise
+    std::shared_ptr<const SnapshotView> openSnapshot() const {
+        if (!supportsSnapshot() || !SnapshotView::isSnapshotFile(filename)) {
+            return nullptr;
+        }
+        
+        auto view = std::make_shared<SnapshotView>(filename);
+        if (!canReadSnapshotSchema(view->getSchemaVersion())) {
+            std::cerr << "Error: Snapshot schema version " << view->getSchemaVersion()
+                      << " is not readable as version " << getSnapshotSchemaVersion()
+                      << ": " << filename << std::endl;
+            return nullptr;
+        }
+        return view;
+    }
+    
+    // Opens either format for on-demand reads: a snapshot is mapped as is,
+    // a text file is mapped and indexed. Returns null if it cannot be read.
+    std::shared_ptr<const RecordSource<T>> openRecordSource() const {
+        if (supportsSnapshot() && SnapshotView::isSnapshotFile(filename)) {
+            auto view = openSnapshot();
+            if (!view) {
+                return nullptr;
+            }
+            return std::make_shared<SnapshotSource>(*this, view);
+        }
+        
+        auto source = std::make_shared<TextIndexSource>(*this);
+        if (!source->open(filename)) {
+            std::cerr << "Warning: Could not open file for reading: " << filename << std::endl;
+            return nullptr;
+        }
+        return source;
+    }
+    
+    // Single-record text encoding, e.g. for journal payloads
+    std::string serialize(const T& object) const {
+        return serializeObject(object);
+    }
+    
+    T deserialize(const std::string& data) const {
+        return deserializeObject(data);
+    }
+    
+    // Reads records one at a time from either format, holding only the
+    // current record in memory
+    class RecordReader {
+    private:
+        const FileService<T>& service;
+        std::ifstream text;
+        SnapshotView view;
+        size_t row;
+        size_t rowCount;
+        bool snapshot;
+        bool open;
+        
+    public:
+        explicit RecordReader(const FileService<T>& service)
+            : service(service), row(0), rowCount(0), snapshot(false), open(false) {
+            if (service.supportsSnapshot() && SnapshotView::isSnapshotFile(service.filename)) {
+                view.open(service.filename);
+                if (!service.canReadSnapshotSchema(view.getSchemaVersion())) {
+                    std::cerr << "Error: Snapshot schema version " << view.getSchemaVersion()
+                              << " is not readable as version " << service.getSnapshotSchemaVersion()
+                              << ": " << service.filename << std::endl;
+                    return;
+                }
+                snapshot = true;
+                rowCount = view.getRecordCount();
+                open = true;
+                return;
+            }
+            
+            text.open(service.filename);
+            if (!text.is_open()) {
+                std::cerr << "Warning: Could not open file for reading: " << service.filename << std::endl;
+                return;
+            }
+            open = true;
+        }
+        
+        bool isOpen() const {
+            return open;
+        }
+        
+        // Returns false once the file is exhausted
+        bool next(T& record) {
+            if (!open) {
+                return false;
+            }
+            
+            if (snapshot) {
+                if (row >= rowCount) {
+                    return false;
+                }
+                record = service.decodeRecord(view, row++);
+                return true;
+            }
+            
+            std::string line;
+            while (std::getline(text, line)) {
+                if (!line.empty()) {
+                    record = service.deserializeObject(line);
+                    return true;
+                }
+            }
             return false;
         }
+    };
+    
+    // Single-pass input iterator over a RecordReader
+    class RecordIterator {
+    private:
+        RecordReader* reader;
+        T current;
         
-        for (const auto& object : objects) {
-            file << serializeObject(object) << std::endl;
+        void advance() {
+            if (reader && !reader->next(current)) {
+                reader = nullptr;
+            }
         }
         
-        file.close();
-        return true;
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const T* pointer;
+        typedef const T& reference;
+        
+        RecordIterator() : reader(nullptr), current() {}
+        explicit RecordIterator(RecordReader* reader) : reader(reader), current() { advance(); }
+        
+        const T& operator*() const { return current; }
+        const T* operator->() const { return &current; }
+        RecordIterator& operator++() { advance(); return *this; }
+        
+        bool operator==(const RecordIterator& other) const { return reader == other.reader; }
+        bool operator!=(const RecordIterator& other) const { return reader != other.reader; }
+    };
+    
+    // Range returned by records(); usable once with a range-based for loop
+    class RecordRange {
+    private:
+        std::shared_ptr<RecordReader> reader;
+        
+    public:
+        explicit RecordRange(const FileService<T>& service)
+            : reader(std::make_shared<RecordReader>(service)) {}
+        
+        RecordIterator begin() { return RecordIterator(reader.get()); }
+        RecordIterator end() { return RecordIterator(); }
+    };
+    
+    // Streams every record to visit() without materializing the file.
+    // Stops early if visit() returns false; returns the number visited.
+    size_t forEachRecord(const std::function<bool(const T&)>& visit) const {
+        RecordReader reader(*this);
+        T record;
+        size_t visited = 0;
+        
+        while (reader.next(record)) {
+            visited++;
+            if (!visit(record)) {
+                break;
+            }
+        }
+        return visited;
+    }
+    
+    RecordRange records() const {
+        return RecordRange(*this);
     }
     
+    // Loads either format; snapshots are recognised by their header
     std::vector<T> loadFromFile() const {
-        std::vector<T> objects;
-        std::ifstream file(filename);
-        
-        if (!file.is_open()) {
-            std::cerr << "Warning: Could not open file for reading: " << filename << std::endl;
-            return objects;
+        if (supportsSnapshot() && SnapshotView::isSnapshotFile(filename)) {
+            return loadFromSnapshot();
         }
         
-        std::string line;
-        while (std::getline(file, line)) {
-            if (!line.empty()) {
-                objects.push_back(deserializeObject(line));
+        if (parseThreads > 1) {
+            MappedFile file;
+            if (file.open(filename) && file.getSize() >= PARALLEL_PARSE_MIN_BYTES) {
+                return loadTextParallel(file, parseThreads);
             }
         }
         
-        file.close();
+        std::vector<T> objects;
+        forEachRecord([&objects](const T& object) {
+            objects.push_back(object);
+            return true;
+        });
         return objects;
     }
     
     bool appendToFile(const T& object) const {
+        if (SnapshotView::isSnapshotFile(filename)) {
+            std::cerr << "Error: Cannot append to snapshot file: " << filename << std::endl;
+            return false;
+        }
+        
         std::ofstream file(filename, std::ios::app);
         if (!file.is_open()) {
             std::cerr << "Error: Could not open file for appending: " << filename << std::endl;
@@ -112,6 +637,23 @@ public:
     void setFilename(const std::string& newFilename) {
         filename = newFilename;
     }
+    
+    StorageFormat getFormat() const {
+        return format;
+    }
+    
+    void setFormat(StorageFormat newFormat) {
+        format = newFormat;
+    }
+    
+    // Threads used to parse large text files; defaults to the core count
+    unsigned getParseThreads() const {
+        return parseThreads;
+    }
+    
+    void setParseThreads(unsigned threads) {
+        parseThreads = std::max(1u, threads);
+    }
 };
 
 // Example of specific implementation for a model type (would be in .cpp file)
@@ -130,25 +672,18 @@ private:
     }
     
     Client deserializeObject(const std::string& data) const override {
-        // Implementation of how to convert a string back to a Client
-        std::stringstream ss(data);
-        std::string token;
-        std::vector<std::string> tokens;
-        
-        while (std::getline(ss, token, '|')) {
-            tokens.push_back(token);
-        }
-        
-        // Validate we have enough tokens
-        if (tokens.size() < 4) {
-            throw std::runtime_error("Invalid client data format");
+        // Split into views over the line; nothing is copied until the
+        // values are handed to the model
+        FieldView fields[4];
+        if (FieldTokenizer(data).split(fields, 4) < 4) {
+            throw FileException("Invalid client data format");
         }
         
         Client client;
-        client.setClientId(std::stoi(tokens[0]));
-        client.setFirstName(tokens[1]);
-        client.setLastName(tokens[2]);
-        client.setEmail(tokens[3]);
+        client.setClientId(parseIntField(fields[0], "client ID"));
+        client.setFirstName(fields[1].str());
+        client.setLastName(fields[2].str());
+        client.setEmail(fields[3].str());
         // ... set other fields
         
         return client;
@@ -0,0 +1,156 @@
+// IndexedRepository.h
+#ifndef INDEXED_REPOSITORY_H
+#define INDEXED_REPOSITORY_H
+
+#include <vector>
+#include <memory>
+#include <functional>
+#include <unordered_map>
+#include <algorithm>
+#include <iterator>
+
+// Owns a set of records keyed by ID, with a hash index for constant-time
+// lookup. Records are kept in insertion order; removal leaves a null slot
+// that is compacted away once enough have accumulated, so removing is also
+// constant time (amortized) and iteration order is stable.
+template <typename T>
+class IndexedRepository {
+private:
+    std::vector<std::shared_ptr<T>> slots;     // Removed records are null
+    std::unordered_map<int, size_t> slotById;
+    size_t removed;
+    std::function<int(const T&)> idOf;
+    int maxId;
+
+    void compact() {
+        std::vector<std::shared_ptr<T>> live;
+        live.reserve(slots.size() - removed);
+        slotById.clear();
+        for (auto& record : slots) {
+            if (record) {
+                slotById[idOf(*record)] = live.size();
+                live.push_back(record);
+            }
+        }
+        slots.swap(live);
+        removed = 0;
+    }
+
+public:
+    // Iterates live records in insertion order
+    class const_iterator {
+    private:
+        const IndexedRepository* repository;
+        size_t position;
+
+        void skipRemoved() {
+            while (position < repository->slots.size() && !repository->slots[position]) {
+                position++;
+            }
+        }
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef std::shared_ptr<T> value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const std::shared_ptr<T>* pointer;
+        typedef const std::shared_ptr<T>& reference;
+
+        const_iterator(const IndexedRepository* repository, size_t position)
+            : repository(repository), position(position) {
+            skipRemoved();
+        }
+
+        reference operator*() const { return repository->slots[position]; }
+        pointer operator->() const { return &repository->slots[position]; }
+        const_iterator& operator++() { position++; skipRemoved(); return *this; }
+
+        bool operator==(const const_iterator& other) const { return position == other.position; }
+        bool operator!=(const const_iterator& other) const { return position != other.position; }
+    };
+
+    explicit IndexedRepository(std::function<int(const T&)> idOf)
+        : slots(), slotById(), removed(0), idOf(idOf), maxId(0) {}
+
+    // Lookup; returns null if there is no record with this ID
+    std::shared_ptr<T> get(int id) const {
+        auto it = slotById.find(id);
+        return it != slotById.end() ? slots[it->second] : nullptr;
+    }
+
+    bool contains(int id) const {
+        return slotById.count(id) > 0;
+    }
+
+    // Insert, or replace the record with this ID in place
+    void put(int id, std::shared_ptr<T> record) {
+        maxId = std::max(maxId, id);
+
+        auto it = slotById.find(id);
+        if (it != slotById.end()) {
+            slots[it->second] = record;
+            return;
+        }
+        slotById[id] = slots.size();
+        slots.push_back(record);
+    }
+
+    // Insert under the record's own ID
+    void put(std::shared_ptr<T> record) {
+        put(idOf(*record), record);
+    }
+
+    bool remove(int id) {
+        auto it = slotById.find(id);
+        if (it == slotById.end()) {
+            return false;
+        }
+        slots[it->second].reset();
+        slotById.erase(it);
+        removed++;
+
+        if (removed > 32 && removed * 2 > slots.size()) {
+            compact();
+        }
+        return true;
+    }
+
+    void clear() {
+        slots.clear();
+        slotById.clear();
+        removed = 0;
+        maxId = 0;
+    }
+
+    void reserve(size_t count) {
+        slots.reserve(count);
+        slotById.reserve(count);
+    }
+
+    size_t size() const {
+        return slots.size() - removed;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    // Highest ID ever stored, for allocating new IDs
+    int getMaxId() const {
+        return maxId;
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, slots.size()); }
+
+    std::vector<std::shared_ptr<T>> getAll() const {
+        std::vector<std::shared_ptr<T>> records;
+        records.reserve(size());
+        for (const auto& record : *this) {
+            records.push_back(record);
+        }
+        return records;
+    }
+};
+
+#endif // INDEXED_REPOSITORY_H
@@ -0,0 +1,75 @@
+// JournalCompactor.h
+#ifndef JOURNAL_COMPACTOR_H
+#define JOURNAL_COMPACTOR_H
+
+#include <string>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include "MutationJournal.h"
+
+// Statistics reported by a JournalCompactor
+struct CompactionStats {
+    size_t runs;                // Completed compactions
+    size_t failures;            // Compactions whose snapshot write failed
+    size_t recordsFolded;       // Journal records folded into snapshots
+    uint64_t bytesReclaimed;    // Journal bytes released
+    double lastDurationMs;      // Wall time of the most recent run
+    double totalDurationMs;
+    bool running;
+
+    CompactionStats()
+        : runs(0), failures(0), recordsFolded(0), bytesReclaimed(0),
+          lastDurationMs(0.0), totalDurationMs(0.0), running(false) {}
+};
+
+// Folds a mutation journal into a fresh snapshot once it passes a record
+// count or size threshold.
+//
+// The owning service calls maybeCompact() after appending. If a threshold
+// is exceeded, the journal is rotated on the caller's thread and the
+// snapshot writer (which must not see later changes to the data) runs on
+// a background thread, so the service never waits on snapshot I/O. The
+// snapshot itself is swapped in with write-temp-then-rename by FileService.
+class JournalCompactor {
+public:
+    typedef std::function<bool()> SnapshotWriter;
+
+private:
+    MutationJournal& journal;
+    size_t maxRecords;
+    uint64_t maxBytes;
+
+    std::thread worker;
+    std::atomic<bool> running;
+    mutable std::mutex statsMutex;
+    CompactionStats stats;
+
+    void run(SnapshotWriter writer, size_t records, uint64_t bytes);
+
+public:
+    JournalCompactor(MutationJournal& journal, size_t maxRecords = 10000,
+                     uint64_t maxBytes = 4 * 1024 * 1024);
+    ~JournalCompactor();
+
+    JournalCompactor(const JournalCompactor&) = delete;
+    JournalCompactor& operator=(const JournalCompactor&) = delete;
+
+    // True once the journal has outgrown either threshold
+    bool shouldCompact() const;
+
+    // Start a background compaction if one is due and none is running.
+    // makeWriter is only invoked when a compaction actually starts.
+    bool maybeCompact(const std::function<SnapshotWriter()>& makeWriter);
+
+    // Block until any running compaction has finished
+    void waitForCompletion();
+    bool isRunning() const;
+
+    void setThresholds(size_t maxRecords, uint64_t maxBytes);
+    CompactionStats getStats() const;
+};
+
+#endif // JOURNAL_COMPACTOR_H
@@ -0,0 +1,29 @@
+// LearningMaterialFileService.h
+#ifndef LEARNING_MATERIAL_FILE_SERVICE_H
+#define LEARNING_MATERIAL_FILE_SERVICE_H
+
+#include <string>
+#include "FileService.h"
+#include "../models/LearningMaterial.h"
+
+// Persists learning materials as pipe-delimited text or as a columnar snapshot.
+//
+// Text layout:
+//   id|title|description|type|format|author|created|modelId;...|tag;...|
+//   difficulty|url|localPath|minutes|rating|usageCount
+class LearningMaterialFileService : public FileService<LearningMaterial> {
+private:
+    std::string serializeObject(const LearningMaterial& material) const override;
+    LearningMaterial deserializeObject(const std::string& data) const override;
+    
+    bool supportsSnapshot() const override;
+    uint32_t getSnapshotSchemaVersion() const override;
+    void encodeRecord(const LearningMaterial& material, SnapshotBuilder& builder) const override;
+    LearningMaterial decodeRecord(const SnapshotView& view, size_t row) const override;
+    
+public:
+    LearningMaterialFileService(const std::string& filename = "data/materials.dat",
+                                StorageFormat format = StorageFormat::Snapshot);
+};
+
+#endif // LEARNING_MATERIAL_FILE_SERVICE_H
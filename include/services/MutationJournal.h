@@ -0,0 +1,105 @@
+// MutationJournal.h
+#ifndef MUTATION_JOURNAL_H
+#define MUTATION_JOURNAL_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+// When appended records are forced to stable storage
+enum class JournalSyncPolicy {
+    EveryWrite,   // fsync after each append
+    Interval,     // fsync from a background thread every intervalMs
+    Never         // leave it to the operating system
+};
+
+// A single typed mutation. The meaning of type and fields is defined by the
+// owning service; records should carry resulting values rather than deltas
+// so that replaying them twice is harmless.
+struct JournalRecord {
+    uint8_t type;
+    int id;
+    std::vector<std::string> fields;
+
+    JournalRecord() : type(0), id(0), fields() {}
+    JournalRecord(uint8_t type, int id, const std::vector<std::string>& fields = {})
+        : type(type), id(id), fields(fields) {}
+};
+
+// Append-only write-ahead log of service mutations, replayed on top of the
+// last snapshot at startup. Each record is framed with its length and a
+// checksum so a torn final write is detected and discarded on replay.
+class MutationJournal {
+private:
+    std::string filename;
+    int fd;
+    JournalSyncPolicy syncPolicy;
+    int syncIntervalMs;
+    size_t recordCount;
+    uint64_t sizeBytes;
+    bool unsyncedWrites;
+    uint64_t writeGeneration;   // Bumped by every write, so a background
+                                // fsync can tell whether it covered them
+
+    std::mutex journalMutex;
+    std::condition_variable syncSignal;
+    std::thread syncThread;
+    bool stopSync;
+
+    bool openForAppend();
+    bool writeFrames(const std::string& frames, size_t count);
+    size_t replayFile(const std::string& path, const std::function<void(const JournalRecord&)>& apply,
+                      size_t& validBytes, size_t& fileBytes);
+    void startSyncThread();
+    void stopSyncThread();
+    void syncLoop();
+    bool syncLocked();
+
+public:
+    // Constructor and Destructor
+    MutationJournal(const std::string& filename,
+                    JournalSyncPolicy policy = JournalSyncPolicy::Interval,
+                    int syncIntervalMs = 1000);
+    ~MutationJournal();
+
+    MutationJournal(const MutationJournal&) = delete;
+    MutationJournal& operator=(const MutationJournal&) = delete;
+
+    // Replay every intact record; returns the number applied
+    size_t replay(const std::function<void(const JournalRecord&)>& apply);
+
+    // Append one record, syncing according to the policy
+    bool append(const JournalRecord& record);
+    
+    // Group commit: append several records with a single write and sync
+    bool appendBatch(const std::vector<JournalRecord>& records);
+
+    // Force pending writes to disk
+    bool sync();
+
+    // Discard all records (after they have been folded into a snapshot)
+    bool truncate();
+    
+    // Compaction support. beginCompaction() moves the current records aside
+    // so new appends start a fresh file while the old ones are folded into a
+    // snapshot; finishCompaction() deletes them once the snapshot is in place.
+    // Records set aside are replayed first if the process stops in between.
+    bool beginCompaction(size_t& recordsMoved, uint64_t& bytesMoved);
+    void finishCompaction();
+    std::string getCompactingFilename() const;
+
+    // Sync policy
+    void setSyncPolicy(JournalSyncPolicy policy, int intervalMs = 1000);
+    JournalSyncPolicy getSyncPolicy() const;
+
+    // Statistics
+    std::string getFilename() const;
+    size_t getRecordCount() const;
+    uint64_t getSizeBytes() const;
+};
+
+#endif // MUTATION_JOURNAL_H
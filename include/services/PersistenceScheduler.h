@@ -0,0 +1,98 @@
+// PersistenceScheduler.h
+#ifndef PERSISTENCE_SCHEDULER_H
+#define PERSISTENCE_SCHEDULER_H
+
+#include <map>
+#include <set>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "MutationJournal.h"
+
+// Statistics reported by a PersistenceScheduler
+struct PersistenceStats {
+    size_t flushes;              // Group commits written to the journal
+    size_t recordsWritten;       // Records written by those commits
+    size_t mutationsCoalesced;   // Mutations absorbed by an already-dirty record
+
+    PersistenceStats() : flushes(0), recordsWritten(0), mutationsCoalesced(0) {}
+};
+
+// Dirty-set tracker with group commit for a service's journal.
+//
+// While tracking (deferred mode or inside a transaction) mutations only mark
+// a record ID dirty; repeated mutations of the same record coalesce into a
+// single upsert. flush() writes every pending record with one journal write.
+// In deferred mode a background timer also flushes every flushIntervalMs.
+//
+// Outside a transaction the upsert is built when the record is marked, so the
+// timer thread never touches service objects. Inside a transaction only IDs
+// are tracked and the records are built once, by commitTransaction(), on the
+// caller's thread.
+//
+// Batches are appended outside the lock, one at a time: a flush waits for
+// the one in progress, so batches reach the journal in the order they were
+// taken and replay never sees an older upsert after a newer one.
+class PersistenceScheduler {
+public:
+    typedef std::function<JournalRecord(int id)> RecordBuilder;
+
+private:
+    MutationJournal& journal;
+    RecordBuilder buildUpsert;
+    uint8_t removeType;
+
+    std::map<int, JournalRecord> pending;   // Ready to write, keyed by record ID
+    std::set<int> transactionDirty;         // IDs awaiting a record at commit
+    int transactionDepth;
+    bool deferred;
+    int flushIntervalMs;
+    PersistenceStats stats;
+
+    mutable std::mutex schedulerMutex;
+    bool flushInProgress;                   // A batch is being appended
+    std::condition_variable flushDone;
+    std::condition_variable timerSignal;
+    std::thread timerThread;
+    bool stopTimer;
+
+    void startTimer();
+    void stopTimerThread();
+    void timerLoop();
+    bool flushLocked(std::unique_lock<std::mutex>& lock);
+
+public:
+    PersistenceScheduler(MutationJournal& journal, RecordBuilder buildUpsert, uint8_t removeType);
+    ~PersistenceScheduler();
+
+    PersistenceScheduler(const PersistenceScheduler&) = delete;
+    PersistenceScheduler& operator=(const PersistenceScheduler&) = delete;
+
+    // Deferred mode; an interval of 0 disables the timer (flush() only)
+    void setDeferred(bool enabled, int flushIntervalMs = 1000);
+    bool isDeferred() const;
+
+    // True when mutations should be marked rather than journaled directly
+    bool isTracking() const;
+
+    // Dirty tracking
+    void markDirty(int id);
+    void markRemoved(int id);
+
+    // Write all pending records as one group commit
+    bool flush();
+
+    // Drop pending records that a full snapshot has made redundant
+    void discardPending();
+
+    // Transaction brackets; nested brackets commit with the outermost one
+    void beginTransaction();
+    bool commitTransaction();
+    bool inTransaction() const;
+
+    size_t getPendingCount() const;
+    PersistenceStats getStats() const;
+};
+
+#endif // PERSISTENCE_SCHEDULER_H
@@ -0,0 +1,26 @@
+// RecordSource.h
+#ifndef RECORD_SOURCE_H
+#define RECORD_SOURCE_H
+
+#include <cstddef>
+
+class SnapshotView;
+
+// Read-only, row-addressed view of a saved data file. Only the ID of each
+// row is known up front; records are decoded one at a time on request.
+// Sources are opened with FileService::openRecordSource().
+template <typename T>
+class RecordSource {
+public:
+    virtual ~RecordSource() = default;
+
+    virtual size_t getRecordCount() const = 0;
+    virtual int getRecordId(size_t row) const = 0;
+    virtual T decodeRecord(size_t row) const = 0;
+
+    // The mapped snapshot holding these rows, or null for other formats.
+    // Snapshot rows can be copied into a new snapshot without decoding.
+    virtual const SnapshotView* getSnapshot() const { return nullptr; }
+};
+
+#endif // RECORD_SOURCE_H
@@ -0,0 +1,485 @@
+// RecordStore.h
+#ifndef RECORD_STORE_H
+#define RECORD_STORE_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <exception>
+#include <algorithm>
+#include <cstdio>
+#include "RecordTable.h"
+#include "MutationJournal.h"
+#include "JournalCompactor.h"
+#include "PersistenceScheduler.h"
+#include "ShardLayout.h"
+#include "../utils/Logger.h"
+#include "../utils/FileSync.h"
+
+// A service's records together with their persistence, split into shards.
+//
+// Each shard owns a data file, a mutation journal with its compactor and
+// scheduler, and the RecordTable holding its records, so a mutation is only
+// ever written to the shard of the record it changes. Shards are loaded on
+// separate threads and saved independently.
+//
+// The layout of the files on disk is kept in a manifest next to them. When
+// the requested layout differs, load() reads the old layout, writes the
+// records into the new shard files, switches the manifest and then removes
+// the old files.
+//
+// Files is the concrete FileService for T, constructed from a file name.
+template <typename T, typename Files>
+class RecordStore {
+public:
+    typedef std::function<void(const JournalRecord&)> Applier;
+    typedef typename FileService<T>::StoredRecord StoredRecord;
+
+private:
+    struct Shard {
+        Files files;
+        MutationJournal journal;
+        JournalCompactor compactor;
+        PersistenceScheduler scheduler;
+        RecordTable<T> table;
+
+        Shard(const std::string& path, const std::function<int(const T&)>& idOf,
+              const PersistenceScheduler::RecordBuilder& buildUpsert, uint8_t removeType)
+            : files(path + ".dat"), journal(path + ".journal"), compactor(journal),
+              scheduler(journal, buildUpsert, removeType), table(idOf) {}
+    };
+
+    std::string basePath;
+    ShardLayout layout;          // Layout of the shards in use
+    ShardLayout targetLayout;    // Requested layout, adopted by load()
+    std::function<int(const T&)> idOf;
+    PersistenceScheduler::RecordBuilder buildUpsert;
+    uint8_t removeType;
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    std::string getManifestPath() const {
+        return basePath + ".shards";
+    }
+
+    Shard& shardOf(int id) const {
+        return *shards[layout.shardFor(id)];
+    }
+
+    void createShards() {
+        shards.clear();
+        for (size_t i = 0; i < layout.getShardCount(); i++) {
+            shards.push_back(std::unique_ptr<Shard>(
+                new Shard(layout.getShardPath(basePath, i), idOf, buildUpsert, removeType)));
+        }
+    }
+
+    bool filesExist() const {
+        for (const auto& shard : shards) {
+            if (shard->files.fileExists()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Runs task(i) for every shard, each on its own thread, and rethrows
+    // the first failure on the caller's thread
+    void forEachShardInParallel(const std::function<void(size_t)>& task) const {
+        std::vector<std::exception_ptr> errors(shards.size());
+        auto run = [&](size_t i) {
+            try {
+                task(i);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (size_t i = 1; i < shards.size(); i++) {
+            workers.emplace_back(run, i);
+        }
+        run(0);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        for (const auto& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+
+    // Map and index every shard file that exists
+    void attachShards() {
+        forEachShardInParallel([this](size_t i) {
+            Shard& shard = *shards[i];
+            if (!shard.files.fileExists()) {
+                return;
+            }
+            if (auto source = shard.files.openRecordSource()) {
+                shard.table.attach(source);
+            }
+        });
+    }
+
+    bool saveShard(Shard& shard) {
+        shard.compactor.waitForCompletion();
+
+        if (!shard.files.saveToFile(shard.table.getStoredRecords())) {
+            Logger::getInstance().error("Failed to save " + shard.files.getFilename());
+            return false;
+        }
+        shard.scheduler.discardPending();
+        shard.journal.truncate();
+        return true;
+    }
+
+    // Capture the shard's current state so the compactor can write it
+    // off-thread. Only pointers are taken here; records the service changes
+    // meanwhile are copied on write (see getForWrite), and records never
+    // materialized are read straight from the mapped source.
+    JournalCompactor::SnapshotWriter makeSnapshotWriter(Shard& shard) {
+        auto records = std::make_shared<std::vector<StoredRecord>>(shard.table.shareStoredRecords());
+
+        const Files& files = shard.files;
+        return [records, &files]() { return files.saveToFile(*records); };
+    }
+
+    // Rewrite the loaded records into targetLayout's files and switch to it
+    bool migrate() {
+        std::vector<std::vector<StoredRecord>> parts(targetLayout.getShardCount());
+        for (const auto& shard : shards) {
+            for (const auto& record : shard->table.getStoredRecords()) {
+                int id = record.object ? idOf(*record.object) : record.source->getRecordId(record.row);
+                parts[targetLayout.shardFor(id)].push_back(record);
+            }
+        }
+
+        for (size_t i = 0; i < parts.size(); i++) {
+            Files files(targetLayout.getShardPath(basePath, i) + ".dat");
+            if (!files.saveToFile(parts[i])) {
+                return false;
+            }
+        }
+        parts.clear();
+
+        // The manifest is the switch-over point; until it is written the old
+        // layout is still complete on disk, and old files are only removed
+        // once the switch is durable. A single shard has no manifest.
+        bool switched = false;
+        if (targetLayout.getShardCount() == 1) {
+            std::remove(getManifestPath().c_str());
+            switched = !std::ifstream(getManifestPath()).good() &&
+                       FileSync::syncParentDirectory(getManifestPath());
+        } else {
+            switched = targetLayout.writeManifest(getManifestPath());
+        }
+        if (!switched) {
+            return false;
+        }
+
+        std::vector<std::string> oldPaths;
+        for (size_t i = 0; i < layout.getShardCount(); i++) {
+            oldPaths.push_back(layout.getShardPath(basePath, i));
+        }
+        shards.clear();
+        for (const auto& path : oldPaths) {
+            std::remove((path + ".dat").c_str());
+            std::remove((path + ".journal").c_str());
+            std::remove((path + ".journal.compacting").c_str());
+        }
+
+        layout = targetLayout;
+        createShards();
+        attachShards();
+        return true;
+    }
+
+public:
+    // Iterates every shard's records, shard by shard
+    class const_iterator {
+    private:
+        const RecordStore* store;
+        size_t shard;
+        typename RecordTable<T>::const_iterator position;
+
+        void settle() {
+            while (shard < store->shards.size() && position == store->shards[shard]->table.end()) {
+                shard++;
+                if (shard < store->shards.size()) {
+                    position = store->shards[shard]->table.begin();
+                }
+            }
+        }
+
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef std::shared_ptr<T> value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const std::shared_ptr<T>* pointer;
+        typedef const std::shared_ptr<T>& reference;
+
+        const_iterator(const RecordStore* store, size_t shard, typename RecordTable<T>::const_iterator position)
+            : store(store), shard(shard), position(position) {
+            settle();
+        }
+
+        reference operator*() const { return *position; }
+        pointer operator->() const { return &*position; }
+        const_iterator& operator++() { ++position; settle(); return *this; }
+
+        bool operator==(const const_iterator& other) const {
+            return shard == other.shard && (shard == store->shards.size() || position == other.position);
+        }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+    };
+
+    // basePath names the files without extension, e.g. "data/clients"
+    RecordStore(const std::string& basePath, const ShardLayout& requested,
+                std::function<int(const T&)> idOf, PersistenceScheduler::RecordBuilder buildUpsert,
+                uint8_t removeType)
+        : basePath(basePath), layout(), targetLayout(requested), idOf(idOf),
+          buildUpsert(buildUpsert), removeType(removeType), shards() {
+        ShardLayout::readManifest(getManifestPath(), layout);
+        createShards();
+
+        // Nothing to carry over: start directly in the requested layout
+        if (layout != targetLayout && !filesExist()) {
+            layout = targetLayout;
+            createShards();
+        }
+    }
+
+    RecordStore(const RecordStore&) = delete;
+    RecordStore& operator=(const RecordStore&) = delete;
+
+    // True if any shard has a data file
+    bool exists() const {
+        return filesExist();
+    }
+
+    // Attach the shard files (in parallel), replay their journals through
+    // apply() and move to the requested layout if needed. Returns the
+    // number of journal records replayed.
+    size_t load(const Applier& apply) {
+        attachShards();
+
+        size_t replayed = 0;
+        for (const auto& shard : shards) {
+            replayed += shard->journal.replay(apply);
+        }
+
+        if (layout != targetLayout) {
+            std::string from = layout.describe();
+            if (migrate()) {
+                Logger::getInstance().info("Resharded " + basePath + " from " + from + " to " +
+                                           layout.describe());
+            } else {
+                Logger::getInstance().error("Failed to reshard " + basePath + "; keeping " +
+                                            layout.describe());
+            }
+        }
+        return replayed;
+    }
+
+    // Write every shard's data file (each on its own thread) and reset the
+    // journals; returns false if any shard failed
+    bool save() {
+        if (layout.getShardCount() > 1 && !layout.writeManifest(getManifestPath())) {
+            Logger::getInstance().error("Failed to write shard manifest " + getManifestPath());
+            return false;
+        }
+
+        std::vector<char> saved(shards.size(), 0);
+        forEachShardInParallel([this, &saved](size_t i) {
+            saved[i] = saveShard(*shards[i]);
+        });
+        return std::find(saved.begin(), saved.end(), 0) == saved.end();
+    }
+
+    // Persist one mutation in its record's shard: journaled directly, or
+    // marked for the next group commit while the scheduler is tracking
+    void recordMutation(uint8_t type, int id, const std::vector<std::string>& fields) {
+        Shard& shard = shardOf(id);
+        if (type != removeType) {
+            shard.table.markDirty(id);
+        }
+
+        if (shard.scheduler.isTracking()) {
+            // Coalesce into one upsert per record, written at the next flush
+            if (type == removeType) {
+                shard.scheduler.markRemoved(id);
+            } else {
+                shard.scheduler.markDirty(id);
+            }
+        } else if (!shard.journal.append(JournalRecord(type, id, fields))) {
+            // Fall back to a full save of this shard so the change is not lost
+            saveShard(shard);
+            return;
+        }
+
+        shard.compactor.maybeCompact([this, &shard]() { return makeSnapshotWriter(shard); });
+    }
+
+    // Records
+    std::shared_ptr<T> get(int id) const { return shardOf(id).table.get(id); }
+    bool contains(int id) const { return shardOf(id).table.contains(id); }
+
+    // Lookup for changing a record in place; a compaction in progress keeps
+    // writing the record as it was
+    std::shared_ptr<T> getForWrite(int id) {
+        Shard& shard = shardOf(id);
+        return shard.table.getForWrite(id, shard.compactor.isRunning());
+    }
+    void put(int id, std::shared_ptr<T> record) { shardOf(id).table.put(id, record); }
+    bool remove(int id) { return shardOf(id).table.remove(id); }
+    void markDirty(int id) { shardOf(id).table.markDirty(id); }
+
+    size_t size() const {
+        size_t total = 0;
+        for (const auto& shard : shards) {
+            total += shard->table.size();
+        }
+        return total;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    int getMaxId() const {
+        int maxId = 0;
+        for (const auto& shard : shards) {
+            maxId = std::max(maxId, shard->table.getMaxId());
+        }
+        return maxId;
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0, shards.front()->table.begin()); }
+    const_iterator end() const { return const_iterator(this, shards.size(), shards.back()->table.end()); }
+
+    std::vector<std::shared_ptr<T>> getAll() const {
+        std::vector<std::shared_ptr<T>> records;
+        records.reserve(size());
+        for (const auto& shard : shards) {
+            for (const auto& record : shard->table) {
+                records.push_back(record);
+            }
+        }
+        return records;
+    }
+
+    // Single-record text encoding, shared by all shards
+    const Files& getFiles() const {
+        return shards.front()->files;
+    }
+
+    const ShardLayout& getLayout() const {
+        return layout;
+    }
+
+    // Persistence settings, applied to every shard
+    void setJournalSyncPolicy(JournalSyncPolicy policy, int intervalMs) {
+        for (const auto& shard : shards) {
+            shard->journal.setSyncPolicy(policy, intervalMs);
+        }
+    }
+
+    void setCompactionThresholds(size_t maxRecords, uint64_t maxBytes) {
+        for (const auto& shard : shards) {
+            shard->compactor.setThresholds(maxRecords, maxBytes);
+        }
+    }
+
+    void setDeferred(bool enabled, int flushIntervalMs) {
+        for (const auto& shard : shards) {
+            shard->scheduler.setDeferred(enabled, flushIntervalMs);
+        }
+    }
+
+    // Each shard writes its own group commit
+    bool flush() {
+        bool flushed = true;
+        for (const auto& shard : shards) {
+            flushed = shard->scheduler.flush() && flushed;
+        }
+        return flushed;
+    }
+
+    void beginTransaction() {
+        for (const auto& shard : shards) {
+            shard->scheduler.beginTransaction();
+        }
+    }
+
+    // Shards commit one after another, so a crash part-way through can leave
+    // a transaction applied in some shards only
+    bool commitTransaction() {
+        bool committed = true;
+        for (const auto& shard : shards) {
+            committed = shard->scheduler.commitTransaction() && committed;
+        }
+        return committed;
+    }
+
+    // A limit is split evenly between the shards
+    void setResidentLimit(size_t limit) {
+        size_t perShard = limit == 0 ? 0 : std::max<size_t>(1, limit / shards.size());
+        for (const auto& shard : shards) {
+            shard->table.setResidentLimit(perShard);
+        }
+    }
+
+    // Statistics summed over the shards
+    CompactionStats getCompactionStats() const {
+        CompactionStats total;
+        for (const auto& shard : shards) {
+            CompactionStats stats = shard->compactor.getStats();
+            total.runs += stats.runs;
+            total.failures += stats.failures;
+            total.recordsFolded += stats.recordsFolded;
+            total.bytesReclaimed += stats.bytesReclaimed;
+            total.lastDurationMs = std::max(total.lastDurationMs, stats.lastDurationMs);
+            total.totalDurationMs += stats.totalDurationMs;
+            total.running = total.running || stats.running;
+        }
+        return total;
+    }
+
+    PersistenceStats getPersistenceStats() const {
+        PersistenceStats total;
+        for (const auto& shard : shards) {
+            PersistenceStats stats = shard->scheduler.getStats();
+            total.flushes += stats.flushes;
+            total.recordsWritten += stats.recordsWritten;
+            total.mutationsCoalesced += stats.mutationsCoalesced;
+        }
+        return total;
+    }
+
+    RecordCacheStats getCacheStats() const {
+        RecordCacheStats total = RecordCacheStats();
+        for (const auto& shard : shards) {
+            RecordCacheStats stats = shard->table.getCacheStats();
+            total.hits += stats.hits;
+            total.misses += stats.misses;
+            total.evictions += stats.evictions;
+            total.resident += stats.resident;
+            total.residentLimit += stats.residentLimit;
+        }
+        return total;
+    }
+
+    std::vector<size_t> getShardSizes() const {
+        std::vector<size_t> sizes;
+        for (const auto& shard : shards) {
+            sizes.push_back(shard->table.size());
+        }
+        return sizes;
+    }
+};
+
+#endif // RECORD_STORE_H
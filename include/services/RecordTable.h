@@ -0,0 +1,499 @@
+// RecordTable.h
+#ifndef RECORD_TABLE_H
+#define RECORD_TABLE_H
+
+#include <vector>
+#include <list>
+#include <memory>
+#include <functional>
+#include <unordered_map>
+#include <algorithm>
+#include <iterator>
+#include <cstdint>
+#include "FileService.h"
+#include "IndexedRepository.h"
+
+// Residency counters for the rows of an attached record source
+struct RecordCacheStats {
+    size_t hits;          // Lookups served by an object already in memory
+    size_t misses;        // Rows decoded from the source
+    size_t evictions;     // Clean rows dropped to stay within the limit
+    size_t resident;      // Source rows currently held as objects
+    size_t residentLimit; // 0 when unbounded
+};
+
+// In-memory collection of a service's records, keyed by ID.
+//
+// A table can be attached to a record source (a mapped snapshot or an
+// indexed text file): its rows then serve as the records without being
+// decoded at startup. A row is materialized into an object the first time
+// it is accessed, and from then on the object is the record; the source is
+// never written. Records added later live in an overlay after the source
+// rows. Iteration visits source rows in file order followed by the overlay
+// in insertion order.
+//
+// Lookups take constant time: overlay records are hash-indexed, and source
+// rows are found through a dense ID-to-row array when the IDs are compact
+// (as auto-assigned IDs are), or through a hash index when they are not.
+//
+// With a resident limit, materialized rows are kept in LRU order and the
+// least recently used are dropped again once the limit is exceeded. Only
+// clean rows that nobody else holds are dropped: rows that were replaced
+// or marked dirty differ from the source and stay until the table is
+// reattached. The limit is soft, as rows in use cannot be dropped.
+//
+// A snapshot taken for a background writer shares the table's objects
+// rather than copying them. While such a snapshot may still be reading,
+// getForWrite() replaces a record with a private copy the first time it is
+// changed after the snapshot, so only records actually mutated are copied.
+template <typename T>
+class RecordTable {
+public:
+    typedef RecordSource<T> Source;
+    typedef typename FileService<T>::StoredRecord StoredRecord;
+
+private:
+    // Source rows
+    std::shared_ptr<const Source> base;
+    size_t baseRows;
+    size_t baseRemoved;
+    mutable std::vector<std::shared_ptr<T>> rowObjects;   // Allocated on first materialization
+    std::vector<bool> rowRemoved;
+    std::vector<bool> rowDirty;                           // Allocated on first markDirty
+    std::vector<uint32_t> denseRows;                      // Row + 1 by ID - denseBase; 0 = none
+    int denseBase;
+    std::unordered_map<int, size_t> rowById;              // Only for sparse IDs
+    mutable size_t materialized;
+
+    // Clean materialized rows, most recently used first; only kept with a limit
+    size_t residentLimit;
+    mutable std::list<size_t> lru;
+    mutable std::unordered_map<size_t, std::list<size_t>::iterator> lruPosition;
+    mutable size_t hits;
+    mutable size_t misses;
+    mutable size_t evictions;
+
+    // Records not in the source
+    IndexedRepository<T> added;
+    int maxId;
+
+    // Copy-on-write against the last shared snapshot
+    uint64_t snapshotEpoch;                               // Bumped per snapshot
+    std::unordered_map<int, uint64_t> detachedEpoch;      // Epoch a record was last copied in
+
+    static const size_t NOT_FOUND = static_cast<size_t>(-1);
+
+    // Rows examined per eviction pass, so a table whose rows are all in use
+    // does not rescan the whole list on every materialization
+    static const size_t MAX_EVICTION_PROBES = 16;
+
+    // Row holding id, or NOT_FOUND; removed rows are not found
+    size_t findRow(int id) const {
+        if (!base) {
+            return NOT_FOUND;
+        }
+
+        size_t row = NOT_FOUND;
+        if (!denseRows.empty()) {
+            if (id >= denseBase && static_cast<size_t>(id - denseBase) < denseRows.size()) {
+                // An empty slot (0) wraps to NOT_FOUND
+                row = static_cast<size_t>(denseRows[id - denseBase]) - 1;
+            }
+        } else {
+            auto it = rowById.find(id);
+            if (it != rowById.end()) {
+                row = it->second;
+            }
+        }
+
+        if (row != NOT_FOUND && rowRemoved[row]) {
+            return NOT_FOUND;
+        }
+        return row;
+    }
+
+    bool isDirty(size_t row) const {
+        return !rowDirty.empty() && rowDirty[row];
+    }
+
+    const std::shared_ptr<T>& materialize(size_t row) const {
+        if (rowObjects.empty()) {
+            rowObjects.resize(baseRows);
+        }
+
+        std::shared_ptr<T>& object = rowObjects[row];
+        if (object) {
+            hits++;
+            touch(row);
+            return object;
+        }
+
+        misses++;
+        object = std::make_shared<T>(base->decodeRecord(row));
+        materialized++;
+        if (residentLimit > 0 && !isDirty(row)) {
+            // Make room before listing the new row, so it cannot be dropped
+            // before the caller receives it
+            evict();
+            lru.push_front(row);
+            lruPosition[row] = lru.begin();
+        }
+        return object;
+    }
+
+    void touch(size_t row) const {
+        auto it = lruPosition.find(row);
+        if (it != lruPosition.end()) {
+            lru.splice(lru.begin(), lru, it->second);
+        }
+    }
+
+    void forget(size_t row) const {
+        auto it = lruPosition.find(row);
+        if (it != lruPosition.end()) {
+            lru.erase(it->second);
+            lruPosition.erase(it);
+        }
+    }
+
+    void markRowDirty(size_t row) {
+        if (rowDirty.empty()) {
+            rowDirty.assign(baseRows, false);
+        }
+        rowDirty[row] = true;
+        forget(row);
+    }
+
+    // Drops least recently used rows until within the limit
+    void evict() const {
+        size_t probes = 0;
+        while (materialized > residentLimit && !lru.empty() && probes < MAX_EVICTION_PROBES) {
+            probes++;
+            size_t row = lru.back();
+            if (rowObjects[row].use_count() > 1) {
+                // Still referenced outside the table; revisit it later
+                lru.splice(lru.begin(), lru, std::prev(lru.end()));
+                continue;
+            }
+            lru.pop_back();
+            lruPosition.erase(row);
+            rowObjects[row].reset();
+            materialized--;
+            evictions++;
+        }
+    }
+
+public:
+    // Iterates live records, materializing source rows as they are reached.
+    // The current record is held by the iterator, so it cannot be evicted
+    // while the iterator points at it.
+    class const_iterator {
+    private:
+        const RecordTable* table;
+        size_t row;   // Source row; baseRows once in the overlay
+        typename IndexedRepository<T>::const_iterator overlay;
+        std::shared_ptr<T> current;
+
+        void settle() {
+            while (row < table->baseRows && table->rowRemoved[row]) {
+                row++;
+            }
+            if (row < table->baseRows) {
+                current = table->materialize(row);
+            } else if (overlay != table->added.end()) {
+                current = *overlay;
+            } else {
+                current.reset();
+            }
+        }
+
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef std::shared_ptr<T> value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const std::shared_ptr<T>* pointer;
+        typedef const std::shared_ptr<T>& reference;
+
+        const_iterator(const RecordTable* table, size_t row,
+                       typename IndexedRepository<T>::const_iterator overlay)
+            : table(table), row(row), overlay(overlay), current() {
+            settle();
+        }
+
+        reference operator*() const { return current; }
+        pointer operator->() const { return &current; }
+
+        const_iterator& operator++() {
+            if (row < table->baseRows) {
+                row++;
+            } else {
+                ++overlay;
+            }
+            settle();
+            return *this;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return row == other.row && overlay == other.overlay;
+        }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+    };
+
+    explicit RecordTable(std::function<int(const T&)> idOf)
+        : base(), baseRows(0), baseRemoved(0), rowObjects(), rowRemoved(), rowDirty(),
+          denseRows(), denseBase(0), rowById(), materialized(0), residentLimit(0),
+          lru(), lruPosition(), hits(0), misses(0), evictions(0), added(idOf), maxId(0),
+          snapshotEpoch(0), detachedEpoch() {}
+
+    // Use the rows of a record source as the table's records. Only the IDs
+    // are read; rows are decoded when first accessed.
+    void attach(std::shared_ptr<const Source> source) {
+        clear();
+        base = source;
+        baseRows = source->getRecordCount();
+        rowRemoved.assign(baseRows, false);
+
+        int minId = 0;
+        for (size_t row = 0; row < baseRows; row++) {
+            int id = source->getRecordId(row);
+            minId = row == 0 ? id : std::min(minId, id);
+            maxId = row == 0 ? id : std::max(maxId, id);
+        }
+        if (baseRows == 0) {
+            return;
+        }
+
+        // Compact IDs: direct array from ID to row
+        uint64_t span = static_cast<uint64_t>(static_cast<int64_t>(maxId) - minId) + 1;
+        if (span <= 2 * static_cast<uint64_t>(baseRows) + 64) {
+            denseBase = minId;
+            denseRows.assign(static_cast<size_t>(span), 0);
+            for (size_t row = 0; row < baseRows; row++) {
+                denseRows[source->getRecordId(row) - minId] = static_cast<uint32_t>(row + 1);
+            }
+            return;
+        }
+
+        rowById.reserve(baseRows);
+        for (size_t row = 0; row < baseRows; row++) {
+            rowById[source->getRecordId(row)] = row;
+        }
+    }
+
+    void clear() {
+        base.reset();
+        baseRows = 0;
+        baseRemoved = 0;
+        rowObjects.clear();
+        rowRemoved.clear();
+        rowDirty.clear();
+        denseRows.clear();
+        denseBase = 0;
+        rowById.clear();
+        materialized = 0;
+        lru.clear();
+        lruPosition.clear();
+        added.clear();
+        maxId = 0;
+        detachedEpoch.clear();
+    }
+
+    // Lookup; returns null if there is no record with this ID
+    std::shared_ptr<T> get(int id) const {
+        size_t row = findRow(id);
+        if (row != NOT_FOUND) {
+            return materialize(row);
+        }
+
+        std::shared_ptr<T> record = added.get(id);
+        if (record) {
+            hits++;
+        }
+        return record;
+    }
+
+    // Lookup for a caller about to change the record in place. With
+    // snapshotShared the last snapshot may still be reading, so a record not
+    // yet copied since it was taken is replaced by a copy first; the
+    // snapshot keeps the original.
+    std::shared_ptr<T> getForWrite(int id, bool snapshotShared) {
+        std::shared_ptr<T> record = get(id);
+        if (!record || !snapshotShared) {
+            return record;
+        }
+
+        auto epoch = detachedEpoch.find(id);
+        if (epoch != detachedEpoch.end() && epoch->second == snapshotEpoch) {
+            return record;
+        }
+
+        record = std::make_shared<T>(*record);
+        size_t row = findRow(id);
+        if (row != NOT_FOUND) {
+            rowObjects[row] = record;
+            markRowDirty(row);
+        } else {
+            added.put(id, record);
+        }
+        detachedEpoch[id] = snapshotEpoch;
+        return record;
+    }
+
+    bool contains(int id) const {
+        return findRow(id) != NOT_FOUND || added.contains(id);
+    }
+
+    // Insert or replace the record with this ID
+    void put(int id, std::shared_ptr<T> record) {
+        maxId = std::max(maxId, id);
+
+        size_t row = findRow(id);
+        if (row != NOT_FOUND) {
+            if (rowObjects.empty()) {
+                rowObjects.resize(baseRows);
+            }
+            if (!rowObjects[row]) {
+                materialized++;
+            }
+            rowObjects[row] = record;
+            markRowDirty(row);
+            return;
+        }
+
+        added.put(id, record);
+    }
+
+    // Pin a record whose object was changed in place, so it is not dropped
+    // and re-read from the source
+    void markDirty(int id) {
+        size_t row = findRow(id);
+        if (row != NOT_FOUND && !rowObjects.empty() && rowObjects[row]) {
+            markRowDirty(row);
+        }
+    }
+
+    bool remove(int id) {
+        size_t row = findRow(id);
+        if (row != NOT_FOUND) {
+            rowRemoved[row] = true;
+            baseRemoved++;
+            if (!rowObjects.empty() && rowObjects[row]) {
+                forget(row);
+                rowObjects[row].reset();
+                materialized--;
+            }
+            return true;
+        }
+
+        return added.remove(id);
+    }
+
+    // Bound the number of source rows held as objects; 0 removes the bound.
+    // Rows already in memory are tracked from now on, oldest first.
+    void setResidentLimit(size_t limit) {
+        residentLimit = limit;
+        lru.clear();
+        lruPosition.clear();
+        if (limit == 0) {
+            return;
+        }
+
+        for (size_t row = 0; row < rowObjects.size(); row++) {
+            if (rowObjects[row] && !isDirty(row)) {
+                lru.push_front(row);
+                lruPosition[row] = lru.begin();
+            }
+        }
+        while (materialized > residentLimit && !lru.empty()) {
+            size_t before = materialized;
+            evict();
+            if (materialized == before) {
+                break;
+            }
+        }
+    }
+
+    size_t getResidentLimit() const {
+        return residentLimit;
+    }
+
+    size_t size() const {
+        return baseRows - baseRemoved + added.size();
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    // Highest ID ever stored, for allocating new IDs
+    int getMaxId() const {
+        return maxId;
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0, added.begin()); }
+    const_iterator end() const { return const_iterator(this, baseRows, added.end()); }
+
+    // Every record as an object (materializes all source rows)
+    std::vector<std::shared_ptr<T>> getAll() const {
+        std::vector<std::shared_ptr<T>> records;
+        records.reserve(size());
+        for (const auto& record : *this) {
+            records.push_back(record);
+        }
+        return records;
+    }
+
+    // Records to save, in iteration order. Unmaterialized rows are passed as
+    // references into the source; objects are shared with the table.
+    std::vector<StoredRecord> getStoredRecords() const {
+        std::vector<StoredRecord> records;
+        records.reserve(size());
+
+        for (size_t row = 0; row < baseRows; row++) {
+            if (rowRemoved[row]) {
+                continue;
+            }
+            StoredRecord record;
+            record.row = row;
+            if (!rowObjects.empty() && rowObjects[row]) {
+                record.object = rowObjects[row];
+            } else {
+                record.source = base;
+            }
+            records.push_back(record);
+        }
+
+        for (const auto& object : added) {
+            StoredRecord record;
+            record.row = 0;
+            record.object = object;
+            records.push_back(record);
+        }
+        return records;
+    }
+
+    // getStoredRecords() for a writer that runs while the table changes.
+    // Starts a new copy-on-write epoch: until the writer is done, callers
+    // must change records only through getForWrite().
+    std::vector<StoredRecord> shareStoredRecords() {
+        snapshotEpoch++;
+        detachedEpoch.clear();
+        return getStoredRecords();
+    }
+
+    // Statistics
+    size_t getSourceRowCount() const { return baseRows - baseRemoved; }
+    size_t getMaterializedCount() const { return materialized + added.size(); }
+
+    RecordCacheStats getCacheStats() const {
+        RecordCacheStats stats;
+        stats.hits = hits;
+        stats.misses = misses;
+        stats.evictions = evictions;
+        stats.resident = materialized;
+        stats.residentLimit = residentLimit;
+        return stats;
+    }
+};
+
+#endif // RECORD_TABLE_H
@@ -7,19 +7,28 @@
 #include <memory>
 #include <map>
 #include "../models/TutoringSession.h"
+#include "TutorSchedule.h"
 
 class SessionService {
 private:
     std::vector<std::shared_ptr<TutoringSession>> sessions;
     int nextSessionId;
     
+    // Booked time of every scheduled session by tutor. Sessions are booked
+    // when scheduled, rebooked when moved and released when cancelled, so
+    // availability checks never scan the session list.
+    TutorSchedule tutorSchedule;
+    
     // Private helper methods
     void loadSessions();  // Load sessions from file
     void saveSessions();  // Save sessions to file
     bool isValidDate(const std::string& date) const;
     bool isValidTime(const std::string& time) const;
+    // A session being moved passes its own ID so it does not conflict
+    // with itself
     bool isTutorAvailable(int tutorId, const std::string& date, 
-                        const std::string& startTime, int durationMinutes) const;
+                        const std::string& startTime, int durationMinutes,
+                        int ignoreSessionId = -1) const;
     
 public:
     // Constructor and Destructor
@@ -44,6 +53,13 @@ public:
     std::vector<std::shared_ptr<TutoringSession>> getUpcomingSessions() const;
     std::vector<std::shared_ptr<TutoringSession>> getCompletedSessions() const;
     
+    // Scheduled sessions of the tutor overlapping [from, to), earliest first
+    std::vector<std::shared_ptr<TutoringSession>> getTutorConflicts(int tutorId,
+                                                                    const std::string& fromDate,
+                                                                    const std::string& fromTime,
+                                                                    const std::string& toDate,
+                                                                    const std::string& toTime) const;
+    
     // Session content management
     bool addSessionTopic(int sessionId, const std::string& topic);
     bool setSessionObjectives(int sessionId, const std::string& objectives);
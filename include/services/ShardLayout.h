@@ -0,0 +1,53 @@
+// ShardLayout.h
+#ifndef SHARD_LAYOUT_H
+#define SHARD_LAYOUT_H
+
+#include <string>
+#include <cstddef>
+
+// How record IDs are assigned to shards
+enum class ShardStrategy {
+    Hash,   // Hashed ID modulo the shard count
+    Range   // Consecutive blocks of rangeSize IDs; the last shard takes the rest
+};
+
+// Partitioning of one entity type's records into data files. Every shard
+// has its own data file and journal. A single shard keeps the unsharded
+// file names, so existing data directories load unchanged.
+class ShardLayout {
+private:
+    size_t shardCount;
+    ShardStrategy strategy;
+    int rangeSize;
+
+public:
+    // Constructors
+    ShardLayout();
+    ShardLayout(size_t shardCount, ShardStrategy strategy = ShardStrategy::Hash,
+                int rangeSize = 100000);
+
+    // Getters
+    size_t getShardCount() const;
+    ShardStrategy getStrategy() const;
+    int getRangeSize() const;
+
+    // Shard holding a record ID
+    size_t shardFor(int id) const;
+
+    // Path of one shard's files without extension, e.g. "data/clients.h4-2"
+    std::string getShardPath(const std::string& basePath, size_t shard) const;
+
+    // Human-readable form for logs, e.g. "4 shards by ID hash"
+    std::string describe() const;
+
+    // Manifest recording the layout of the files on disk. A missing
+    // manifest means a single shard.
+    static bool readManifest(const std::string& path, ShardLayout& layout);
+    bool writeManifest(const std::string& path) const;
+
+    // Operator overloading
+    bool operator==(const ShardLayout& other) const;
+    bool operator!=(const ShardLayout& other) const;
+};
+
+#endif // SHARD_LAYOUT_H
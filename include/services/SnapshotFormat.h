@@ -0,0 +1,139 @@
+// SnapshotFormat.h
+#ifndef SNAPSHOT_FORMAT_H
+#define SNAPSHOT_FORMAT_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "../utils/MappedFile.h"
+
+// Versioned binary columnar snapshot used by FileService<T>.
+//
+// Layout (all sections 8-byte aligned, native byte order):
+//   SnapshotHeader
+//   SnapshotColumnEntry[columnCount]
+//   column data    - one fixed-width slot per record for each column
+//   list items     - item arrays for list columns
+//   string heap    - raw bytes referenced by {offset, length} pairs
+//
+// Numeric fields are stored as fixed-width values and text as references
+// into the string heap, so a mapped snapshot can be read without parsing.
+
+enum class SnapshotColumnType : uint32_t {
+    Int = 1,        // int64 per record
+    Double = 2,     // double per record
+    String = 3,     // {offset, length} into the heap per record
+    IntList = 4,    // {first, count} per record into an int64 item array
+    StringList = 5  // {first, count} per record into a string reference array
+};
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t formatVersion;
+    uint32_t byteOrderMark;
+    uint32_t schemaVersion;
+    uint32_t columnCount;
+    uint64_t recordCount;
+    uint64_t heapOffset;
+    uint64_t heapSize;
+    uint64_t reserved;
+};
+
+struct SnapshotColumnEntry {
+    uint32_t type;
+    uint32_t reserved;
+    uint64_t dataOffset;
+    uint64_t itemsOffset;
+    uint64_t itemCount;
+};
+
+class SnapshotView;
+
+// Collects records column by column and writes them as a snapshot file.
+// Every record must put the same sequence of column types.
+class SnapshotBuilder {
+private:
+    struct Column {
+        SnapshotColumnType type;
+        std::vector<int64_t> ints;        // Int values or IntList items
+        std::vector<double> doubles;
+        std::vector<uint32_t> refs;       // String refs or StringList item refs
+        std::vector<uint32_t> ranges;     // {first, count} for list columns
+
+        explicit Column(SnapshotColumnType type) : type(type) {}
+    };
+
+    std::vector<Column> columns;
+    std::string heap;
+    size_t recordCount;
+    size_t cursor;
+
+    Column& nextColumn(SnapshotColumnType type);
+    void appendString(std::vector<uint32_t>& refs, const char* data, size_t length);
+    void finishRecord() const;
+
+public:
+    SnapshotBuilder();
+
+    void beginRecord();
+    void putInt(int64_t value);
+    void putDouble(double value);
+    void putString(const std::string& value);
+    void putString(const char* data, size_t length);
+    void putIntList(const std::vector<int>& values);
+    void putStringList(const std::vector<std::string>& values);
+    
+    // Append row `row` of `view` unchanged; its columns must match the schema
+    void copyRecord(const SnapshotView& view, size_t row);
+
+    size_t getRecordCount() const;
+    bool writeTo(const std::string& filename, uint32_t schemaVersion) const;
+};
+
+// Read-only, zero-parse access to a mapped snapshot file.
+class SnapshotView {
+private:
+    MappedFile file;
+    const SnapshotHeader* header;
+    std::vector<SnapshotColumnEntry> columns;
+
+    const SnapshotColumnEntry& column(size_t index, SnapshotColumnType type) const;
+    const uint32_t* slot(const SnapshotColumnEntry& entry, size_t row) const;
+
+public:
+    static const char MAGIC[8];
+    static const uint32_t FORMAT_VERSION = 1;
+
+    SnapshotView();
+    explicit SnapshotView(const std::string& filename);
+
+    // Map and validate a snapshot, including every string and list
+    // reference; throws FileException if it is malformed
+    bool open(const std::string& filename);
+    bool isOpen() const;
+
+    // True if the file starts with the snapshot magic
+    static bool isSnapshotFile(const std::string& filename);
+
+    size_t getRecordCount() const;
+    size_t getColumnCount() const;
+    SnapshotColumnType getColumnType(size_t column) const;
+    uint32_t getSchemaVersion() const;
+
+    // Field accessors
+    int64_t getInt(size_t column, size_t row) const;
+    double getDouble(size_t column, size_t row) const;
+    std::string getString(size_t column, size_t row) const;
+    const char* getStringData(size_t column, size_t row, size_t& length) const;
+    std::vector<int> getIntList(size_t column, size_t row) const;
+    std::vector<std::string> getStringList(size_t column, size_t row) const;
+    
+    // Element access for list columns without building a temporary vector
+    size_t getListSize(size_t column, size_t row) const;
+    int64_t getIntListItem(size_t column, size_t row, size_t item) const;
+    std::string getStringListItem(size_t column, size_t row, size_t item) const;
+    const char* getStringListItemData(size_t column, size_t row, size_t item, size_t& length) const;
+};
+
+#endif // SNAPSHOT_FORMAT_H
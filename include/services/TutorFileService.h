@@ -0,0 +1,30 @@
+// TutorFileService.h
+#ifndef TUTOR_FILE_SERVICE_H
+#define TUTOR_FILE_SERVICE_H
+
+#include <string>
+#include "FileService.h"
+#include "../models/Tutor.h"
+
+// Persists tutors as pipe-delimited text or as a columnar snapshot.
+//
+// Text layout:
+//   id|username|password|first|last|email|phone|qualification|experience|
+//   hourlyRate|sessions|averageRating|specialization;...|domain;...|
+//   model:level;...
+class TutorFileService : public FileService<Tutor> {
+private:
+    std::string serializeObject(const Tutor& tutor) const override;
+    Tutor deserializeObject(const std::string& data) const override;
+    
+    bool supportsSnapshot() const override;
+    uint32_t getSnapshotSchemaVersion() const override;
+    void encodeRecord(const Tutor& tutor, SnapshotBuilder& builder) const override;
+    Tutor decodeRecord(const SnapshotView& view, size_t row) const override;
+    
+public:
+    TutorFileService(const std::string& filename = "data/tutors.dat",
+                     StorageFormat format = StorageFormat::Snapshot);
+};
+
+#endif // TUTOR_FILE_SERVICE_H
@@ -0,0 +1,66 @@
+// TutorSchedule.h
+#ifndef TUTOR_SCHEDULE_H
+#define TUTOR_SCHEDULE_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include "../utils/IntervalTree.h"
+
+// Booked time per tutor, for availability checks when sessions are
+// scheduled or moved.
+//
+// A session's date and start time are packed into minutes since
+// 1970-01-01 00:00, so a booking is one [start, start + duration) range
+// of integers and sessions running past midnight need no special case.
+// Each tutor has an interval tree of their bookings, so an overlap check
+// costs O(log n) in that tutor's sessions instead of a scan of every
+// session booked. Back-to-back sessions, one ending as the next starts,
+// do not conflict.
+class TutorSchedule {
+private:
+    struct Booking {
+        int tutorId;
+        int64_t start;
+        int64_t end;
+    };
+
+    std::unordered_map<int, IntervalTree> bookingsByTutor;
+    std::unordered_map<int, Booking> bookings;      // By session ID
+
+    static bool encodeRange(const std::string& date, const std::string& startTime, int durationMinutes,
+                            int64_t& start, int64_t& end);
+
+public:
+    TutorSchedule();
+
+    // Minutes since 1970-01-01 00:00 of a "YYYY-MM-DD" date and "HH:MM"
+    // time; false if either is malformed
+    static bool encode(const std::string& date, const std::string& time, int64_t& minutes);
+
+    // Books the session for the tutor, replacing any earlier booking of the
+    // same session. Conflicts are not checked here; callers ask
+    // isAvailable() first. False for a malformed date or time or a
+    // non-positive duration.
+    bool book(int sessionId, int tutorId, const std::string& date, const std::string& startTime,
+              int durationMinutes);
+    bool release(int sessionId);    // On cancellation or removal
+    void clear();
+
+    // True if the tutor has no booking overlapping the range. A session
+    // being moved passes its own ID so its current booking is ignored.
+    bool isAvailable(int tutorId, const std::string& date, const std::string& startTime, int durationMinutes,
+                     int ignoreSessionId = -1) const;
+
+    // Sessions of the tutor overlapping [from, to), earliest start first
+    std::vector<int> getConflicts(int tutorId, const std::string& fromDate, const std::string& fromTime,
+                                  const std::string& toDate, const std::string& toTime) const;
+    std::vector<int> getConflicts(int tutorId, const std::string& date, const std::string& startTime,
+                                  int durationMinutes) const;
+
+    bool isBooked(int sessionId) const;
+    size_t size() const;
+};
+
+#endif // TUTOR_SCHEDULE_H
@@ -0,0 +1,29 @@
+// TutoringSessionFileService.h
+#ifndef TUTORING_SESSION_FILE_SERVICE_H
+#define TUTORING_SESSION_FILE_SERVICE_H
+
+#include <string>
+#include "FileService.h"
+#include "../models/TutoringSession.h"
+
+// Persists tutoring sessions as pipe-delimited text or as a columnar snapshot.
+//
+// Text layout:
+//   id|client|tutor|modelId;...|date|startTime|minutes|status|rating|
+//   objectives|notes|topic;...|skills|homework|cost|payment|remote|platform
+class TutoringSessionFileService : public FileService<TutoringSession> {
+private:
+    std::string serializeObject(const TutoringSession& session) const override;
+    TutoringSession deserializeObject(const std::string& data) const override;
+    
+    bool supportsSnapshot() const override;
+    uint32_t getSnapshotSchemaVersion() const override;
+    void encodeRecord(const TutoringSession& session, SnapshotBuilder& builder) const override;
+    TutoringSession decodeRecord(const SnapshotView& view, size_t row) const override;
+    
+public:
+    TutoringSessionFileService(const std::string& filename = "data/sessions.dat",
+                               StorageFormat format = StorageFormat::Snapshot);
+};
+
+#endif // TUTORING_SESSION_FILE_SERVICE_H
@@ -0,0 +1,67 @@
+// CompressedBitmap.h
+#ifndef COMPRESSED_BITMAP_H
+#define COMPRESSED_BITMAP_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Compressed set of 32-bit integers in the style of a roaring bitmap.
+//
+// Values are grouped into containers by their high 16 bits. A container
+// holds its low 16 bits as a sorted array while it has at most 4096 values,
+// and as a 65536-bit bitmap (8 KB) once it grows past that, so both sparse
+// and dense sets stay compact. Intersection, union and difference work
+// container by container and never expand values one at a time when both
+// sides are bitmaps.
+class CompressedBitmap {
+private:
+    static const size_t ARRAY_MAX = 4096;
+    static const size_t BITMAP_WORDS = 1024;
+
+    struct Container {
+        uint16_t key;                   // High 16 bits of every value
+        std::vector<uint16_t> array;    // Sorted low bits, while sparse
+        std::vector<uint64_t> bits;     // Low bits as a bitmap, once dense
+        uint32_t cardinality;
+
+        bool isBitmap() const { return !bits.empty(); }
+        bool contains(uint16_t low) const;
+    };
+
+    std::vector<Container> containers;  // Sorted by key, never empty
+
+    size_t findContainer(uint16_t key) const;
+    static void toBitmap(Container& container);
+    static void toArray(Container& container);
+    static void shrink(Container& container);
+
+    static Container intersect(const Container& left, const Container& right);
+    static Container unite(const Container& left, const Container& right);
+    static Container subtract(const Container& left, const Container& right);
+
+public:
+    CompressedBitmap();
+
+    // Returns false if the value was already present / absent
+    bool add(uint32_t value);
+    bool remove(uint32_t value);
+    bool contains(uint32_t value) const;
+
+    void clear();
+    size_t size() const;
+    bool empty() const;
+
+    // Set algebra; each returns a new bitmap
+    CompressedBitmap intersect(const CompressedBitmap& other) const;   // AND
+    CompressedBitmap unite(const CompressedBitmap& other) const;       // OR
+    CompressedBitmap subtract(const CompressedBitmap& other) const;    // AND NOT
+
+    // Values in ascending order
+    std::vector<uint32_t> toVector() const;
+
+    // Approximate heap footprint, for comparing against other layouts
+    size_t getMemoryUsage() const;
+};
+
+#endif // COMPRESSED_BITMAP_H
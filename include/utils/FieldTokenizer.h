@@ -0,0 +1,228 @@
+// FieldTokenizer.h
+#ifndef FIELD_TOKENIZER_H
+#define FIELD_TOKENIZER_H
+
+#include <string>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <cstddef>
+#include <climits>
+
+// Non-owning view of a run of characters inside a line buffer. The buffer
+// must outlive the view.
+class FieldView {
+private:
+    const char* start;
+    size_t length;
+
+public:
+    static const size_t npos = static_cast<size_t>(-1);
+
+    FieldView() : start(""), length(0) {}
+    FieldView(const char* data, size_t length) : start(data), length(length) {}
+    explicit FieldView(const std::string& value) : start(value.data()), length(value.size()) {}
+
+    const char* data() const { return start; }
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+    char operator[](size_t index) const { return start[index]; }
+
+    // Copy into an owned string
+    std::string str() const { return std::string(start, length); }
+
+    size_t find(char c) const {
+        const void* found = length ? std::memchr(start, c, length) : nullptr;
+        return found ? static_cast<size_t>(static_cast<const char*>(found) - start) : npos;
+    }
+
+    size_t rfind(char c) const {
+        for (size_t i = length; i > 0; i--) {
+            if (start[i - 1] == c) {
+                return i - 1;
+            }
+        }
+        return npos;
+    }
+
+    FieldView substr(size_t pos, size_t count = npos) const {
+        if (pos > length) {
+            pos = length;
+        }
+        if (count > length - pos) {
+            count = length - pos;
+        }
+        return FieldView(start + pos, count);
+    }
+
+    bool operator==(const char* value) const {
+        size_t valueLength = std::strlen(value);
+        return valueLength == length && std::memcmp(start, value, length) == 0;
+    }
+
+    bool operator!=(const char* value) const {
+        return !(*this == value);
+    }
+};
+
+// Splits a line into delimiter-separated fields without copying. A trailing
+// delimiter yields a final empty field, and an empty line yields one empty
+// field, matching std::getline-based splitting plus the trailing field.
+class FieldTokenizer {
+private:
+    const char* cursor;
+    const char* end;
+    char delimiter;
+    bool finished;
+
+public:
+    FieldTokenizer(const std::string& line, char delimiter = '|')
+        : cursor(line.data()), end(line.data() + line.size()), delimiter(delimiter), finished(false) {}
+
+    FieldTokenizer(const FieldView& line, char delimiter = '|')
+        : cursor(line.data()), end(line.data() + line.size()), delimiter(delimiter), finished(false) {}
+
+    // Returns false when no fields remain
+    bool next(FieldView& field) {
+        if (finished) {
+            return false;
+        }
+
+        const char* found = static_cast<const char*>(std::memchr(cursor, delimiter, end - cursor));
+        if (!found) {
+            field = FieldView(cursor, end - cursor);
+            finished = true;
+            return true;
+        }
+
+        field = FieldView(cursor, found - cursor);
+        cursor = found + 1;
+        return true;
+    }
+
+    // Fills up to maxFields views; returns how many were filled
+    size_t split(FieldView* fields, size_t maxFields) {
+        size_t count = 0;
+        while (count < maxFields && next(fields[count])) {
+            count++;
+        }
+        return count;
+    }
+};
+
+// Allocation-free parsers for numeric and date fields. Each returns false
+// if the whole field is not a valid value.
+class FieldParser {
+public:
+    static bool parseInt(const FieldView& field, int& value) {
+        size_t i = 0;
+        bool negative = false;
+        if (i < field.size() && (field[i] == '-' || field[i] == '+')) {
+            negative = field[i] == '-';
+            i++;
+        }
+        if (i == field.size()) {
+            return false;
+        }
+
+        long long result = 0;
+        for (; i < field.size(); i++) {
+            char c = field[i];
+            if (c < '0' || c > '9') {
+                return false;
+            }
+            result = result * 10 + (c - '0');
+            if (result > static_cast<long long>(INT_MAX) + 1) {
+                return false;
+            }
+        }
+
+        result = negative ? -result : result;
+        if (result > INT_MAX || result < INT_MIN) {
+            return false;
+        }
+        value = static_cast<int>(result);
+        return true;
+    }
+
+    static bool parseDouble(const FieldView& field, double& value) {
+        // strtod needs a terminated buffer; numeric fields are short
+        char buffer[64];
+        if (field.empty() || field.size() >= sizeof(buffer)) {
+            return false;
+        }
+        std::memcpy(buffer, field.data(), field.size());
+        buffer[field.size()] = '\0';
+
+        char* parsedEnd = nullptr;
+        value = std::strtod(buffer, &parsedEnd);
+        return parsedEnd == buffer + field.size();
+    }
+
+    // Text for a double field with 17 significant digits, so parseDouble
+    // reads back exactly the value that was written
+    static std::string formatDouble(double value) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+        return buffer;
+    }
+
+    static bool parseBool(const FieldView& field, bool& value) {
+        if (field == "1" || field == "true") {
+            value = true;
+            return true;
+        }
+        if (field == "0" || field == "false") {
+            value = false;
+            return true;
+        }
+        return false;
+    }
+
+    // Date in YYYY-MM-DD format, checked against the calendar
+    static bool parseDate(const FieldView& field, int& year, int& month, int& day) {
+        if (field.size() != 10 || field[4] != '-' || field[7] != '-') {
+            return false;
+        }
+        if (!parseDigits(field, 0, 4, year) || !parseDigits(field, 5, 2, month) ||
+            !parseDigits(field, 8, 2, day)) {
+            return false;
+        }
+        if (month < 1 || month > 12) {
+            return false;
+        }
+
+        static const int daysInMonth[] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        int maxDay = daysInMonth[month];
+        if (month == 2 && year % 4 == 0 && (year % 100 != 0 || year % 400 == 0)) {
+            maxDay = 29;
+        }
+        return day >= 1 && day <= maxDay;
+    }
+
+    // Time in 24-hour HH:MM format
+    static bool parseTime(const FieldView& field, int& hour, int& minute) {
+        if (field.size() != 5 || field[2] != ':') {
+            return false;
+        }
+        if (!parseDigits(field, 0, 2, hour) || !parseDigits(field, 3, 2, minute)) {
+            return false;
+        }
+        return hour <= 23 && minute <= 59;
+    }
+
+private:
+    static bool parseDigits(const FieldView& field, size_t pos, size_t count, int& value) {
+        value = 0;
+        for (size_t i = pos; i < pos + count; i++) {
+            char c = field[i];
+            if (c < '0' || c > '9') {
+                return false;
+            }
+            value = value * 10 + (c - '0');
+        }
+        return true;
+    }
+};
+
+#endif // FIELD_TOKENIZER_H
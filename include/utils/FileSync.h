@@ -0,0 +1,22 @@
+// FileSync.h
+#ifndef FILE_SYNC_H
+#define FILE_SYNC_H
+
+#include <string>
+
+// Flushes files and directory entries to stable storage. A file written
+// through a stream is synced by path after it is closed; a rename, create
+// or remove becomes durable once its directory is synced. Anything that
+// deletes or truncates the data a new file replaces must wait for both.
+class FileSync {
+public:
+    // Sync a closed file's contents; false if it cannot be opened or synced
+    static bool syncFile(const std::string& path);
+
+    // Sync the directory holding path, so entries changed in it survive a
+    // crash. Windows has no directory handles to sync, so this always
+    // succeeds there.
+    static bool syncParentDirectory(const std::string& path);
+};
+
+#endif // FILE_SYNC_H
@@ -0,0 +1,66 @@
+// IntervalTree.h
+#ifndef INTERVAL_TREE_H
+#define INTERVAL_TREE_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Half-open intervals [start, end) tagged with record IDs, answering "which
+// intervals overlap this one" in O(log N + K) for K matches.
+//
+// Entries are kept in a treap ordered by (start, ID), and every node also
+// stores the largest end in its subtree. A search skips any subtree whose
+// largest end is at or before the query's start, and any right subtree
+// once node starts reach the query's end. Nodes live in one vector and
+// link by index, so a tree costs a single allocation as it grows and
+// removed nodes are reused. Intervals that only touch, where one ends as
+// the other starts, do not overlap.
+class IntervalTree {
+private:
+    static const int32_t NONE = -1;
+
+    struct Node {
+        int64_t start;
+        int64_t end;
+        int64_t maxEnd;     // Largest end in this subtree
+        int id;
+        uint32_t priority;
+        int32_t left;
+        int32_t right;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<int32_t> freeNodes;
+    int32_t root;
+    size_t count;
+    uint32_t randomState;
+
+    static bool before(const Node& node, int64_t start, int id);
+    void update(int32_t node);
+    // Keys below (start, id) go left, the rest right; with inclusive set,
+    // (start, id) itself also goes left
+    void split(int32_t node, int64_t start, int id, bool inclusive, int32_t& left, int32_t& right);
+    int32_t merge(int32_t left, int32_t right);
+    bool visit(int32_t node, int64_t start, int64_t end, int excludeId, std::vector<int>* found) const;
+
+public:
+    IntervalTree();
+
+    // Adding an interval already present, same start and ID, does nothing
+    // and returns false. Empty intervals (end <= start) are rejected.
+    bool insert(int64_t start, int64_t end, int id);
+    bool remove(int64_t start, int id);
+    void clear();
+
+    // True if some interval other than excludeId's overlaps [start, end)
+    bool overlaps(int64_t start, int64_t end, int excludeId = -1) const;
+
+    // IDs of every interval overlapping [start, end), by start then ID
+    std::vector<int> findOverlapping(int64_t start, int64_t end) const;
+
+    size_t size() const;
+    bool empty() const;
+};
+
+#endif // INTERVAL_TREE_H
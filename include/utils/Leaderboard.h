@@ -0,0 +1,280 @@
+// Leaderboard.h
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <new>
+#include <cstdint>
+#include <cstddef>
+
+// Ranks record IDs by a score, best first, with ties going to the lower ID.
+//
+// Entries live in an indexed skip list: every forward link also records how
+// many entries it skips, so a score change costs O(log N), the top K
+// entries are read in O(K), and an entry's rank or the entries at any rank
+// offset are found in O(log N). Better decides which of two scores ranks
+// ahead: std::greater for "highest first", std::less for "lowest first".
+template <typename Score, typename Better = std::greater<Score>>
+class Leaderboard {
+private:
+    static const int MAX_LEVEL = 32;
+
+    struct Node;
+    struct Link {
+        Node* forward;
+        size_t span;    // Entries passed by following this link
+    };
+    // Links are allocated inline after the node, one per level, so a
+    // traversal touches one cache line per step rather than two
+    struct Node {
+        Score score;
+        int id;
+        Link links[1];
+
+        Node(const Score& score, int id) : score(score), id(id) {}
+    };
+
+    static Node* createNode(const Score& score, int id, int nodeLevel) {
+        void* memory = ::operator new(sizeof(Node) + (nodeLevel - 1) * sizeof(Link));
+        Node* node = new (memory) Node(score, id);
+        for (int i = 0; i < nodeLevel; i++) {
+            node->links[i] = Link{nullptr, 0};
+        }
+        return node;
+    }
+
+    static void destroyNode(Node* node) {
+        node->~Node();
+        ::operator delete(node);
+    }
+
+    Node* head;
+    int level;
+    size_t count;
+    std::unordered_map<int, Node*> nodeById;
+    uint64_t randomState;
+    Better better;
+
+    // True if (score, id) ranks strictly ahead of node
+    bool ahead(const Score& score, int id, const Node* node) const {
+        if (better(score, node->score)) {
+            return true;
+        }
+        return !better(node->score, score) && id < node->id;
+    }
+
+    int randomLevel() {
+        // xorshift64; each level is kept with probability 1/4
+        int nodeLevel = 1;
+        while (nodeLevel < MAX_LEVEL) {
+            randomState ^= randomState << 13;
+            randomState ^= randomState >> 7;
+            randomState ^= randomState << 17;
+            if ((randomState & 3) != 0) {
+                break;
+            }
+            nodeLevel++;
+        }
+        return nodeLevel;
+    }
+
+    void insert(const Score& score, int id) {
+        Node* update[MAX_LEVEL];
+        size_t rank[MAX_LEVEL];
+
+        Node* x = head;
+        for (int i = level - 1; i >= 0; i--) {
+            rank[i] = (i == level - 1) ? 0 : rank[i + 1];
+            while (x->links[i].forward && !ahead(score, id, x->links[i].forward)) {
+                rank[i] += x->links[i].span;
+                x = x->links[i].forward;
+            }
+            update[i] = x;
+        }
+
+        int nodeLevel = randomLevel();
+        if (nodeLevel > level) {
+            for (int i = level; i < nodeLevel; i++) {
+                rank[i] = 0;
+                update[i] = head;
+                head->links[i].span = count;
+            }
+            level = nodeLevel;
+        }
+
+        Node* node = createNode(score, id, nodeLevel);
+        for (int i = 0; i < nodeLevel; i++) {
+            node->links[i].forward = update[i]->links[i].forward;
+            update[i]->links[i].forward = node;
+            node->links[i].span = update[i]->links[i].span - (rank[0] - rank[i]);
+            update[i]->links[i].span = (rank[0] - rank[i]) + 1;
+        }
+        for (int i = nodeLevel; i < level; i++) {
+            update[i]->links[i].span++;
+        }
+
+        nodeById[id] = node;
+        count++;
+    }
+
+    void erase(Node* node) {
+        Node* update[MAX_LEVEL];
+
+        Node* x = head;
+        for (int i = level - 1; i >= 0; i--) {
+            while (x->links[i].forward && x->links[i].forward != node &&
+                   !ahead(node->score, node->id, x->links[i].forward)) {
+                x = x->links[i].forward;
+            }
+            update[i] = x;
+        }
+
+        for (int i = 0; i < level; i++) {
+            if (update[i]->links[i].forward == node) {
+                update[i]->links[i].span += node->links[i].span - 1;
+                update[i]->links[i].forward = node->links[i].forward;
+            } else {
+                update[i]->links[i].span--;
+            }
+        }
+        while (level > 1 && !head->links[level - 1].forward) {
+            level--;
+        }
+
+        nodeById.erase(node->id);
+        destroyNode(node);
+        count--;
+    }
+
+    // Node at a 1-based rank, or null
+    const Node* nodeAt(size_t rank) const {
+        if (rank == 0 || rank > count) {
+            return nullptr;
+        }
+        size_t traversed = 0;
+        const Node* x = head;
+        for (int i = level - 1; i >= 0; i--) {
+            while (x->links[i].forward && traversed + x->links[i].span <= rank) {
+                traversed += x->links[i].span;
+                x = x->links[i].forward;
+            }
+            if (traversed == rank) {
+                return x;
+            }
+        }
+        return nullptr;
+    }
+
+public:
+    explicit Leaderboard(Better better = Better())
+        : head(createNode(Score(), 0, MAX_LEVEL)), level(1), count(0), nodeById(),
+          randomState(0x9E3779B97F4A7C15ULL), better(better) {}
+
+    ~Leaderboard() {
+        clear();
+        destroyNode(head);
+    }
+
+    Leaderboard(const Leaderboard&) = delete;
+    Leaderboard& operator=(const Leaderboard&) = delete;
+
+    // Insert an entry or change its score
+    void set(int id, const Score& score) {
+        auto it = nodeById.find(id);
+        if (it != nodeById.end()) {
+            if (!better(score, it->second->score) && !better(it->second->score, score)) {
+                return;
+            }
+            erase(it->second);
+        }
+        insert(score, id);
+    }
+
+    bool remove(int id) {
+        auto it = nodeById.find(id);
+        if (it == nodeById.end()) {
+            return false;
+        }
+        erase(it->second);
+        return true;
+    }
+
+    bool contains(int id) const {
+        return nodeById.count(id) > 0;
+    }
+
+    // Score of an entry; the default Score if there is none
+    Score getScore(int id) const {
+        auto it = nodeById.find(id);
+        return it != nodeById.end() ? it->second->score : Score();
+    }
+
+    // 1-based position of an entry, or 0 if there is none
+    size_t getRank(int id) const {
+        auto it = nodeById.find(id);
+        if (it == nodeById.end()) {
+            return 0;
+        }
+        const Node* node = it->second;
+
+        size_t rank = 0;
+        const Node* x = head;
+        for (int i = level - 1; i >= 0; i--) {
+            while (x->links[i].forward && !ahead(node->score, node->id, x->links[i].forward)) {
+                rank += x->links[i].span;
+                x = x->links[i].forward;
+            }
+            if (x == node) {
+                return rank;
+            }
+        }
+        return rank;
+    }
+
+    // IDs of the best limit entries, best first
+    std::vector<int> top(size_t limit) const {
+        return range(0, limit);
+    }
+
+    // IDs of up to limit entries starting after the first offset entries
+    std::vector<int> range(size_t offset, size_t limit) const {
+        std::vector<int> ids;
+        if (offset >= count || limit == 0) {
+            return ids;
+        }
+        ids.reserve(limit < count - offset ? limit : count - offset);
+
+        const Node* x = offset == 0 ? head->links[0].forward : nodeAt(offset + 1);
+        for (; x && ids.size() < limit; x = x->links[0].forward) {
+            ids.push_back(x->id);
+        }
+        return ids;
+    }
+
+    void clear() {
+        Node* x = head->links[0].forward;
+        while (x) {
+            Node* next = x->links[0].forward;
+            destroyNode(x);
+            x = next;
+        }
+        for (int i = 0; i < MAX_LEVEL; i++) {
+            head->links[i] = Link{nullptr, 0};
+        }
+        nodeById.clear();
+        level = 1;
+        count = 0;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+};
+
+#endif // LEADERBOARD_H
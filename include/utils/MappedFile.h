@@ -0,0 +1,44 @@
+// MappedFile.h
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+// Read-only view of a whole file. Uses mmap where available so large
+// snapshots can be accessed in place; falls back to reading the file into
+// memory on platforms without it.
+class MappedFile {
+private:
+    const char* data;
+    size_t length;
+    std::vector<char> buffer;   // Only used by the non-mmap fallback
+    bool mapped;
+
+    void release();
+
+public:
+    // Constructors
+    MappedFile();
+    explicit MappedFile(const std::string& filename);
+
+    // Destructor
+    ~MappedFile();
+
+    // Non-copyable, movable
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other);
+    MappedFile& operator=(MappedFile&& other);
+
+    // Map a file; returns false if it cannot be opened
+    bool open(const std::string& filename);
+    void close();
+
+    bool isOpen() const;
+    const char* getData() const;
+    size_t getSize() const;
+};
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,104 @@
+// PrerequisiteGraph.h
+#ifndef PREREQUISITE_GRAPH_H
+#define PREREQUISITE_GRAPH_H
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+// Directed acyclic graph of "must come before" edges between record IDs.
+//
+// Edits go to per-node edge lists. Queries use a compiled copy in which
+// the nodes are laid out in topological order and each node's
+// prerequisites are a contiguous run of positions (CSR). Every
+// prerequisite sits at a lower position than the nodes that need it, so
+// transitive closures are one linear sweep over positions, with no
+// recursion or visited set. The layout is rebuilt on the first query after
+// an edit. Among nodes whose prerequisites are all placed, lower rank goes
+// first and then lower ID, which keeps the order stable.
+//
+// Hubs are nodes that only pass requirements through: linking every model
+// of one level into a hub and the hub into every model of the next level
+// takes one edge per model, where direct edges would take the product of
+// the level sizes. Hubs never appear in query results.
+class PrerequisiteGraph {
+private:
+    struct Node {
+        int rank;
+        bool hub;
+        std::vector<int> prerequisites;
+        std::vector<int> dependents;
+    };
+
+    std::unordered_map<int, Node> nodes;
+    size_t hubCount;
+    size_t edgeCount;
+    uint64_t version;
+
+    // Compiled layout
+    mutable bool compiled;
+    mutable std::vector<int> order;                         // Node IDs in topological order
+    mutable std::vector<int> visibleOrder;                  // order without the hubs
+    mutable std::vector<char> hubAt;                        // Per position
+    mutable std::unordered_map<int, uint32_t> positionOf;
+    mutable std::vector<uint32_t> prerequisiteOffsets;      // order.size() + 1 entries
+    mutable std::vector<uint32_t> prerequisitePositions;
+    mutable std::vector<uint32_t> dependentOffsets;
+    mutable std::vector<uint32_t> dependentPositions;
+
+    void changed();
+    void compile() const;
+    bool reaches(int from, int to) const;   // Path from -> to along dependents
+    std::vector<int> sweep(int id, bool towardPrerequisites) const;
+    std::vector<int> neighbours(int id, bool towardPrerequisites) const;
+
+public:
+    PrerequisiteGraph();
+
+    // Adds a node, or updates the rank of an existing one
+    void addNode(int id, int rank = 0);
+    void addHub(int id, int rank = 0);
+    void removeNode(int id);    // Also drops its edges; works for hubs too
+    bool contains(int id) const;
+
+    // Makes prerequisite a requirement of id. Fails if either node is
+    // missing or the edge would close a cycle; adding an existing edge
+    // succeeds without change.
+    bool addEdge(int prerequisite, int id);
+
+    // Adds an edge without addEdge's duplicate and cycle checks, which walk
+    // edge lists and the graph. For callers that know the edge is new and
+    // follows an order the graph already respects, such as hub wiring.
+    void link(int prerequisite, int id);
+    bool removeEdge(int prerequisite, int id);
+    bool hasEdge(int prerequisite, int id) const;
+
+    void clear();
+
+    // Direct neighbours, in ID order. Requirements carried by a hub count
+    // as direct.
+    std::vector<int> getPrerequisites(int id) const;
+    std::vector<int> getDependents(int id) const;
+
+    // Everything id transitively requires, or is required by, in
+    // topological order
+    std::vector<int> getAllPrerequisites(int id) const;
+    std::vector<int> getAllDependents(int id) const;
+
+    // Every node, prerequisites before the nodes that need them
+    const std::vector<int>& getTopologicalOrder() const;
+
+    // False once link() has closed a cycle, which leaves the nodes on and
+    // after it out of the topological order
+    bool isAcyclic() const;
+
+    size_t size() const;            // Nodes, not counting hubs
+    size_t getEdgeCount() const;    // Stored edges, including hub edges
+
+    // Changes with every edit, including clear(), so callers can tell
+    // whether results they cached are still current
+    uint64_t getVersion() const;
+};
+
+#endif // PREREQUISITE_GRAPH_H
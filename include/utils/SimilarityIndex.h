@@ -0,0 +1,81 @@
+// SimilarityIndex.h
+#ifndef SIMILARITY_INDEX_H
+#define SIMILARITY_INDEX_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+// Text similarity between records, by cosine of TF-IDF vectors.
+//
+// Each record's text is lower-cased and split into words. Its vector holds
+// a sublinear term frequency (1 + log count) per word, scaled at query
+// time by the word's inverse document frequency. Vectors are sparse and
+// kept in an inverted index: one posting list per word. Records live in
+// dense slots, so a query adds its postings' contributions into a flat
+// score array. The work is proportional to the postings of the query's
+// words, not to the number of records.
+//
+// Editing a record re-vectorizes only that record. Document frequencies,
+// and with them every norm, shift with each edit, so norms are recomputed
+// in one pass on the first query after a change.
+class SimilarityIndex {
+private:
+    struct Posting {
+        uint32_t slot;
+        float frequency;
+    };
+
+    struct Term {
+        uint32_t term;
+        float frequency;
+    };
+
+    std::unordered_map<std::string, uint32_t> termIds;
+    std::vector<std::vector<Posting>> postings;         // By term ID
+    std::unordered_map<int, uint32_t> slotOf;
+    std::vector<int> slotIds;                           // -1 for a free slot
+    std::vector<std::vector<Term>> slotTerms;           // Sorted by term ID
+    std::vector<uint32_t> freeSlots;
+    size_t count;
+
+    mutable std::vector<float> inverseNorms;            // By slot
+    mutable bool normsCurrent;
+    mutable std::vector<float> scores;                  // Query scratch, by slot
+
+    float inverseDocumentFrequency(uint32_t term) const;
+    void refreshNorms() const;
+    static std::vector<Term> weigh(const std::unordered_map<uint32_t, int>& counts);
+    std::vector<Term> vectorizeRecord(const std::string& text);
+    std::vector<Term> vectorizeQuery(const std::string& text) const;
+    std::vector<std::pair<int, float>> topMatches(const std::vector<Term>& query, size_t limit,
+                                                  int excludeId) const;
+
+public:
+    SimilarityIndex();
+
+    // Words of text, lower-cased, without one-letter words and stop words
+    static std::vector<std::string> tokenize(const std::string& text);
+
+    // Index or re-index a record's text
+    void add(int id, const std::string& text);
+    void remove(int id);
+    void clear();
+    bool contains(int id) const;
+
+    // At most limit (ID, cosine) pairs, most similar first; ties go to the
+    // lower ID. Records sharing no word with the query are left out.
+    std::vector<std::pair<int, float>> mostSimilar(int id, size_t limit) const;
+    std::vector<std::pair<int, float>> search(const std::string& text, size_t limit) const;
+
+    // Cosine similarity of two records; 0 if either is missing
+    float similarity(int first, int second) const;
+
+    size_t size() const;
+    size_t getTermCount() const;
+};
+
+#endif // SIMILARITY_INDEX_H
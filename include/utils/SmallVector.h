@@ -0,0 +1,130 @@
+// SmallVector.h
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+
+// Vector of trivially copyable values that keeps up to N of them inline and
+// only allocates once it grows past that. Most profiles hold a handful of
+// entries, so they never touch the heap. Order is preserved.
+template <typename T, size_t N>
+class SmallVector {
+    static_assert(std::is_trivially_copyable<T>::value, "SmallVector holds trivially copyable values");
+
+private:
+    T inlineItems[N];
+    T* items;           // inlineItems, or a heap block once grown
+    uint32_t count;
+    uint32_t capacity;
+
+    bool isInline() const { return items == inlineItems; }
+
+    void grow(size_t minimum) {
+        size_t newCapacity = std::max(minimum, static_cast<size_t>(capacity) * 2);
+        T* block = new T[newCapacity];
+        std::copy(items, items + count, block);
+        if (!isInline()) {
+            delete[] items;
+        }
+        items = block;
+        capacity = static_cast<uint32_t>(newCapacity);
+    }
+
+    void assign(const SmallVector& other) {
+        if (other.count > capacity) {
+            grow(other.count);
+        }
+        std::copy(other.items, other.items + other.count, items);
+        count = other.count;
+    }
+
+public:
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+    SmallVector() : inlineItems(), items(inlineItems), count(0), capacity(N) {}
+
+    SmallVector(const SmallVector& other) : inlineItems(), items(inlineItems), count(0), capacity(N) {
+        assign(other);
+    }
+
+    SmallVector(SmallVector&& other) : inlineItems(), items(inlineItems), count(0), capacity(N) {
+        if (other.isInline()) {
+            assign(other);
+        } else {
+            items = other.items;
+            count = other.count;
+            capacity = other.capacity;
+            other.items = other.inlineItems;
+            other.capacity = N;
+        }
+        other.count = 0;
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            assign(other);
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) {
+        if (this != &other) {
+            if (other.isInline()) {
+                assign(other);
+            } else {
+                if (!isInline()) {
+                    delete[] items;
+                }
+                items = other.items;
+                count = other.count;
+                capacity = other.capacity;
+                other.items = other.inlineItems;
+                other.capacity = N;
+            }
+            other.count = 0;
+        }
+        return *this;
+    }
+
+    ~SmallVector() {
+        if (!isInline()) {
+            delete[] items;
+        }
+    }
+
+    void push_back(const T& value) {
+        if (count == capacity) {
+            T copy = value;     // value may live in the block being replaced
+            grow(count + 1);
+            items[count++] = copy;
+            return;
+        }
+        items[count++] = value;
+    }
+
+    // Removes one element, keeping the order of the rest
+    iterator erase(iterator position) {
+        std::copy(position + 1, end(), position);
+        count--;
+        return position;
+    }
+
+    void clear() { count = 0; }
+
+    T& operator[](size_t index) { return items[index]; }
+    const T& operator[](size_t index) const { return items[index]; }
+
+    iterator begin() { return items; }
+    iterator end() { return items + count; }
+    const_iterator begin() const { return items; }
+    const_iterator end() const { return items + count; }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+};
+
+#endif // SMALL_VECTOR_H
@@ -0,0 +1,77 @@
+// SymbolTable.h
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+// Compact integer standing in for an interned name
+typedef uint32_t Symbol;
+
+// A symbol with a level attached, e.g. an AI model and a proficiency
+struct SymbolLevel {
+    Symbol symbol;
+    int level;
+};
+
+// Interns names as small integers, so records can store and compare a
+// Symbol instead of a string. A symbol keeps its number for the life of the
+// process; renaming it changes the name every holder sees in one step.
+//
+// After a rename the old name is free: interning it again gives a new
+// symbol. Rows stored before the rename still hold the old name, so it is
+// kept as an alias that only internStored() follows, until the owners of
+// those rows have rewritten them and call retireAliases(). Thread-safe.
+class SymbolTable {
+private:
+    struct Alias {
+        Symbol symbol;
+        uint64_t rename;    // Rename number that created it
+    };
+
+    std::vector<std::string> names;                     // Current name by symbol
+    std::unordered_map<std::string, Symbol> symbolByName;
+    std::unordered_map<std::string, Alias> aliases;     // Old names, for stored rows
+    uint64_t renameCount;
+    mutable std::mutex mutex;
+
+public:
+    SymbolTable();
+
+    // The process-wide table of AI model names
+    static SymbolTable& aiModels();
+
+    // Symbol for name, interning it if it is new
+    Symbol intern(const std::string& name);
+
+    // As intern(), for names read back from data files and journals: an
+    // old name still awaiting rewrite resolves to the renamed symbol
+    Symbol internStored(const std::string& name);
+
+    // Looks a name up without interning it; false if it has never been seen
+    bool find(const std::string& name, Symbol& symbol) const;
+
+    // Current name of a symbol; empty for an unknown symbol
+    std::string getName(Symbol symbol) const;
+
+    // Gives oldName's symbol the name newName. Fails if newName already
+    // names another symbol, or is an old name stored rows may still hold. If
+    // oldName was never interned, stored rows may still name it, so it
+    // becomes an alias of newName's symbol.
+    bool rename(const std::string& oldName, const std::string& newName);
+
+    // Drops the aliases of renames up to renameNumber (a getRenameCount()
+    // value), once every stored row naming them has been rewritten
+    void retireAliases(uint64_t renameNumber);
+
+    size_t size() const;
+
+    // Number of renames so far, for callers that cache names
+    uint64_t getRenameCount() const;
+};
+
+#endif // SYMBOL_TABLE_H
@@ -0,0 +1,62 @@
+// TrigramIndex.h
+#ifndef TRIGRAM_INDEX_H
+#define TRIGRAM_INDEX_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+// Case-insensitive substring index over one short text per record ID.
+//
+// Every text is lower-cased and broken into overlapping three-character
+// sequences (trigrams). Each trigram maps to a sorted posting list of the
+// IDs whose text contains it. A query is answered by intersecting the
+// posting lists of its trigrams, smallest first, and confirming the
+// remaining candidates against their stored text. Queries shorter than a
+// trigram fall back to a scan of the stored texts.
+class TrigramIndex {
+private:
+    std::unordered_map<int, std::string> texts;              // Normalized text by ID
+    std::unordered_map<uint32_t, std::vector<int>> postings; // Sorted IDs by trigram
+
+    static uint32_t trigramAt(const std::string& text, size_t pos);
+    static std::vector<uint32_t> uniqueTrigrams(const std::string& text);
+
+    void insertPosting(uint32_t trigram, int id);
+    void erasePosting(uint32_t trigram, int id);
+    std::vector<int> candidates(const std::string& query) const;
+
+public:
+    // Lower-cases ASCII letters, matching the services' search semantics
+    static std::string normalize(const std::string& text);
+
+    // Index or re-index a record's text
+    void add(int id, const std::string& text);
+    void remove(int id);
+    void clear();
+
+    // IDs whose text contains query, in ascending ID order. An empty query
+    // matches every record.
+    std::vector<int> search(const std::string& query) const;
+
+    // At most limit IDs, best matches first: matches at the start of the
+    // text, then at the start of a word, then anywhere; ties go to the
+    // shorter text and then the lower ID
+    std::vector<int> searchRanked(const std::string& query, size_t limit) const;
+
+    // Upper bound on the number of IDs search(query) returns, from the
+    // shortest posting list of its trigrams, without running the search.
+    // Queries shorter than a trigram are estimated as every record.
+    size_t estimate(const std::string& query) const;
+
+    // True if the record's text contains query; a single lookup, for
+    // checking a few known IDs instead of searching
+    bool contains(int id, const std::string& query) const;
+
+    size_t size() const;
+    size_t getTrigramCount() const;
+};
+
+#endif // TRIGRAM_INDEX_H
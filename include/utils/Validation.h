@@ -3,55 +3,159 @@
 #define VALIDATION_H
 
 #include <string>
-#include <regex>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstddef>
 #include "Exception.h"
+#include "FieldTokenizer.h"
 
 class Validation {
+private:
+    // Character classes of the patterns below, in the "C" locale the
+    // regex forms matched in: \d is [0-9] and \w is [A-Za-z0-9_]
+    static bool isDigit(char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    static bool isWordChar(char c) {
+        return isDigit(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+    }
+
+    static size_t skipWordChars(const char* text, size_t length, size_t i) {
+        while (i < length && isWordChar(text[i])) {
+            i++;
+        }
+        return i;
+    }
+
+    static bool isPhoneSeparator(char c) {
+        return c == '-' || c == '.' || c == ' ';
+    }
+
+    // Reads exactly count digits at i, advancing past them
+    static bool readDigits(const char* text, size_t length, size_t& i, size_t count, int& value) {
+        if (length - i < count) {
+            return false;
+        }
+        value = 0;
+        for (size_t end = i + count; i < end; i++) {
+            if (!isDigit(text[i])) {
+                return false;
+            }
+            value = value * 10 + (text[i] - '0');
+        }
+        return true;
+    }
+
 public:
-    // Email validation
+    // The validators below are hand-written scanners over the grammar given
+    // in each comment. They accept exactly what the equivalent std::regex
+    // match would, without building a regex per call. The (text, length)
+    // overloads let callers check a field in place without a std::string.
+
+    // Email validation: (\w+)(\.|_)?(\w*)@(\w+)(\.(\w+))+
+    // '_' is already a word character, so the local part is word characters
+    // with at most one '.' after the first of them.
+    static bool isValidEmail(const char* email, size_t length) {
+        size_t i = skipWordChars(email, length, 0);
+        if (i == 0) {
+            return false;
+        }
+        if (i < length && email[i] == '.') {
+            i = skipWordChars(email, length, i + 1);
+        }
+        if (i == length || email[i] != '@') {
+            return false;
+        }
+        i++;
+
+        // Domain: two or more non-empty labels separated by '.'
+        int labels = 0;
+        for (;;) {
+            size_t labelStart = i;
+            i = skipWordChars(email, length, i);
+            if (i == labelStart) {
+                return false;
+            }
+            labels++;
+            if (i == length) {
+                return labels >= 2;
+            }
+            if (email[i] != '.') {
+                return false;
+            }
+            i++;
+        }
+    }
+
     static bool isValidEmail(const std::string& email) {
-        const std::regex pattern("(\\w+)(\\.|_)?(\\w*)@(\\w+)(\\.(\\w+))+");
-        return std::regex_match(email, pattern);
+        return isValidEmail(email.data(), email.size());
     }
     
     // Phone validation (accepts formats like: 123-456-7890, (123) 456-7890, 123.456.7890)
+    // Grammar: \(?\d{3}\)?[-. ]?\d{3}[-. ]?\d{4}
+    static bool isValidPhone(const char* phone, size_t length) {
+        size_t i = 0;
+        int digits;
+        if (i < length && phone[i] == '(') {
+            i++;
+        }
+        if (!readDigits(phone, length, i, 3, digits)) {
+            return false;
+        }
+        if (i < length && phone[i] == ')') {
+            i++;
+        }
+        if (i < length && isPhoneSeparator(phone[i])) {
+            i++;
+        }
+        if (!readDigits(phone, length, i, 3, digits)) {
+            return false;
+        }
+        if (i < length && isPhoneSeparator(phone[i])) {
+            i++;
+        }
+        return readDigits(phone, length, i, 4, digits) && i == length;
+    }
+
     static bool isValidPhone(const std::string& phone) {
-        const std::regex pattern("\\(?\\d{3}\\)?[-. ]?\\d{3}[-. ]?\\d{4}");
-        return std::regex_match(phone, pattern);
+        return isValidPhone(phone.data(), phone.size());
     }
     
-    // Date validation (format: YYYY-MM-DD)
+    // Date validation (format: YYYY-MM-DD, a real calendar date)
+    static bool isValidDate(const char* date, size_t length) {
+        int year, month, day;
+        return FieldParser::parseDate(FieldView(date, length), year, month, day);
+    }
+
     static bool isValidDate(const std::string& date) {
-        const std::regex pattern("\\d{4}-\\d{2}-\\d{2}");
-        if (!std::regex_match(date, pattern)) {
+        return isValidDate(date.data(), date.size());
+    }
+    
+    // Time parsing (format: HH:MM, 24-hour, single-digit hour allowed)
+    // Grammar: ([01]?[0-9]|2[0-3]):[0-5][0-9]
+    static bool parseTime(const char* time, size_t length, int& hour, int& minute) {
+        size_t i = 0;
+        size_t hourDigits = (length == 4) ? 1 : 2;
+        if (length < 4 || length > 5 || !readDigits(time, length, i, hourDigits, hour) || hour > 23) {
             return false;
         }
-        
-        // Extract year, month, and day
-        int year = std::stoi(date.substr(0, 4));
-        int month = std::stoi(date.substr(5, 2));
-        int day = std::stoi(date.substr(8, 2));
-        
-        // Check month
-        if (month < 1 || month > 12) {
+        if (time[i] != ':') {
             return false;
         }
-        
-        // Check day based on month
-        int daysInMonth[] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
-        
-        // Adjust for leap year
-        if (year % 4 == 0 && (year % 100 != 0 || year % 400 == 0)) {
-            daysInMonth[2] = 29;
-        }
-        
-        return (day >= 1 && day <= daysInMonth[month]);
+        i++;
+        return readDigits(time, length, i, 2, minute) && minute <= 59;
     }
-    
-    // Time validation (format: HH:MM, 24-hour)
+
+    // Time validation, as parseTime
+    static bool isValidTime(const char* time, size_t length) {
+        int hour, minute;
+        return parseTime(time, length, hour, minute);
+    }
+
     static bool isValidTime(const std::string& time) {
-        const std::regex pattern("([01]?[0-9]|2[0-3]):[0-5][0-9]");
-        return std::regex_match(time, pattern);
+        return isValidTime(time.data(), time.size());
     }
     
     // Integer validation
@@ -0,0 +1,81 @@
+// VersionedMemo.h
+#ifndef VERSIONED_MEMO_H
+#define VERSIONED_MEMO_H
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+// Hit and miss counts of one or more memos
+struct MemoStats {
+    size_t entries;
+    size_t hits;
+    size_t misses;
+
+    MemoStats() : entries(0), hits(0), misses(0) {}
+
+    MemoStats& operator+=(const MemoStats& other) {
+        entries += other.entries;
+        hits += other.hits;
+        misses += other.misses;
+        return *this;
+    }
+};
+
+// Results of a read-only query, keyed by the query and its arguments and
+// stamped with the version of the data they were computed from.
+//
+// The owner passes its current version with every lookup. Any change of
+// version means the data changed, so every stored result is dropped at
+// once; a result is only ever returned for the version it was computed
+// at. Past maxEntries distinct keys within one version, the memo starts
+// over rather than growing without bound.
+template <typename Value>
+class VersionedMemo {
+private:
+    std::unordered_map<std::string, Value> results;
+    uint64_t version;
+    size_t maxEntries;
+    size_t hits;
+    size_t misses;
+
+public:
+    explicit VersionedMemo(size_t maxEntries = 256)
+        : results(), version(0), maxEntries(maxEntries), hits(0), misses(0) {}
+
+    // The stored result for key at currentVersion, or compute()'s, stored
+    template <typename Compute>
+    const Value& get(const std::string& key, uint64_t currentVersion, Compute compute) {
+        if (currentVersion != version) {
+            results.clear();
+            version = currentVersion;
+        }
+
+        auto found = results.find(key);
+        if (found != results.end()) {
+            hits++;
+            return found->second;
+        }
+        misses++;
+        if (results.size() >= maxEntries) {
+            results.clear();
+        }
+        return results.insert(std::make_pair(key, compute())).first->second;
+    }
+
+    void clear() {
+        results.clear();
+    }
+
+    MemoStats getStats() const {
+        MemoStats stats;
+        stats.entries = results.size();
+        stats.hits = hits;
+        stats.misses = misses;
+        return stats;
+    }
+};
+
+#endif // VERSIONED_MEMO_H
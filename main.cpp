@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include <functional>
+#include <chrono>
 
 // Include all necessary header files
 #include "include/models/User.h"
@@ -83,10 +84,15 @@ int main() {
 // In main.cpp, find the initializeServices() function and modify it to:
 
 void initializeServices() {
-    // Create service instances for implemented services
+    auto startTime = std::chrono::steady_clock::now();
+    
+    // Create service instances for implemented services. Services backed by
+    // a binary snapshot map it and decode records only when first accessed.
+    // The AI model catalog loads first: replaying its journal redoes model
+    // renames that client rows saved before them still need.
     authService = std::make_shared<AuthService>();
-    clientService = std::make_shared<ClientService>();
     aiModelService = std::make_shared<AIModelService>();
+    clientService = std::make_shared<ClientService>();
     
     // Comment out unimplemented services
     /*
@@ -102,7 +108,9 @@ void initializeServices() {
     */
     
     // Log system startup
-    Logger::getInstance().info("CRM System started");
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime);
+    Logger::getInstance().info("CRM System started in " + std::to_string(elapsed.count()) + " ms");
 }
 
 // Create the menu structure
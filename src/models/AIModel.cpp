@@ -8,7 +8,8 @@ AIModel::AIModel()
     : modelId(0), name(""), version(""), developer(""), category(""),
       releaseDate(""), description(""), capabilities(), limitations(),
       useCases(), parameters(), complexityLevel(1), popularityRank(0),
-      tutorsAvailable(0), documentationURL(""), isDeprecated(false) {}
+      tutorsAvailable(0), documentationURL(""), isDeprecated(false),
+      addedPrerequisites(), removedPrerequisites() {}
 
 // Parameterized constructor
 AIModel::AIModel(int modelId, const std::string& name, const std::string& version,
@@ -19,7 +20,7 @@ AIModel::AIModel(int modelId, const std::string& name, const std::string& versio
       category(category), releaseDate(releaseDate), description(description),
       capabilities(), limitations(), useCases(), parameters(),
       complexityLevel(complexityLevel), popularityRank(0), tutorsAvailable(0),
-      documentationURL(""), isDeprecated(false) {}
+      documentationURL(""), isDeprecated(false), addedPrerequisites(), removedPrerequisites() {}
 
 // Getters and setters
 int AIModel::getModelId() const { return modelId; }
@@ -130,6 +131,27 @@ void AIModel::setDocumentationURL(const std::string& url) { documentationURL = u
 bool AIModel::getIsDeprecated() const { return isDeprecated; }
 void AIModel::setIsDeprecated(bool deprecated) { isDeprecated = deprecated; }
 
+// Prerequisite edit methods
+const std::vector<int>& AIModel::getAddedPrerequisites() const { return addedPrerequisites; }
+const std::vector<int>& AIModel::getRemovedPrerequisites() const { return removedPrerequisites; }
+
+void AIModel::addPrerequisite(int modelId) {
+    forgetPrerequisite(modelId);
+    addedPrerequisites.push_back(modelId);
+}
+
+void AIModel::removePrerequisite(int modelId) {
+    forgetPrerequisite(modelId);
+    removedPrerequisites.push_back(modelId);
+}
+
+void AIModel::forgetPrerequisite(int modelId) {
+    addedPrerequisites.erase(std::remove(addedPrerequisites.begin(), addedPrerequisites.end(), modelId),
+                             addedPrerequisites.end());
+    removedPrerequisites.erase(std::remove(removedPrerequisites.begin(), removedPrerequisites.end(), modelId),
+                               removedPrerequisites.end());
+}
+
 // Utility methods
 std::string AIModel::getComplexityDescription() const {
     switch (complexityLevel) {
@@ -44,11 +44,24 @@ std::string Client::getPosition() const { return position; }
 void Client::setPosition(const std::string& position) { this->position = position; }
 
 // AI models of interest methods
-const std::vector<std::string>& Client::getAIModelsOfInterest() const {
+std::vector<std::string> Client::getAIModelsOfInterest() const {
+    std::vector<std::string> models;
+    models.reserve(aiModelsOfInterest.size());
+    for (Symbol model : aiModelsOfInterest) {
+        models.push_back(SymbolTable::aiModels().getName(model));
+    }
+    return models;
+}
+
+const SmallVector<Symbol, 4>& Client::getAIModelSymbols() const {
     return aiModelsOfInterest;
 }
 
 void Client::addAIModel(const std::string& model) {
+    addAIModel(SymbolTable::aiModels().intern(model));
+}
+
+void Client::addAIModel(Symbol model) {
     // Check if the model is already in the list
     if (!isInterestedIn(model)) {
         aiModelsOfInterest.push_back(model);
@@ -56,6 +69,13 @@ void Client::addAIModel(const std::string& model) {
 }
 
 void Client::removeAIModel(const std::string& model) {
+    Symbol symbol;
+    if (SymbolTable::aiModels().find(model, symbol)) {
+        removeAIModel(symbol);
+    }
+}
+
+void Client::removeAIModel(Symbol model) {
     auto it = std::find(aiModelsOfInterest.begin(), aiModelsOfInterest.end(), model);
     if (it != aiModelsOfInterest.end()) {
         aiModelsOfInterest.erase(it);
@@ -63,6 +83,11 @@ void Client::removeAIModel(const std::string& model) {
 }
 
 bool Client::isInterestedIn(const std::string& model) const {
+    Symbol symbol;
+    return SymbolTable::aiModels().find(model, symbol) && isInterestedIn(symbol);
+}
+
+bool Client::isInterestedIn(Symbol model) const {
     return std::find(aiModelsOfInterest.begin(), aiModelsOfInterest.end(), model) != aiModelsOfInterest.end();
 }
 
@@ -84,21 +109,50 @@ void Client::removeLearningGoal(const std::string& goal) {
 
 // AI model proficiency methods
 int Client::getAIModelProficiency(const std::string& model) const {
-    auto it = aiModelProficiency.find(model);
-    if (it != aiModelProficiency.end()) {
-        return it->second;
+    Symbol symbol;
+    if (SymbolTable::aiModels().find(model, symbol)) {
+        for (const auto& entry : aiModelProficiency) {
+            if (entry.symbol == symbol) {
+                return entry.level;
+            }
+        }
     }
     return 0; // No proficiency by default
 }
 
 void Client::setAIModelProficiency(const std::string& model, int level) {
     // Ensure level is between 1 and 5
-    if (level >= 1 && level <= 5) {
-        aiModelProficiency[model] = level;
+    if (level < 1 || level > 5) {
+        return;
+    }
+    
+    setAIModelProficiency(SymbolTable::aiModels().intern(model), level);
+}
+
+void Client::setAIModelProficiency(Symbol model, int level) {
+    if (level < 1 || level > 5) {
+        return;
+    }
+    
+    for (auto& entry : aiModelProficiency) {
+        if (entry.symbol == model) {
+            entry.level = level;
+            return;
+        }
+    }
+    aiModelProficiency.push_back(SymbolLevel{model, level});
+}
+
+// Keyed by current model name, in name order
+std::map<std::string, int> Client::getAllProficiencies() const {
+    std::map<std::string, int> proficiencies;
+    for (const auto& entry : aiModelProficiency) {
+        proficiencies[SymbolTable::aiModels().getName(entry.symbol)] = entry.level;
     }
+    return proficiencies;
 }
 
-const std::map<std::string, int>& Client::getAllProficiencies() const {
+const SmallVector<SymbolLevel, 4>& Client::getProficiencySymbols() const {
     return aiModelProficiency;
 }
 
@@ -143,7 +197,7 @@ void Client::displayInfo() const {
     std::cout << "Budget: $" << std::fixed << std::setprecision(2) << budget << std::endl;
     
     std::cout << "\nAI Models of Interest: ";
-    for (const auto& model : aiModelsOfInterest) {
+    for (const auto& model : getAIModelsOfInterest()) {
         std::cout << model << ", ";
     }
     std::cout << std::endl;
@@ -158,7 +212,7 @@ void Client::displayInfo() const {
 void Client::displayProficiencies() const {
     std::cout << "Proficiency Levels for " << getFullName() << ":" << std::endl;
     
-    for (const auto& proficiency : aiModelProficiency) {
+    for (const auto& proficiency : getAllProficiencies()) {
         std::cout << proficiency.first << ": ";
         
         // Display stars for proficiency level
@@ -187,9 +241,10 @@ std::ostream& operator<<(std::ostream& os, const Client& client) {
     os << "Budget: $" << std::fixed << std::setprecision(2) << client.budget << std::endl;
     
     os << "AI Models of Interest: ";
-    for (size_t i = 0; i < client.aiModelsOfInterest.size(); i++) {
-        os << client.aiModelsOfInterest[i];
-        if (i < client.aiModelsOfInterest.size() - 1) {
+    std::vector<std::string> models = client.getAIModelsOfInterest();
+    for (size_t i = 0; i < models.size(); i++) {
+        os << models[i];
+        if (i < models.size() - 1) {
             os << ", ";
         }
     }
@@ -0,0 +1,213 @@
+#include "include/models/LearningMaterial.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+// Default constructor
+LearningMaterial::LearningMaterial()
+    : materialId(0), title(""), description(""), type(""), format(""), author(""),
+      creationDate(""), aiModelIds(), tags(), difficultyLevel(1), url(""),
+      localPath(""), estimatedTimeMinutes(0), rating(0.0), usageCount(0) {}
+
+// Parameterized constructor
+LearningMaterial::LearningMaterial(int materialId, const std::string& title,
+                                   const std::string& description, const std::string& type,
+                                   const std::string& format, const std::string& author)
+    : materialId(materialId), title(title), description(description), type(type),
+      format(format), author(author), creationDate(""), aiModelIds(), tags(),
+      difficultyLevel(1), url(""), localPath(""), estimatedTimeMinutes(0),
+      rating(0.0), usageCount(0) {}
+
+// Getters and setters
+int LearningMaterial::getMaterialId() const { return materialId; }
+void LearningMaterial::setMaterialId(int id) { materialId = id; }
+
+std::string LearningMaterial::getTitle() const { return title; }
+void LearningMaterial::setTitle(const std::string& title) { this->title = title; }
+
+std::string LearningMaterial::getDescription() const { return description; }
+void LearningMaterial::setDescription(const std::string& description) { this->description = description; }
+
+std::string LearningMaterial::getType() const { return type; }
+void LearningMaterial::setType(const std::string& type) { this->type = type; }
+
+std::string LearningMaterial::getFormat() const { return format; }
+void LearningMaterial::setFormat(const std::string& format) { this->format = format; }
+
+std::string LearningMaterial::getAuthor() const { return author; }
+void LearningMaterial::setAuthor(const std::string& author) { this->author = author; }
+
+std::string LearningMaterial::getCreationDate() const { return creationDate; }
+void LearningMaterial::setCreationDate(const std::string& date) { creationDate = date; }
+
+// AI model methods
+const std::vector<int>& LearningMaterial::getAIModelIds() const {
+    return aiModelIds;
+}
+
+void LearningMaterial::addAIModel(int modelId) {
+    if (!isRelevantForModel(modelId)) {
+        aiModelIds.push_back(modelId);
+    }
+}
+
+void LearningMaterial::removeAIModel(int modelId) {
+    auto it = std::find(aiModelIds.begin(), aiModelIds.end(), modelId);
+    if (it != aiModelIds.end()) {
+        aiModelIds.erase(it);
+    }
+}
+
+bool LearningMaterial::isRelevantForModel(int modelId) const {
+    return std::find(aiModelIds.begin(), aiModelIds.end(), modelId) != aiModelIds.end();
+}
+
+// Tag methods
+const std::vector<std::string>& LearningMaterial::getTags() const {
+    return tags;
+}
+
+void LearningMaterial::addTag(const std::string& tag) {
+    if (!hasTag(tag)) {
+        tags.push_back(tag);
+    }
+}
+
+void LearningMaterial::removeTag(const std::string& tag) {
+    auto it = std::find(tags.begin(), tags.end(), tag);
+    if (it != tags.end()) {
+        tags.erase(it);
+    }
+}
+
+bool LearningMaterial::hasTag(const std::string& tag) const {
+    return std::find(tags.begin(), tags.end(), tag) != tags.end();
+}
+
+int LearningMaterial::getDifficultyLevel() const { return difficultyLevel; }
+void LearningMaterial::setDifficultyLevel(int level) {
+    // Ensure level is between 1 and 5
+    difficultyLevel = std::max(1, std::min(5, level));
+}
+
+std::string LearningMaterial::getURL() const { return url; }
+void LearningMaterial::setURL(const std::string& url) { this->url = url; }
+
+std::string LearningMaterial::getLocalPath() const { return localPath; }
+void LearningMaterial::setLocalPath(const std::string& path) { localPath = path; }
+
+int LearningMaterial::getEstimatedTimeMinutes() const { return estimatedTimeMinutes; }
+void LearningMaterial::setEstimatedTimeMinutes(int minutes) { estimatedTimeMinutes = minutes; }
+
+double LearningMaterial::getRating() const { return rating; }
+
+void LearningMaterial::updateRating(double newRating) {
+    if (usageCount == 0) {
+        rating = newRating;
+    } else {
+        // Calculate new average
+        rating = ((rating * usageCount) + newRating) / (usageCount + 1);
+    }
+}
+
+int LearningMaterial::getUsageCount() const { return usageCount; }
+void LearningMaterial::incrementUsageCount() { usageCount++; }
+void LearningMaterial::setUsageCount(int count) { usageCount = count; }
+
+// Utility methods
+std::string LearningMaterial::getDifficultyDescription() const {
+    switch (difficultyLevel) {
+        case 1: return "Beginner";
+        case 2: return "Elementary";
+        case 3: return "Intermediate";
+        case 4: return "Upper Intermediate";
+        case 5: return "Advanced";
+        default: return "Unknown";
+    }
+}
+
+std::string LearningMaterial::getFormattedEstimatedTime() const {
+    std::stringstream ss;
+    ss << std::setw(2) << std::setfill('0') << estimatedTimeMinutes / 60 << ":"
+       << std::setw(2) << std::setfill('0') << estimatedTimeMinutes % 60;
+    return ss.str();
+}
+
+bool LearningMaterial::isDigital() const {
+    return !url.empty() || !localPath.empty();
+}
+
+// Display methods
+void LearningMaterial::displayInfo() const {
+    std::cout << "Material ID: " << materialId << std::endl;
+    std::cout << "Title: " << title << std::endl;
+    std::cout << "Description: " << description << std::endl;
+    std::cout << "Type: " << type << " (" << format << ")" << std::endl;
+    std::cout << "Author: " << author << std::endl;
+    std::cout << "Created: " << creationDate << std::endl;
+    std::cout << "Difficulty: " << getDifficultyDescription() << std::endl;
+    std::cout << "Estimated Time: " << getFormattedEstimatedTime() << std::endl;
+    std::cout << "Rating: " << rating << " (" << usageCount << " uses)" << std::endl;
+
+    if (!url.empty()) {
+        std::cout << "URL: " << url << std::endl;
+    }
+    if (!localPath.empty()) {
+        std::cout << "Local Path: " << localPath << std::endl;
+    }
+}
+
+void LearningMaterial::displayTags() const {
+    std::cout << "Tags: ";
+    for (const auto& tag : tags) {
+        std::cout << tag << ", ";
+    }
+    std::cout << std::endl;
+}
+
+// Operator overloading
+std::ostream& operator<<(std::ostream& os, const LearningMaterial& material) {
+    os << "Material ID: " << material.materialId << std::endl;
+    os << "Title: " << material.title << std::endl;
+    os << "Type: " << material.type << " (" << material.format << ")" << std::endl;
+    os << "Author: " << material.author << std::endl;
+    os << "Difficulty: " << material.getDifficultyDescription() << std::endl;
+
+    os << "Tags: ";
+    for (size_t i = 0; i < material.tags.size(); i++) {
+        os << material.tags[i];
+        if (i < material.tags.size() - 1) {
+            os << ", ";
+        }
+    }
+    os << std::endl;
+
+    return os;
+}
+
+std::istream& operator>>(std::istream& is, LearningMaterial& material) {
+    std::cout << "Enter Material ID: ";
+    is >> material.materialId;
+    is.ignore(); // Clear newline
+
+    std::cout << "Enter Title: ";
+    std::getline(is, material.title);
+
+    std::cout << "Enter Description: ";
+    std::getline(is, material.description);
+
+    std::cout << "Enter Type: ";
+    std::getline(is, material.type);
+
+    std::cout << "Enter Format: ";
+    std::getline(is, material.format);
+
+    std::cout << "Enter Author: ";
+    std::getline(is, material.author);
+
+    std::cout << "Enter Difficulty Level (1-5): ";
+    is >> material.difficultyLevel;
+    is.ignore(); // Clear newline
+
+    return is;
+}
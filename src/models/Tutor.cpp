@@ -17,27 +17,53 @@ Tutor::Tutor(int userId, const std::string& username, const std::string& passwor
              const std::string& qualification, int experienceYears,
              double hourlyRate)
     : User(userId, username, password, firstName, lastName, email, phone),
-      aiSpecializations(aiSpecializations), domainExpertise(domainExpertise),
+      aiSpecializations(), domainExpertise(domainExpertise),
       qualification(qualification), experienceYears(experienceYears),
-      hourlyRate(hourlyRate), sessionsCompleted(0), averageRating(0.0) {}
+      aiModelExperience(), hourlyRate(hourlyRate), sessionsCompleted(0), averageRating(0.0) {
+    for (const auto& aiModel : aiSpecializations) {
+        addAISpecialization(aiModel);
+    }
+}
 
 // AI Specializations methods
-const std::vector<std::string>& Tutor::getAISpecializations() const {
+std::vector<std::string> Tutor::getAISpecializations() const {
+    std::vector<std::string> names;
+    names.reserve(aiSpecializations.size());
+    for (Symbol aiModel : aiSpecializations) {
+        names.push_back(SymbolTable::aiModels().getName(aiModel));
+    }
+    return names;
+}
+
+const SmallVector<Symbol, 4>& Tutor::getAISpecializationSymbols() const {
     return aiSpecializations;
 }
 
 void Tutor::addAISpecialization(const std::string& aiModel) {
+    addAISpecialization(SymbolTable::aiModels().intern(aiModel));
+}
+
+void Tutor::addAISpecialization(Symbol aiModel) {
     aiSpecializations.push_back(aiModel);
 }
 
 void Tutor::removeAISpecialization(const std::string& aiModel) {
-    auto it = std::find(aiSpecializations.begin(), aiSpecializations.end(), aiModel);
+    Symbol symbol;
+    if (!SymbolTable::aiModels().find(aiModel, symbol)) {
+        return;
+    }
+    auto it = std::find(aiSpecializations.begin(), aiSpecializations.end(), symbol);
     if (it != aiSpecializations.end()) {
         aiSpecializations.erase(it);
     }
 }
 
 bool Tutor::hasAISpecialization(const std::string& aiModel) const {
+    Symbol symbol;
+    return SymbolTable::aiModels().find(aiModel, symbol) && hasAISpecialization(symbol);
+}
+
+bool Tutor::hasAISpecialization(Symbol aiModel) const {
     return std::find(aiSpecializations.begin(), aiSpecializations.end(), aiModel) != aiSpecializations.end();
 }
 
@@ -69,19 +95,38 @@ int Tutor::getExperienceYears() const { return experienceYears; }
 void Tutor::setExperienceYears(int years) { this->experienceYears = years; }
 
 int Tutor::getAIModelExperience(const std::string& aiModel) const {
-    auto it = aiModelExperience.find(aiModel);
-    if (it != aiModelExperience.end()) {
-        return it->second;
+    Symbol symbol;
+    if (SymbolTable::aiModels().find(aiModel, symbol)) {
+        for (const auto& entry : aiModelExperience) {
+            if (entry.symbol == symbol) {
+                return entry.level;
+            }
+        }
     }
     return 0;
 }
 
 void Tutor::setAIModelExperience(const std::string& aiModel, int level) {
-    aiModelExperience[aiModel] = level;
+    setAIModelExperience(SymbolTable::aiModels().intern(aiModel), level);
 }
 
-const std::map<std::string, int>& Tutor::getAllAIModelExperience() const {
-    return aiModelExperience;
+void Tutor::setAIModelExperience(Symbol aiModel, int level) {
+    for (auto& entry : aiModelExperience) {
+        if (entry.symbol == aiModel) {
+            entry.level = level;
+            return;
+        }
+    }
+    aiModelExperience.push_back(SymbolLevel{aiModel, level});
+}
+
+// Keyed by current model name, in name order
+std::map<std::string, int> Tutor::getAllAIModelExperience() const {
+    std::map<std::string, int> experience;
+    for (const auto& entry : aiModelExperience) {
+        experience[SymbolTable::aiModels().getName(entry.symbol)] = entry.level;
+    }
+    return experience;
 }
 
 double Tutor::getHourlyRate() const { return hourlyRate; }
@@ -118,7 +163,7 @@ void Tutor::displayInfo() const {
     std::cout << "Average Rating: " << averageRating << std::endl;
     
     std::cout << "AI Specializations: ";
-    for (const auto& spec : aiSpecializations) {
+    for (const auto& spec : getAISpecializations()) {
         std::cout << spec << ", ";
     }
     std::cout << std::endl;
@@ -141,7 +186,7 @@ std::ostream& operator<<(std::ostream& os, const Tutor& tutor) {
     os << "Average Rating: " << tutor.averageRating << std::endl;
     
     os << "AI Specializations: ";
-    for (const auto& spec : tutor.aiSpecializations) {
+    for (const auto& spec : tutor.getAISpecializations()) {
         os << spec << ", ";
     }
     os << std::endl;
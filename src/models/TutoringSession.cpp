@@ -0,0 +1,210 @@
+#include "include/models/TutoringSession.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+// Default constructor
+TutoringSession::TutoringSession()
+    : sessionId(0), clientId(0), tutorId(0), aiModelIds(), sessionDate(""),
+      startTime(""), durationMinutes(0), status("Scheduled"), clientRating(0.0),
+      learningObjectives(""), sessionNotes(""), topics(), skillsGained(""),
+      homeworkAssigned(""), sessionCost(0.0), paymentStatus("Pending"),
+      isRemote(true), platform("Zoom") {}
+
+// Parameterized constructor
+TutoringSession::TutoringSession(int sessionId, int clientId, int tutorId,
+                                 const std::vector<int>& aiModelIds,
+                                 const std::string& sessionDate, const std::string& startTime,
+                                 int durationMinutes, bool isRemote,
+                                 const std::string& platform)
+    : sessionId(sessionId), clientId(clientId), tutorId(tutorId), aiModelIds(aiModelIds),
+      sessionDate(sessionDate), startTime(startTime), durationMinutes(durationMinutes),
+      status("Scheduled"), clientRating(0.0), learningObjectives(""), sessionNotes(""),
+      topics(), skillsGained(""), homeworkAssigned(""), sessionCost(0.0),
+      paymentStatus("Pending"), isRemote(isRemote), platform(platform) {}
+
+// Getters and setters
+int TutoringSession::getSessionId() const { return sessionId; }
+void TutoringSession::setSessionId(int id) { sessionId = id; }
+
+int TutoringSession::getClientId() const { return clientId; }
+void TutoringSession::setClientId(int id) { clientId = id; }
+
+int TutoringSession::getTutorId() const { return tutorId; }
+void TutoringSession::setTutorId(int id) { tutorId = id; }
+
+// AI model methods
+const std::vector<int>& TutoringSession::getAIModelIds() const {
+    return aiModelIds;
+}
+
+void TutoringSession::addAIModel(int modelId) {
+    if (!includesAIModel(modelId)) {
+        aiModelIds.push_back(modelId);
+    }
+}
+
+void TutoringSession::removeAIModel(int modelId) {
+    auto it = std::find(aiModelIds.begin(), aiModelIds.end(), modelId);
+    if (it != aiModelIds.end()) {
+        aiModelIds.erase(it);
+    }
+}
+
+bool TutoringSession::includesAIModel(int modelId) const {
+    return std::find(aiModelIds.begin(), aiModelIds.end(), modelId) != aiModelIds.end();
+}
+
+std::string TutoringSession::getSessionDate() const { return sessionDate; }
+void TutoringSession::setSessionDate(const std::string& date) { sessionDate = date; }
+
+std::string TutoringSession::getStartTime() const { return startTime; }
+void TutoringSession::setStartTime(const std::string& time) { startTime = time; }
+
+int TutoringSession::getDurationMinutes() const { return durationMinutes; }
+void TutoringSession::setDurationMinutes(int duration) { durationMinutes = duration; }
+
+std::string TutoringSession::getStatus() const { return status; }
+void TutoringSession::setStatus(const std::string& status) { this->status = status; }
+
+double TutoringSession::getClientRating() const { return clientRating; }
+void TutoringSession::setClientRating(double rating) { clientRating = rating; }
+
+std::string TutoringSession::getLearningObjectives() const { return learningObjectives; }
+void TutoringSession::setLearningObjectives(const std::string& objectives) { learningObjectives = objectives; }
+
+std::string TutoringSession::getSessionNotes() const { return sessionNotes; }
+void TutoringSession::setSessionNotes(const std::string& notes) { sessionNotes = notes; }
+
+// Topic methods
+const std::vector<std::string>& TutoringSession::getTopics() const {
+    return topics;
+}
+
+void TutoringSession::addTopic(const std::string& topic) {
+    if (std::find(topics.begin(), topics.end(), topic) == topics.end()) {
+        topics.push_back(topic);
+    }
+}
+
+void TutoringSession::removeTopic(const std::string& topic) {
+    auto it = std::find(topics.begin(), topics.end(), topic);
+    if (it != topics.end()) {
+        topics.erase(it);
+    }
+}
+
+std::string TutoringSession::getSkillsGained() const { return skillsGained; }
+void TutoringSession::setSkillsGained(const std::string& skills) { skillsGained = skills; }
+
+std::string TutoringSession::getHomeworkAssigned() const { return homeworkAssigned; }
+void TutoringSession::setHomeworkAssigned(const std::string& homework) { homeworkAssigned = homework; }
+
+double TutoringSession::getSessionCost() const { return sessionCost; }
+void TutoringSession::setSessionCost(double cost) { sessionCost = cost; }
+
+std::string TutoringSession::getPaymentStatus() const { return paymentStatus; }
+void TutoringSession::setPaymentStatus(const std::string& status) { paymentStatus = status; }
+
+bool TutoringSession::getIsRemote() const { return isRemote; }
+void TutoringSession::setIsRemote(bool remote) { isRemote = remote; }
+
+std::string TutoringSession::getPlatform() const { return platform; }
+void TutoringSession::setPlatform(const std::string& platform) { this->platform = platform; }
+
+// Utility methods
+void TutoringSession::completeSession(double rating, const std::string& notes,
+                                      const std::string& skillsGained) {
+    status = "Completed";
+    setClientRating(rating);
+    sessionNotes = notes;
+    this->skillsGained = skillsGained;
+}
+
+void TutoringSession::cancelSession(const std::string& reason) {
+    status = "Cancelled";
+    sessionNotes = "Cancelled: " + reason;
+}
+
+std::string TutoringSession::getFormattedDuration() const {
+    std::stringstream ss;
+    ss << std::setw(2) << std::setfill('0') << durationMinutes / 60 << ":"
+       << std::setw(2) << std::setfill('0') << durationMinutes % 60;
+    return ss.str();
+}
+
+// Display methods
+void TutoringSession::displayInfo() const {
+    std::cout << "Session ID: " << sessionId << std::endl;
+    std::cout << "Client ID: " << clientId << std::endl;
+    std::cout << "Tutor ID: " << tutorId << std::endl;
+    std::cout << "Date: " << sessionDate << " " << startTime << std::endl;
+    std::cout << "Duration: " << getFormattedDuration() << std::endl;
+    std::cout << "Status: " << status << std::endl;
+    std::cout << "Mode: " << (isRemote ? "Remote (" + platform + ")" : "In-person") << std::endl;
+    std::cout << "Cost: $" << std::fixed << std::setprecision(2) << sessionCost
+              << " (" << paymentStatus << ")" << std::endl;
+
+    if (status == "Completed") {
+        std::cout << "Client Rating: " << clientRating << std::endl;
+        std::cout << "Skills Gained: " << skillsGained << std::endl;
+    }
+
+    std::cout << "Learning Objectives: " << learningObjectives << std::endl;
+    std::cout << "Notes: " << sessionNotes << std::endl;
+}
+
+void TutoringSession::displayTopics() const {
+    std::cout << "Topics Covered in Session " << sessionId << ":" << std::endl;
+    for (const auto& topic : topics) {
+        std::cout << "- " << topic << std::endl;
+    }
+}
+
+// Operator overloading
+std::ostream& operator<<(std::ostream& os, const TutoringSession& session) {
+    os << "Session ID: " << session.sessionId << std::endl;
+    os << "Client ID: " << session.clientId << std::endl;
+    os << "Tutor ID: " << session.tutorId << std::endl;
+    os << "Date: " << session.sessionDate << " " << session.startTime << std::endl;
+    os << "Duration: " << session.getFormattedDuration() << std::endl;
+    os << "Status: " << session.status << std::endl;
+
+    os << "AI Models: ";
+    for (size_t i = 0; i < session.aiModelIds.size(); i++) {
+        os << session.aiModelIds[i];
+        if (i < session.aiModelIds.size() - 1) {
+            os << ", ";
+        }
+    }
+    os << std::endl;
+
+    return os;
+}
+
+std::istream& operator>>(std::istream& is, TutoringSession& session) {
+    std::cout << "Enter Session ID: ";
+    is >> session.sessionId;
+
+    std::cout << "Enter Client ID: ";
+    is >> session.clientId;
+
+    std::cout << "Enter Tutor ID: ";
+    is >> session.tutorId;
+    is.ignore(); // Clear newline
+
+    std::cout << "Enter Session Date (YYYY-MM-DD): ";
+    std::getline(is, session.sessionDate);
+
+    std::cout << "Enter Start Time (HH:MM): ";
+    std::getline(is, session.startTime);
+
+    std::cout << "Enter Duration (minutes): ";
+    is >> session.durationMinutes;
+    is.ignore(); // Clear newline
+
+    std::cout << "Enter Learning Objectives: ";
+    std::getline(is, session.learningObjectives);
+
+    return is;
+}
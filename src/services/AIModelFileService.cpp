@@ -0,0 +1,208 @@
+#include "include/services/AIModelFileService.h"
+#include "include/utils/Exception.h"
+
+namespace {
+    // Snapshot column order; bump AI_MODEL_SCHEMA_VERSION when it changes
+    enum AIModelColumn {
+        COL_ID, COL_NAME, COL_VERSION, COL_DEVELOPER, COL_CATEGORY,
+        COL_RELEASE_DATE, COL_DESCRIPTION, COL_COMPLEXITY, COL_POPULARITY,
+        COL_TUTORS, COL_DOCUMENTATION, COL_DEPRECATED, COL_CAPABILITIES,
+        COL_LIMITATIONS, COL_USE_CASES, COL_PARAMETER_NAMES,
+        COL_PARAMETER_DESCRIPTIONS, COL_ADDED_PREREQUISITES,
+        COL_REMOVED_PREREQUISITES
+    };
+
+    // Version 1 predates the prerequisite edit columns, and is still read
+    const uint32_t AI_MODEL_SCHEMA_VERSION = 2;
+
+    // Lines written before the prerequisite edits have only the first 16
+    const size_t AI_MODEL_TEXT_FIELDS = 18;
+    const size_t AI_MODEL_REQUIRED_TEXT_FIELDS = 16;
+}
+
+AIModelFileService::AIModelFileService(const std::string& filename, StorageFormat format)
+    : FileService<AIModel>(filename, format) {}
+
+// Text format
+std::string AIModelFileService::serializeObject(const AIModel& model) const {
+    std::vector<std::string> parameters;
+    for (const auto& entry : model.getParameters()) {
+        parameters.push_back(sanitizeField(entry.first, '=') + "=" + entry.second);
+    }
+
+    std::stringstream ss;
+    ss << model.getModelId() << "|"
+       << sanitizeField(model.getName()) << "|"
+       << sanitizeField(model.getVersion()) << "|"
+       << sanitizeField(model.getDeveloper()) << "|"
+       << sanitizeField(model.getCategory()) << "|"
+       << sanitizeField(model.getReleaseDate()) << "|"
+       << sanitizeField(model.getDescription()) << "|"
+       << model.getComplexityLevel() << "|"
+       << model.getPopularityRank() << "|"
+       << model.getTutorsAvailable() << "|"
+       << sanitizeField(model.getDocumentationURL()) << "|"
+       << (model.getIsDeprecated() ? 1 : 0) << "|"
+       << joinFields(model.getCapabilities(), ';') << "|"
+       << joinFields(model.getLimitations(), ';') << "|"
+       << joinFields(model.getUseCases(), ';') << "|"
+       << joinFields(parameters, ';') << "|"
+       << joinInts(model.getAddedPrerequisites(), ';') << "|"
+       << joinInts(model.getRemovedPrerequisites(), ';');
+    return ss.str();
+}
+
+AIModel AIModelFileService::deserializeObject(const std::string& data) const {
+    FieldView fields[AI_MODEL_TEXT_FIELDS];
+    size_t fieldCount = FieldTokenizer(data).split(fields, AI_MODEL_TEXT_FIELDS);
+    if (fieldCount < AI_MODEL_REQUIRED_TEXT_FIELDS) {
+        throw FileException("Invalid AI model data format");
+    }
+
+    AIModel model(parseIntField(fields[0], "model ID"), fields[1].str(), fields[2].str(),
+                  fields[3].str(), fields[4].str(), fields[5].str(), fields[6].str(),
+                  parseIntField(fields[7], "complexity level"));
+    model.setPopularityRank(parseIntField(fields[8], "popularity rank"));
+    model.setTutorsAvailable(parseIntField(fields[9], "tutor count"));
+    model.setDocumentationURL(fields[10].str());
+    model.setIsDeprecated(fields[11] == "1");
+
+    FieldView item;
+    FieldTokenizer capabilities(fields[12], ';');
+    while (capabilities.next(item)) {
+        if (!item.empty()) {
+            model.addCapability(item.str());
+        }
+    }
+
+    FieldTokenizer limitations(fields[13], ';');
+    while (limitations.next(item)) {
+        if (!item.empty()) {
+            model.addLimitation(item.str());
+        }
+    }
+
+    FieldTokenizer useCases(fields[14], ';');
+    while (useCases.next(item)) {
+        if (!item.empty()) {
+            model.addUseCase(item.str());
+        }
+    }
+
+    FieldTokenizer parameters(fields[15], ';');
+    while (parameters.next(item)) {
+        size_t separator = item.find('=');
+        if (separator != FieldView::npos) {
+            model.addParameter(item.substr(0, separator).str(), item.substr(separator + 1).str());
+        }
+    }
+
+    if (fieldCount == AI_MODEL_TEXT_FIELDS) {
+        FieldTokenizer added(fields[16], ';');
+        while (added.next(item)) {
+            if (!item.empty()) {
+                model.addPrerequisite(parseIntField(item, "prerequisite ID"));
+            }
+        }
+
+        FieldTokenizer removed(fields[17], ';');
+        while (removed.next(item)) {
+            if (!item.empty()) {
+                model.removePrerequisite(parseIntField(item, "prerequisite ID"));
+            }
+        }
+    }
+
+    return model;
+}
+
+// Snapshot format
+bool AIModelFileService::supportsSnapshot() const {
+    return true;
+}
+
+uint32_t AIModelFileService::getSnapshotSchemaVersion() const {
+    return AI_MODEL_SCHEMA_VERSION;
+}
+
+bool AIModelFileService::canReadSnapshotSchema(uint32_t version) const {
+    return version >= 1 && version <= AI_MODEL_SCHEMA_VERSION;
+}
+
+void AIModelFileService::encodeRecord(const AIModel& model, SnapshotBuilder& builder) const {
+    std::vector<std::string> names;
+    std::vector<std::string> descriptions;
+    for (const auto& entry : model.getParameters()) {
+        names.push_back(entry.first);
+        descriptions.push_back(entry.second);
+    }
+
+    builder.putInt(model.getModelId());
+    builder.putString(model.getName());
+    builder.putString(model.getVersion());
+    builder.putString(model.getDeveloper());
+    builder.putString(model.getCategory());
+    builder.putString(model.getReleaseDate());
+    builder.putString(model.getDescription());
+    builder.putInt(model.getComplexityLevel());
+    builder.putInt(model.getPopularityRank());
+    builder.putInt(model.getTutorsAvailable());
+    builder.putString(model.getDocumentationURL());
+    builder.putInt(model.getIsDeprecated() ? 1 : 0);
+    builder.putStringList(model.getCapabilities());
+    builder.putStringList(model.getLimitations());
+    builder.putStringList(model.getUseCases());
+    builder.putStringList(names);
+    builder.putStringList(descriptions);
+    builder.putIntList(model.getAddedPrerequisites());
+    builder.putIntList(model.getRemovedPrerequisites());
+}
+
+AIModel AIModelFileService::decodeRecord(const SnapshotView& view, size_t row) const {
+    AIModel model(static_cast<int>(view.getInt(COL_ID, row)),
+                  view.getString(COL_NAME, row),
+                  view.getString(COL_VERSION, row),
+                  view.getString(COL_DEVELOPER, row),
+                  view.getString(COL_CATEGORY, row),
+                  view.getString(COL_RELEASE_DATE, row),
+                  view.getString(COL_DESCRIPTION, row),
+                  static_cast<int>(view.getInt(COL_COMPLEXITY, row)));
+    model.setPopularityRank(static_cast<int>(view.getInt(COL_POPULARITY, row)));
+    model.setTutorsAvailable(static_cast<int>(view.getInt(COL_TUTORS, row)));
+    model.setDocumentationURL(view.getString(COL_DOCUMENTATION, row));
+    model.setIsDeprecated(view.getInt(COL_DEPRECATED, row) != 0);
+
+    size_t capabilities = view.getListSize(COL_CAPABILITIES, row);
+    for (size_t i = 0; i < capabilities; i++) {
+        model.addCapability(view.getStringListItem(COL_CAPABILITIES, row, i));
+    }
+
+    size_t limitations = view.getListSize(COL_LIMITATIONS, row);
+    for (size_t i = 0; i < limitations; i++) {
+        model.addLimitation(view.getStringListItem(COL_LIMITATIONS, row, i));
+    }
+
+    size_t useCases = view.getListSize(COL_USE_CASES, row);
+    for (size_t i = 0; i < useCases; i++) {
+        model.addUseCase(view.getStringListItem(COL_USE_CASES, row, i));
+    }
+
+    size_t parameters = view.getListSize(COL_PARAMETER_NAMES, row);
+    for (size_t i = 0; i < parameters; i++) {
+        model.addParameter(view.getStringListItem(COL_PARAMETER_NAMES, row, i),
+                           view.getStringListItem(COL_PARAMETER_DESCRIPTIONS, row, i));
+    }
+
+    if (view.getSchemaVersion() >= 2) {
+        size_t added = view.getListSize(COL_ADDED_PREREQUISITES, row);
+        for (size_t i = 0; i < added; i++) {
+            model.addPrerequisite(static_cast<int>(view.getIntListItem(COL_ADDED_PREREQUISITES, row, i)));
+        }
+        size_t removed = view.getListSize(COL_REMOVED_PREREQUISITES, row);
+        for (size_t i = 0; i < removed; i++) {
+            model.removePrerequisite(static_cast<int>(view.getIntListItem(COL_REMOVED_PREREQUISITES, row, i)));
+        }
+    }
+
+    return model;
+}
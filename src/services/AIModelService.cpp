@@ -1,11 +1,68 @@
 #include "include/services/AIModelService.h"
 #include "include/utils/Logger.h"
 #include "include/utils/Exception.h"
+#include "include/utils/SymbolTable.h"
 #include <algorithm>
 #include <iostream>
+#include <limits>
+#include <iterator>
+
+namespace {
+    // Journal record types. Records carry resulting values, not deltas,
+    // so replaying one that is already in the snapshot is harmless.
+    enum AIModelJournalOp : uint8_t {
+        OP_UPSERT = 1,          // fields: serialized model
+        OP_REMOVE,              // no fields
+        OP_DETAILS,             // fields: name, version, developer, category, description
+        OP_ADD_CAPABILITY,      // fields: capability
+        OP_REMOVE_CAPABILITY,   // fields: capability
+        OP_ADD_LIMITATION,      // fields: limitation
+        OP_REMOVE_LIMITATION,   // fields: limitation
+        OP_ADD_USE_CASE,        // fields: use case
+        OP_REMOVE_USE_CASE,     // fields: use case
+        OP_ADD_PARAMETER,       // fields: parameter, description
+        OP_REMOVE_PARAMETER,    // fields: parameter
+        OP_COMPLEXITY,          // fields: level
+        OP_POPULARITY,          // fields: rank
+        OP_TUTORS,              // fields: count
+        OP_DEPRECATED,          // fields: "1" or "0"
+        OP_DOCUMENTATION,       // fields: url
+        OP_ADD_PREREQUISITE,    // fields: prerequisite ID
+        OP_REMOVE_PREREQUISITE, // fields: prerequisite ID
+        OP_FORGET_PREREQUISITE  // fields: prerequisite ID
+    };
+
+    bool contains(const std::vector<std::string>& values, const std::string& value) {
+        return std::find(values.begin(), values.end(), value) != values.end();
+    }
+    
+    // Past this many cached learning paths, an arbitrary one is dropped for
+    // each new one
+    const size_t MAX_CACHED_LEARNING_PATHS = 10000;
+    
+    // Everything about a model that says what it is for
+    std::string similarityText(const AIModel& model) {
+        std::string text = model.getCategory() + " " + model.getDescription();
+        for (const auto* values : {&model.getCapabilities(), &model.getLimitations(), &model.getUseCases()}) {
+            for (const auto& value : *values) {
+                text += " " + value;
+            }
+        }
+        return text;
+    }
+}
 
 // Constructor
-AIModelService::AIModelService() : nextModelId(1) {
+AIModelService::AIModelService(const ShardLayout& layout)
+    : aiModels("data/aimodels", layout, [](const AIModel& model) { return model.getModelId(); },
+               [this](int modelId) { return buildUpsertRecord(modelId); }, OP_REMOVE),
+      nextModelId(1), popularityLeaderboard(), popularityLeaderboardBuilt(false),
+      modelsByCategoryLevel(), modelsByDeveloper(), modelsByComplexity(), modelsEditingPrerequisite(),
+      modelsRemovingPrerequisites(), secondaryIndexesBuilt(false),
+      prerequisiteGraph(), prerequisiteGraphBuilt(false), prerequisiteLevelHubs(), nextPrerequisiteHubId(-1),
+      prerequisiteCycleCheckPending(false), prerequisiteGraphStale(false), prerequisiteEditsSkipped(false),
+      learningPathCache(), learningPathCacheStats(), modelSimilarity(), modelSimilarityBuilt(false),
+      modificationVersion(0), countMemo(), figureMemo() {
     loadAIModels();
 }
 
@@ -14,11 +71,25 @@ AIModelService::~AIModelService() {
     saveAIModels();
 }
 
-// Load AI models from file (stub implementation)
+// Load the last snapshots (seeding sample data if none have been saved yet),
+// then replay the journals on top of them. Files are only mapped and indexed
+// by ID; models are decoded from them as they are first accessed.
 void AIModelService::loadAIModels() {
-    // In a real implementation, this would load from a file
-    // For now, we'll create some sample AI models for testing
+    if (!aiModels.exists()) {
+        seedSampleModels();
+    }
+    
+    size_t replayed = aiModels.load([this](const JournalRecord& record) {
+        applyJournalRecord(record);
+    });
+    nextModelId = std::max(nextModelId, aiModels.getMaxId() + 1);
     
+    Logger::getInstance().info("Loaded " + std::to_string(aiModels.size()) + " AI models (" +
+                              std::to_string(replayed) + " journal records replayed)");
+}
+
+// Create some sample AI models for testing
+void AIModelService::seedSampleModels() {
     // GPT-4
     auto gpt4 = std::make_shared<AIModel>(
         1, "GPT-4", "4.0", 
@@ -99,272 +170,627 @@ void AIModelService::loadAIModels() {
     claude->setDocumentationURL("https://www.anthropic.com/claude");
     
     // Add models to collection
-    aiModels.push_back(gpt4);
-    aiModels.push_back(dalle3);
-    aiModels.push_back(claude);
+    aiModels.put(gpt4->getModelId(), gpt4);
+    aiModels.put(dalle3->getModelId(), dalle3);
+    aiModels.put(claude->getModelId(), claude);
     
     nextModelId = 4; // Set next ID after creating sample models
-    
-    Logger::getInstance().info("Loaded " + std::to_string(aiModels.size()) + " AI models");
 }
 
-// Save AI models to file (stub implementation)
+// Save every shard; once its snapshot is written its journal is redundant
 void AIModelService::saveAIModels() {
-    // In a real implementation, this would save to a file
+    if (!aiModels.save()) {
+        Logger::getInstance().error("Failed to save AI models");
+        return;
+    }
     Logger::getInstance().info("Saved " + std::to_string(aiModels.size()) + " AI models");
 }
 
+// Append a single mutation instead of rewriting the whole catalog
+void AIModelService::recordMutation(uint8_t type, int modelId, const std::vector<std::string>& fields) {
+    aiModels.recordMutation(type, modelId, fields);
+    modificationVersion++;
+}
+
+// Full current state of one model, used when flushing deferred mutations
+JournalRecord AIModelService::buildUpsertRecord(int modelId) const {
+    auto model = getModelById(modelId);
+    if (!model) {
+        return JournalRecord(OP_REMOVE, modelId);
+    }
+    return JournalRecord(OP_UPSERT, modelId, {aiModels.getFiles().serialize(*model)});
+}
+
+void AIModelService::applyJournalRecord(const JournalRecord& record) {
+    if (record.type == OP_UPSERT) {
+        if (record.fields.empty()) {
+            return;
+        }
+        aiModels.put(record.id, std::make_shared<AIModel>(aiModels.getFiles().deserialize(record.fields[0])));
+        nextModelId = std::max(nextModelId, record.id + 1);
+        return;
+    }
+    
+    if (record.type == OP_REMOVE) {
+        aiModels.remove(record.id);
+        return;
+    }
+    
+    auto model = aiModels.getForWrite(record.id);
+    if (!model) {
+        return;
+    }
+    aiModels.markDirty(record.id);
+    
+    // Additions are skipped when already present so a replay is idempotent
+    const auto& fields = record.fields;
+    switch (record.type) {
+        case OP_DETAILS:
+            if (fields.size() >= 5) {
+                // Redo the rename in the symbol table, so profile rows still
+                // holding the old name resolve to this model
+                if (fields[0] != model->getName() && !SymbolTable::aiModels().rename(model->getName(), fields[0])) {
+                    Logger::getInstance().warning("Replayed rename of AI model " + model->getName() + " to " +
+                                                  fields[0] + " clashes with another model");
+                }
+                model->setName(fields[0]);
+                model->setVersion(fields[1]);
+                model->setDeveloper(fields[2]);
+                model->setCategory(fields[3]);
+                model->setDescription(fields[4]);
+            }
+            break;
+        case OP_ADD_CAPABILITY:
+            if (!fields.empty() && !contains(model->getCapabilities(), fields[0])) {
+                model->addCapability(fields[0]);
+            }
+            break;
+        case OP_REMOVE_CAPABILITY:
+            if (!fields.empty()) {
+                model->removeCapability(fields[0]);
+            }
+            break;
+        case OP_ADD_LIMITATION:
+            if (!fields.empty() && !contains(model->getLimitations(), fields[0])) {
+                model->addLimitation(fields[0]);
+            }
+            break;
+        case OP_REMOVE_LIMITATION:
+            if (!fields.empty()) {
+                model->removeLimitation(fields[0]);
+            }
+            break;
+        case OP_ADD_USE_CASE:
+            if (!fields.empty() && !contains(model->getUseCases(), fields[0])) {
+                model->addUseCase(fields[0]);
+            }
+            break;
+        case OP_REMOVE_USE_CASE:
+            if (!fields.empty()) {
+                model->removeUseCase(fields[0]);
+            }
+            break;
+        case OP_ADD_PARAMETER:
+            if (fields.size() >= 2) {
+                model->addParameter(fields[0], fields[1]);
+            }
+            break;
+        case OP_REMOVE_PARAMETER:
+            if (!fields.empty()) {
+                model->removeParameter(fields[0]);
+            }
+            break;
+        case OP_COMPLEXITY:
+            if (!fields.empty()) {
+                model->setComplexityLevel(std::stoi(fields[0]));
+            }
+            break;
+        case OP_POPULARITY:
+            if (!fields.empty()) {
+                model->setPopularityRank(std::stoi(fields[0]));
+            }
+            break;
+        case OP_TUTORS:
+            if (!fields.empty()) {
+                model->setTutorsAvailable(std::stoi(fields[0]));
+            }
+            break;
+        case OP_DEPRECATED:
+            if (!fields.empty()) {
+                model->setIsDeprecated(fields[0] == "1");
+            }
+            break;
+        case OP_DOCUMENTATION:
+            if (!fields.empty()) {
+                model->setDocumentationURL(fields[0]);
+            }
+            break;
+        case OP_ADD_PREREQUISITE:
+            if (!fields.empty()) {
+                model->addPrerequisite(std::stoi(fields[0]));
+            }
+            break;
+        case OP_REMOVE_PREREQUISITE:
+            if (!fields.empty()) {
+                model->removePrerequisite(std::stoi(fields[0]));
+            }
+            break;
+        case OP_FORGET_PREREQUISITE:
+            if (!fields.empty()) {
+                model->forgetPrerequisite(std::stoi(fields[0]));
+            }
+            break;
+        default:
+            Logger::getInstance().warning("Skipping unknown AI model journal record type " +
+                                          std::to_string(record.type));
+            break;
+    }
+}
+
+void AIModelService::setJournalSyncPolicy(JournalSyncPolicy policy, int intervalMs) {
+    aiModels.setJournalSyncPolicy(policy, intervalMs);
+}
+
+void AIModelService::setCompactionThresholds(size_t maxRecords, uint64_t maxBytes) {
+    aiModels.setCompactionThresholds(maxRecords, maxBytes);
+}
+
+CompactionStats AIModelService::getCompactionStats() const {
+    return aiModels.getCompactionStats();
+}
+
+const ShardLayout& AIModelService::getShardLayout() const {
+    return aiModels.getLayout();
+}
+
+void AIModelService::setDeferredPersistence(bool enabled, int flushIntervalMs) {
+    aiModels.setDeferred(enabled, flushIntervalMs);
+}
+
+bool AIModelService::flush() {
+    return aiModels.flush();
+}
+
+void AIModelService::beginTransaction() {
+    aiModels.beginTransaction();
+}
+
+bool AIModelService::commitTransaction() {
+    return aiModels.commitTransaction();
+}
+
+PersistenceStats AIModelService::getPersistenceStats() const {
+    return aiModels.getPersistenceStats();
+}
+
+void AIModelService::setResidentLimit(size_t maxModels) {
+    aiModels.setResidentLimit(maxModels);
+}
+
+RecordCacheStats AIModelService::getCacheStats() const {
+    return aiModels.getCacheStats();
+}
+
 // Model management methods
 bool AIModelService::addAIModel(std::shared_ptr<AIModel> model) {
-    // Set model ID if not already set
+    // Set model ID if not already set; a caller-supplied ID is reserved
     if (model->getModelId() == 0) {
         model->setModelId(nextModelId++);
+    } else {
+        nextModelId = std::max(nextModelId, model->getModelId() + 1);
     }
     
-    aiModels.push_back(model);
-    saveAIModels();
+    if (auto existing = aiModels.get(model->getModelId())) {
+        unindexModel(*existing);
+        unlinkPrerequisites(*existing);
+    }
+    aiModels.put(model->getModelId(), model);
+    indexModel(*model);
+    linkPrerequisites(*model);
+    vectorizeModel(*model);
+    if (popularityLeaderboardBuilt) {
+        popularityLeaderboard.set(model->getModelId(), model->getPopularityRank());
+    }
+    recordMutation(OP_UPSERT, model->getModelId(), {aiModels.getFiles().serialize(*model)});
     
     Logger::getInstance().info("Added new AI model: " + model->getName());
     return true;
 }
 
 bool AIModelService::removeAIModel(int modelId) {
-    auto it = std::find_if(aiModels.begin(), aiModels.end(), 
-        [modelId](const std::shared_ptr<AIModel>& model) {
-            return model->getModelId() == modelId;
-        });
-    
-    if (it != aiModels.end()) {
-        Logger::getInstance().info("Removed AI model: " + (*it)->getName());
-        aiModels.erase(it);
-        saveAIModels();
-        return true;
+    auto model = aiModels.get(modelId);
+    if (!model) {
+        return false;
     }
     
-    return false;
+    Logger::getInstance().info("Removed AI model: " + model->getName());
+    unindexModel(*model);
+    unlinkPrerequisites(*model);
+    modelSimilarity.remove(modelId);
+    aiModels.remove(modelId);
+    popularityLeaderboard.remove(modelId);
+    recordMutation(OP_REMOVE, modelId);
+    
+    // Edits naming the model no longer apply
+    buildSecondaryIndexes();
+    auto editing = modelsEditingPrerequisite.find(modelId);
+    if (editing != modelsEditingPrerequisite.end()) {
+        std::set<int> dependentIds = editing->second;
+        for (int dependentId : dependentIds) {
+            auto dependent = aiModels.getForWrite(dependentId);
+            unindexModel(*dependent);
+            dependent->forgetPrerequisite(modelId);
+            indexModel(*dependent);
+            relinkPrerequisites(*dependent);
+            recordMutation(OP_FORGET_PREREQUISITE, dependentId, {std::to_string(modelId)});
+        }
+    }
+    return true;
 }
 
 bool AIModelService::updateAIModel(int modelId, const std::string& name, 
                                  const std::string& version, const std::string& developer,
                                  const std::string& category, const std::string& description) {
-    auto model = getModelById(modelId);
+    auto model = aiModels.getForWrite(modelId);
     if (!model) {
         return false;
     }
     
+    // Client and tutor profiles hold the interned name, so one symbol table
+    // update carries a rename to all of them. Profiles may not have read the
+    // other model's name yet, so the catalog is checked as well.
+    if (name != model->getName() &&
+        (getModelByName(name) || !SymbolTable::aiModels().rename(model->getName(), name))) {
+        Logger::getInstance().warning("AI model name " + name + " is already in use; " +
+                                      model->getName() + " was not updated");
+        return false;
+    }
+    // Only a category change moves the model in the prerequisite graph
+    bool moved = category != model->getCategory();
+    unindexModel(*model);
+    if (moved) {
+        unlinkPrerequisites(*model);
+    }
     model->setName(name);
     model->setVersion(version);
     model->setDeveloper(developer);
     model->setCategory(category);
     model->setDescription(description);
+    indexModel(*model);
+    if (moved) {
+        linkPrerequisites(*model);
+    }
+    vectorizeModel(*model);
     
-    saveAIModels();
+    recordMutation(OP_DETAILS, modelId, {name, version, developer, category, description});
     Logger::getInstance().info("Updated AI model: " + model->getName());
     return true;
 }
 
-// Model retrieval methods
-std::shared_ptr<AIModel> AIModelService::getModelById(int modelId) const {
+// Secondary index maintenance. Until the first lookup there is nothing to
+// maintain; the indexes are then built from the current records.
+void AIModelService::buildSecondaryIndexes() const {
+    if (secondaryIndexesBuilt) {
+        return;
+    }
+    
     for (const auto& model : aiModels) {
-        if (model->getModelId() == modelId) {
-            return model;
+        int modelId = model->getModelId();
+        modelsByCategoryLevel[model->getCategory()].insert(std::make_pair(model->getComplexityLevel(), modelId));
+        modelsByDeveloper[model->getDeveloper()].insert(modelId);
+        modelsByComplexity[model->getComplexityLevel()].insert(modelId);
+        for (const auto* edits : {&model->getAddedPrerequisites(), &model->getRemovedPrerequisites()}) {
+            for (int prerequisiteId : *edits) {
+                modelsEditingPrerequisite[prerequisiteId].insert(modelId);
+            }
+        }
+        if (!model->getRemovedPrerequisites().empty()) {
+            modelsRemovingPrerequisites[std::make_pair(model->getCategory(), model->getComplexityLevel())].insert(modelId);
         }
     }
-    return nullptr;
+    secondaryIndexesBuilt = true;
 }
 
-std::shared_ptr<AIModel> AIModelService::getModelByName(const std::string& name) const {
-    for (const auto& model : aiModels) {
-        if (model->getName() == name) {
-            return model;
+void AIModelService::indexModel(const AIModel& model) {
+    if (secondaryIndexesBuilt) {
+        int modelId = model.getModelId();
+        modelsByCategoryLevel[model.getCategory()].insert(std::make_pair(model.getComplexityLevel(), modelId));
+        modelsByDeveloper[model.getDeveloper()].insert(modelId);
+        modelsByComplexity[model.getComplexityLevel()].insert(modelId);
+        for (const auto* edits : {&model.getAddedPrerequisites(), &model.getRemovedPrerequisites()}) {
+            for (int prerequisiteId : *edits) {
+                modelsEditingPrerequisite[prerequisiteId].insert(modelId);
+            }
+        }
+        if (!model.getRemovedPrerequisites().empty()) {
+            modelsRemovingPrerequisites[std::make_pair(model.getCategory(), model.getComplexityLevel())].insert(modelId);
         }
     }
-    return nullptr;
 }
 
-std::vector<std::shared_ptr<AIModel>> AIModelService::getAllModels() const {
-    return aiModels;
+// Call with the model's fields as they were indexed, i.e. before changing them
+void AIModelService::unindexModel(const AIModel& model) {
+    if (!secondaryIndexesBuilt) {
+        return;
+    }
+    
+    int modelId = model.getModelId();
+    auto category = modelsByCategoryLevel.find(model.getCategory());
+    if (category != modelsByCategoryLevel.end()) {
+        category->second.erase(std::make_pair(model.getComplexityLevel(), modelId));
+        if (category->second.empty()) {
+            modelsByCategoryLevel.erase(category);
+        }
+    }
+    auto developer = modelsByDeveloper.find(model.getDeveloper());
+    if (developer != modelsByDeveloper.end()) {
+        developer->second.erase(modelId);
+        if (developer->second.empty()) {
+            modelsByDeveloper.erase(developer);
+        }
+    }
+    auto complexity = modelsByComplexity.find(model.getComplexityLevel());
+    if (complexity != modelsByComplexity.end()) {
+        complexity->second.erase(modelId);
+        if (complexity->second.empty()) {
+            modelsByComplexity.erase(complexity);
+        }
+    }
+    for (const auto* edits : {&model.getAddedPrerequisites(), &model.getRemovedPrerequisites()}) {
+        for (int prerequisiteId : *edits) {
+            auto editing = modelsEditingPrerequisite.find(prerequisiteId);
+            if (editing != modelsEditingPrerequisite.end()) {
+                editing->second.erase(modelId);
+                if (editing->second.empty()) {
+                    modelsEditingPrerequisite.erase(editing);
+                }
+            }
+        }
+    }
+    auto removing = modelsRemovingPrerequisites.find(std::make_pair(model.getCategory(), model.getComplexityLevel()));
+    if (removing != modelsRemovingPrerequisites.end()) {
+        removing->second.erase(modelId);
+        if (removing->second.empty()) {
+            modelsRemovingPrerequisites.erase(removing);
+        }
+    }
 }
 
-std::vector<std::shared_ptr<AIModel>> AIModelService::getModelsByCategory(const std::string& category) const {
+std::vector<std::shared_ptr<AIModel>> AIModelService::resolveModels(const std::set<int>& modelIds) const {
     std::vector<std::shared_ptr<AIModel>> results;
-    
-    for (const auto& model : aiModels) {
-        if (model->getCategory() == category) {
+    results.reserve(modelIds.size());
+    for (int modelId : modelIds) {
+        if (auto model = aiModels.get(modelId)) {
             results.push_back(model);
         }
     }
-    
     return results;
 }
 
-std::vector<std::shared_ptr<AIModel>> AIModelService::getModelsByDeveloper(const std::string& developer) const {
+std::vector<std::shared_ptr<AIModel>> AIModelService::resolveModels(const std::vector<int>& modelIds) const {
     std::vector<std::shared_ptr<AIModel>> results;
-    
-    for (const auto& model : aiModels) {
-        if (model->getDeveloper() == developer) {
+    results.reserve(modelIds.size());
+    for (int modelId : modelIds) {
+        if (auto model = aiModels.get(modelId)) {
             results.push_back(model);
         }
     }
-    
     return results;
 }
 
-std::vector<std::shared_ptr<AIModel>> AIModelService::getModelsByComplexity(int complexityLevel) const {
+// Models for a run of (complexity, ID) entries of the category index
+std::vector<std::shared_ptr<AIModel>> AIModelService::resolveModels(
+        std::set<std::pair<int, int>>::const_iterator first,
+        std::set<std::pair<int, int>>::const_iterator last) const {
     std::vector<std::shared_ptr<AIModel>> results;
-    
-    for (const auto& model : aiModels) {
-        if (model->getComplexityLevel() == complexityLevel) {
+    for (; first != last; ++first) {
+        if (auto model = aiModels.get(first->second)) {
             results.push_back(model);
         }
     }
-    
     return results;
 }
 
+// Model retrieval methods
+std::shared_ptr<AIModel> AIModelService::getModelById(int modelId) const {
+    return aiModels.get(modelId);
+}
+
+std::shared_ptr<AIModel> AIModelService::getModelByName(const std::string& name) const {
+    for (const auto& model : aiModels) {
+        if (model->getName() == name) {
+            return model;
+        }
+    }
+    return nullptr;
+}
+
+std::vector<std::shared_ptr<AIModel>> AIModelService::getAllModels() const {
+    return aiModels.getAll();
+}
+
+std::vector<std::shared_ptr<AIModel>> AIModelService::getModelsByCategory(const std::string& category) const {
+    buildSecondaryIndexes();
+    auto it = modelsByCategoryLevel.find(category);
+    if (it == modelsByCategoryLevel.end()) {
+        return {};
+    }
+    return resolveModels(it->second.begin(), it->second.end());
+}
+
+std::vector<std::shared_ptr<AIModel>> AIModelService::getModelsByDeveloper(const std::string& developer) const {
+    buildSecondaryIndexes();
+    auto it = modelsByDeveloper.find(developer);
+    return it != modelsByDeveloper.end() ? resolveModels(it->second) : std::vector<std::shared_ptr<AIModel>>();
+}
+
+std::vector<std::shared_ptr<AIModel>> AIModelService::getModelsByComplexity(int complexityLevel) const {
+    buildSecondaryIndexes();
+    auto it = modelsByComplexity.find(complexityLevel);
+    return it != modelsByComplexity.end() ? resolveModels(it->second) : std::vector<std::shared_ptr<AIModel>>();
+}
+
 // Model attributes management
 bool AIModelService::addModelCapability(int modelId, const std::string& capability) {
-    auto model = getModelById(modelId);
+    auto model = aiModels.getForWrite(modelId);
     if (!model) {
         return false;
     }
     
     model->addCapability(capability);
-    saveAIModels();
+    vectorizeModel(*model);
+    recordMutation(OP_ADD_CAPABILITY, modelId, {capability});
     return true;
 }
 
 bool AIModelService::removeModelCapability(int modelId, const std::string& capability) {
-    auto model = getModelById(modelId);
+    auto model = aiModels.getForWrite(modelId);
     if (!model) {
         return false;
     }
     
     model->removeCapability(capability);
-    saveAIModels();
+    vectorizeModel(*model);
+    recordMutation(OP_REMOVE_CAPABILITY, modelId, {capability});
     return true;
 }
 
 bool AIModelService::addModelLimitation(int modelId, const std::string& limitation) {
-    auto model = getModelById(modelId);
+    auto model = aiModels.getForWrite(modelId);
     if (!model) {
         return false;
     }
     
     model->addLimitation(limitation);
-    saveAIModels();
+    vectorizeModel(*model);
+    recordMutation(OP_ADD_LIMITATION, modelId, {limitation});
     return true;
 }
 
 bool AIModelService::removeModelLimitation(int modelId, const std::string& limitation) {
-    auto model = getModelById(modelId);
+    auto model = aiModels.getForWrite(modelId);
     if (!model) {
         return false;
     }
     
     model->removeLimitation(limitation);
-    saveAIModels();
+    vectorizeModel(*model);
+    recordMutation(OP_REMOVE_LIMITATION, modelId, {limitation});
     return true;
 }
 
 bool AIModelService::addModelUseCase(int modelId, const std::string& useCase) {
-    auto model = getModelById(modelId);
+    auto model = aiModels.getForWrite(modelId);
     if (!model) {
         return false;
     }
     
     model->addUseCase(useCase);
-    saveAIModels();
+    vectorizeModel(*model);
+    recordMutation(OP_ADD_USE_CASE, modelId, {useCase});
     return true;
 }
 
 bool AIModelService::removeModelUseCase(int modelId, const std::string& useCase) {
-    auto model = getModelById(modelId);
+    auto model = aiModels.getForWrite(modelId);
     if (!model) {
         return false;
     }
     
     model->removeUseCase(useCase);
-    saveAIModels();
+    vectorizeModel(*model);
+    recordMutation(OP_REMOVE_USE_CASE, modelId, {useCase});
     return true;
 }
 
 bool AIModelService::addModelParameter(int modelId, const std::string& param, const std::string& description) {
-    auto model = getModelById(modelId);
+    auto model = aiModels.getForWrite(modelId);
     if (!model) {
         return false;
     }
     
     model->addParameter(param, description);
-    saveAIModels();
+    recordMutation(OP_ADD_PARAMETER, modelId, {param, description});
     return true;
 }
 
 bool AIModelService::removeModelParameter(int modelId, const std::string& param) {
-    auto model = getModelById(modelId);
+    auto model = aiModels.getForWrite(modelId);
     if (!model) {
         return false;
     }
     
     model->removeParameter(param);
-    saveAIModels();
+    recordMutation(OP_REMOVE_PARAMETER, modelId, {param});
     return true;
 }
 
 // Model status management
 bool AIModelService::updateModelComplexity(int modelId, int level) {
-    auto model = getModelById(modelId);
+    auto model = aiModels.getForWrite(modelId);
     if (!model) {
         return false;
     }
     
+    bool moved = level != model->getComplexityLevel();
+    unindexModel(*model);
+    if (moved) {
+        unlinkPrerequisites(*model);
+    }
     model->setComplexityLevel(level);
-    saveAIModels();
+    indexModel(*model);
+    if (moved) {
+        linkPrerequisites(*model);
+    }
+    recordMutation(OP_COMPLEXITY, modelId, {std::to_string(model->getComplexityLevel())});
     return true;
 }
 
 bool AIModelService::updateModelPopularity(int modelId, int rank) {
-    auto model = getModelById(modelId);
+    auto model = aiModels.getForWrite(modelId);
     if (!model) {
         return false;
     }
     
     model->setPopularityRank(rank);
-    saveAIModels();
+    if (popularityLeaderboardBuilt) {
+        popularityLeaderboard.set(modelId, rank);
+    }
+    recordMutation(OP_POPULARITY, modelId, {std::to_string(rank)});
     return true;
 }
 
 bool AIModelService::updateTutorsAvailable(int modelId, int count) {
-    auto model = getModelById(modelId);
+    auto model = aiModels.getForWrite(modelId);
     if (!model) {
         return false;
     }
     
     model->setTutorsAvailable(count);
-    saveAIModels();
+    recordMutation(OP_TUTORS, modelId, {std::to_string(count)});
     return true;
 }
 
 bool AIModelService::markModelAsDeprecated(int modelId, bool deprecated) {
-    auto model = getModelById(modelId);
+    auto model = aiModels.getForWrite(modelId);
     if (!model) {
         return false;
     }
     
     model->setIsDeprecated(deprecated);
-    saveAIModels();
+    recordMutation(OP_DEPRECATED, modelId, {deprecated ? "1" : "0"});
     return true;
 }
 
 // Documentation management
 bool AIModelService::updateModelDocumentation(int modelId, const std::string& url) {
-    auto model = getModelById(modelId);
+    auto model = aiModels.getForWrite(modelId);
     if (!model) {
         return false;
     }
     
     model->setDocumentationURL(url);
-    saveAIModels();
+    recordMutation(OP_DOCUMENTATION, modelId, {url});
     return true;
 }
 
@@ -378,39 +804,56 @@ std::string AIModelService::getModelDocumentation(int modelId) const {
 }
 
 // Analytics methods
+void AIModelService::buildPopularityLeaderboard() const {
+    if (popularityLeaderboardBuilt) {
+        return;
+    }
+    
+    for (const auto& model : aiModels) {
+        popularityLeaderboard.set(model->getModelId(), model->getPopularityRank());
+    }
+    popularityLeaderboardBuilt = true;
+}
+
 std::vector<std::shared_ptr<AIModel>> AIModelService::getMostPopularModels(int count) const {
-    // Create a copy of the models
-    auto sortedModels = aiModels;
+    if (count <= 0) {
+        return {};
+    }
     
-    // Sort by popularity rank (ascending)
-    std::sort(sortedModels.begin(), sortedModels.end(),
-              [](const std::shared_ptr<AIModel>& a, const std::shared_ptr<AIModel>& b) {
-                  return a->getPopularityRank() < b->getPopularityRank();
-              });
+    // Lowest popularity rank first; ties go to the lower model ID
+    buildPopularityLeaderboard();
     
-    // Return the requested number (or all if count is larger)
-    int resultCount = std::min(static_cast<int>(sortedModels.size()), count);
-    return std::vector<std::shared_ptr<AIModel>>(sortedModels.begin(), sortedModels.begin() + resultCount);
+    std::vector<std::shared_ptr<AIModel>> results;
+    for (int modelId : popularityLeaderboard.top(static_cast<size_t>(count))) {
+        if (auto model = aiModels.get(modelId)) {
+            results.push_back(model);
+        }
+    }
+    return results;
 }
 
 std::map<std::string, int> AIModelService::getModelCategoryCounts() const {
-    std::map<std::string, int> categoryCounts;
-    
-    for (const auto& model : aiModels) {
-        categoryCounts[model->getCategory()]++;
-    }
-    
-    return categoryCounts;
+    return countMemo.get("categoryCounts", modificationVersion, [this]() {
+        buildSecondaryIndexes();
+        
+        std::map<std::string, int> categoryCounts;
+        for (const auto& entry : modelsByCategoryLevel) {
+            categoryCounts[entry.first] = static_cast<int>(entry.second.size());
+        }
+        return categoryCounts;
+    });
 }
 
 std::map<std::string, int> AIModelService::getDeveloperModelCounts() const {
-    std::map<std::string, int> developerCounts;
-    
-    for (const auto& model : aiModels) {
-        developerCounts[model->getDeveloper()]++;
-    }
-    
-    return developerCounts;
+    return countMemo.get("developerCounts", modificationVersion, [this]() {
+        buildSecondaryIndexes();
+        
+        std::map<std::string, int> developerCounts;
+        for (const auto& entry : modelsByDeveloper) {
+            developerCounts[entry.first] = static_cast<int>(entry.second.size());
+        }
+        return developerCounts;
+    });
 }
 
 double AIModelService::getAverageModelComplexity() const {
@@ -418,72 +861,409 @@ double AIModelService::getAverageModelComplexity() const {
         return 0.0;
     }
     
-    double totalComplexity = 0.0;
-    for (const auto& model : aiModels) {
-        totalComplexity += model->getComplexityLevel();
+    return figureMemo.get("averageComplexity", modificationVersion, [this]() {
+        double totalComplexity = 0.0;
+        for (const auto& model : aiModels) {
+            totalComplexity += model->getComplexityLevel();
+        }
+        
+        return totalComplexity / aiModels.size();
+    });
+}
+
+uint64_t AIModelService::getModificationVersion() const {
+    return modificationVersion;
+}
+
+MemoStats AIModelService::getAnalyticsMemoStats() const {
+    MemoStats stats = countMemo.getStats();
+    stats += figureMemo.getStats();
+    return stats;
+}
+
+// Prerequisite graph, seeded on first use and then kept up to date as
+// models are added, removed or moved to another level
+void AIModelService::buildPrerequisiteGraph() const {
+    if (prerequisiteGraphBuilt) {
+        bool cyclic = prerequisiteCycleCheckPending && !prerequisiteGraph.isAcyclic();
+        prerequisiteCycleCheckPending = false;
+        if (!cyclic && !prerequisiteGraphStale) {
+            return;
+        }
+        Logger::getInstance().warning("Reseeding the prerequisite graph: a level change conflicts with an edit");
+        prerequisiteGraph.clear();
+        prerequisiteLevelHubs.clear();
+        nextPrerequisiteHubId = -1;
     }
     
-    return totalComplexity / aiModels.size();
+    // Categories go in name order, so the same edits lose to a cycle on
+    // every reseed. Entries are ordered by complexity, so each level is
+    // linked after the whole level below it.
+    buildSecondaryIndexes();
+    std::vector<const std::string*> categories;
+    for (const auto& category : modelsByCategoryLevel) {
+        categories.push_back(&category.first);
+    }
+    std::sort(categories.begin(), categories.end(),
+              [](const std::string* a, const std::string* b) { return *a < *b; });
+    
+    prerequisiteGraphBuilt = true;
+    prerequisiteEditsSkipped = false;
+    for (const std::string* category : categories) {
+        for (const auto& entry : modelsByCategoryLevel.at(*category)) {
+            if (auto model = aiModels.get(entry.second)) {
+                linkPrerequisites(*model);
+            }
+        }
+    }
+    prerequisiteCycleCheckPending = false;
+    prerequisiteGraphStale = false;
 }
 
-// Learning path recommendations (stub implementations)
-std::vector<std::shared_ptr<AIModel>> AIModelService::getRecommendedLearningPath(int clientId) const {
-    // This would normally use client's profile and progress to recommend models
-    // For now, just return models sorted by complexity
-    auto sortedModels = aiModels;
+// Models at the next complexity level below the given one in a category
+std::vector<int> AIModelService::getLowerLevelModels(const std::string& category, int complexity) const {
+    buildSecondaryIndexes();
+    std::vector<int> modelIds;
+    auto levels = modelsByCategoryLevel.find(category);
+    if (levels == modelsByCategoryLevel.end()) {
+        return modelIds;
+    }
     
-    std::sort(sortedModels.begin(), sortedModels.end(),
-              [](const std::shared_ptr<AIModel>& a, const std::shared_ptr<AIModel>& b) {
-                  return a->getComplexityLevel() < b->getComplexityLevel();
-              });
+    auto levelStart = levels->second.lower_bound(std::make_pair(complexity, std::numeric_limits<int>::min()));
+    if (levelStart == levels->second.begin()) {
+        return modelIds;
+    }
+    int lowerComplexity = std::prev(levelStart)->first;
+    for (auto it = levels->second.lower_bound(std::make_pair(lowerComplexity, std::numeric_limits<int>::min()));
+         it != levelStart; ++it) {
+        modelIds.push_back(it->second);
+    }
+    return modelIds;
+}
+
+// Links the model from the level below: through the level's entry hub, or
+// if it has removed any level edges, from each model it still requires
+void AIModelService::linkLowerLevel(const AIModel& model) const {
+    int modelId = model.getModelId();
+    const std::vector<int>& removed = model.getRemovedPrerequisites();
+    if (removed.empty()) {
+        auto levelKey = std::make_pair(model.getCategory(), model.getComplexityLevel());
+        prerequisiteGraph.link(prerequisiteLevelHubs.at(levelKey).entry, modelId);
+        return;
+    }
     
-    return sortedModels;
+    for (int prerequisite : getLowerLevelModels(model.getCategory(), model.getComplexityLevel())) {
+        if (std::find(removed.begin(), removed.end(), prerequisite) == removed.end() &&
+            !prerequisiteGraph.hasEdge(prerequisite, modelId)) {
+            prerequisiteGraph.link(prerequisite, modelId);
+        }
+    }
 }
 
-std::vector<std::shared_ptr<AIModel>> AIModelService::getRelatedModels(int modelId) const {
-    auto model = getModelById(modelId);
-    if (!model) {
-        return {};
+// Adds an edit's edge if both models are in the graph yet; the other end
+// adds it otherwise
+void AIModelService::linkAddedPrerequisite(int prerequisiteId, int modelId) const {
+    if (!prerequisiteGraph.contains(prerequisiteId) || !prerequisiteGraph.contains(modelId)) {
+        return;
+    }
+    if (!prerequisiteGraph.addEdge(prerequisiteId, modelId)) {
+        Logger::getInstance().warning("Skipping prerequisite " + std::to_string(prerequisiteId) + " of AI model " +
+                                      std::to_string(modelId) + ": it would make a cycle");
+        prerequisiteEditsSkipped = true;
+        prerequisiteGraphStale = true;
+    }
+}
+
+// Adds an indexed model to a built graph: its level edges, the level edges
+// of models above that it now sits below, and the edits naming it
+void AIModelService::linkPrerequisites(const AIModel& model) const {
+    if (!prerequisiteGraphBuilt) {
+        return;
     }
     
-    // For now, just return models in the same category
-    return getModelsByCategory(model->getCategory());
+    int modelId = model.getModelId();
+    auto levelKey = std::make_pair(model.getCategory(), model.getComplexityLevel());
+    prerequisiteGraph.addNode(modelId, model.getComplexityLevel());
+    if (!modelsEditingPrerequisite.empty()) {
+        prerequisiteCycleCheckPending = true;
+    }
+    if (prerequisiteEditsSkipped) {
+        // The move may have cleared the way for a skipped edit
+        prerequisiteGraphStale = true;
+    }
+    
+    auto level = prerequisiteLevelHubs.find(levelKey);
+    bool newLevel = level == prerequisiteLevelHubs.end();
+    if (newLevel) {
+        PrerequisiteLevelHubs hubs;
+        hubs.entry = nextPrerequisiteHubId--;
+        hubs.exit = nextPrerequisiteHubId--;
+        prerequisiteGraph.addHub(hubs.entry, levelKey.second);
+        prerequisiteGraph.addHub(hubs.exit, levelKey.second);
+        level = prerequisiteLevelHubs.insert(std::make_pair(levelKey, hubs)).first;
+        
+        // Splice the level into its category's chain of hubs
+        const PrerequisiteLevelHubs* lower = nullptr;
+        const PrerequisiteLevelHubs* upper = nullptr;
+        if (level != prerequisiteLevelHubs.begin() && std::prev(level)->first.first == levelKey.first) {
+            lower = &std::prev(level)->second;
+        }
+        if (std::next(level) != prerequisiteLevelHubs.end() && std::next(level)->first.first == levelKey.first) {
+            upper = &std::next(level)->second;
+        }
+        if (lower && upper) {
+            prerequisiteGraph.removeEdge(lower->exit, upper->entry);
+        }
+        if (lower) {
+            prerequisiteGraph.link(lower->exit, hubs.entry);
+        }
+        if (upper) {
+            prerequisiteGraph.link(hubs.exit, upper->entry);
+        }
+    }
+    prerequisiteGraph.link(modelId, level->second.exit);
+    linkLowerLevel(model);
+    
+    // Models above that are linked one by one now have a new level below
+    // them, or one more model in it
+    auto upperLevel = std::next(level);
+    if (upperLevel != prerequisiteLevelHubs.end() && upperLevel->first.first == levelKey.first) {
+        if (newLevel) {
+            relinkLevel(upperLevel->first);
+        } else {
+            auto removing = modelsRemovingPrerequisites.find(upperLevel->first);
+            if (removing != modelsRemovingPrerequisites.end()) {
+                for (int dependentId : removing->second) {
+                    auto dependent = aiModels.get(dependentId);
+                    const std::vector<int>& removed = dependent->getRemovedPrerequisites();
+                    if (std::find(removed.begin(), removed.end(), modelId) == removed.end() &&
+                        !prerequisiteGraph.hasEdge(modelId, dependentId)) {
+                        prerequisiteGraph.link(modelId, dependentId);
+                    }
+                }
+            }
+        }
+    }
+    
+    for (int prerequisiteId : model.getAddedPrerequisites()) {
+        linkAddedPrerequisite(prerequisiteId, modelId);
+    }
+    auto editing = modelsEditingPrerequisite.find(modelId);
+    if (editing != modelsEditingPrerequisite.end()) {
+        for (int dependentId : editing->second) {
+            auto dependent = aiModels.get(dependentId);
+            const std::vector<int>& added = dependent->getAddedPrerequisites();
+            if (std::find(added.begin(), added.end(), modelId) != added.end()) {
+                linkAddedPrerequisite(modelId, dependentId);
+            }
+        }
+    }
 }
 
-std::vector<std::shared_ptr<AIModel>> AIModelService::getPrerequisiteModels(int modelId) const {
-    auto model = getModelById(modelId);
-    if (!model) {
-        return {};
+// Takes a model out of a built graph. Call after unindexing it, with its
+// fields as they were linked.
+void AIModelService::unlinkPrerequisites(const AIModel& model) const {
+    if (!prerequisiteGraphBuilt || !prerequisiteGraph.contains(model.getModelId())) {
+        return;
     }
     
-    // For now, return models of the same category with lower complexity
-    std::vector<std::shared_ptr<AIModel>> prerequisites;
+    prerequisiteGraph.removeNode(model.getModelId());
+    if (prerequisiteEditsSkipped) {
+        prerequisiteGraphStale = true;
+    }
+    auto levelKey = std::make_pair(model.getCategory(), model.getComplexityLevel());
+    auto levels = modelsByCategoryLevel.find(levelKey.first);
+    if (levels != modelsByCategoryLevel.end()) {
+        auto member = levels->second.lower_bound(std::make_pair(levelKey.second, std::numeric_limits<int>::min()));
+        if (member != levels->second.end() && member->first == levelKey.second) {
+            return;
+        }
+    }
     
-    for (const auto& other : aiModels) {
-        if (other->getCategory() == model->getCategory() && 
-            other->getComplexityLevel() < model->getComplexityLevel()) {
-            prerequisites.push_back(other);
+    // The level is gone; join the levels around it
+    auto level = prerequisiteLevelHubs.find(levelKey);
+    if (level == prerequisiteLevelHubs.end()) {
+        return;
+    }
+    prerequisiteGraph.removeNode(level->second.entry);
+    prerequisiteGraph.removeNode(level->second.exit);
+    auto upperLevel = prerequisiteLevelHubs.erase(level);
+    bool hasUpper = upperLevel != prerequisiteLevelHubs.end() && upperLevel->first.first == levelKey.first;
+    if (hasUpper && upperLevel != prerequisiteLevelHubs.begin() &&
+        std::prev(upperLevel)->first.first == levelKey.first) {
+        prerequisiteGraph.link(std::prev(upperLevel)->second.exit, upperLevel->second.entry);
+        if (!modelsEditingPrerequisite.empty()) {
+            prerequisiteCycleCheckPending = true;
         }
     }
+    if (hasUpper) {
+        relinkLevel(upperLevel->first);
+    }
+}
+
+// Relinks the models of a level that are linked one by one, after the
+// level below them changed
+void AIModelService::relinkLevel(const std::pair<std::string, int>& levelKey) const {
+    auto removing = modelsRemovingPrerequisites.find(levelKey);
+    if (removing != modelsRemovingPrerequisites.end()) {
+        for (int modelId : removing->second) {
+            relinkPrerequisites(*aiModels.get(modelId));
+        }
+    }
+}
+
+void AIModelService::relinkPrerequisites(const AIModel& model) const {
+    if (prerequisiteGraphBuilt) {
+        prerequisiteGraph.removeNode(model.getModelId());
+        linkPrerequisites(model);
+    }
+}
+
+// Similarity index, maintained like the secondary indexes
+void AIModelService::buildModelSimilarity() const {
+    if (modelSimilarityBuilt) {
+        return;
+    }
     
-    return prerequisites;
+    for (const auto& model : aiModels) {
+        modelSimilarity.add(model->getModelId(), similarityText(*model));
+    }
+    modelSimilarityBuilt = true;
 }
 
-std::vector<std::shared_ptr<AIModel>> AIModelService::getNextLevelModels(int modelId) const {
-    auto model = getModelById(modelId);
+void AIModelService::vectorizeModel(const AIModel& model) {
+    if (modelSimilarityBuilt) {
+        modelSimilarity.add(model.getModelId(), similarityText(model));
+    }
+}
+
+bool AIModelService::addModelPrerequisite(int modelId, int prerequisiteId) {
+    if (!aiModels.contains(modelId) || !aiModels.contains(prerequisiteId)) {
+        return false;
+    }
+    
+    buildPrerequisiteGraph();
+    if (!prerequisiteGraph.addEdge(prerequisiteId, modelId)) {
+        Logger::getInstance().warning("AI model " + std::to_string(prerequisiteId) + " cannot be a prerequisite of " +
+                                      std::to_string(modelId) + ": it would make a cycle");
+        return false;
+    }
+    
+    auto model = aiModels.getForWrite(modelId);
+    const std::vector<int>& removed = model->getRemovedPrerequisites();
+    bool wasRemoved = std::find(removed.begin(), removed.end(), prerequisiteId) != removed.end();
+    unindexModel(*model);
+    model->addPrerequisite(prerequisiteId);
+    indexModel(*model);
+    if (wasRemoved) {
+        // Its level edges may go back through the hub
+        relinkPrerequisites(*model);
+    }
+    recordMutation(OP_ADD_PREREQUISITE, modelId, {std::to_string(prerequisiteId)});
+    return true;
+}
+
+bool AIModelService::removeModelPrerequisite(int modelId, int prerequisiteId) {
+    auto model = aiModels.get(modelId);
     if (!model) {
-        return {};
+        return false;
     }
     
-    // For now, return models of the same category with higher complexity
-    std::vector<std::shared_ptr<AIModel>> nextLevelModels;
+    // The edge is either stored, or seeded from the level below
+    buildPrerequisiteGraph();
+    const std::vector<int>& removed = model->getRemovedPrerequisites();
+    std::vector<int> lowerLevel = getLowerLevelModels(model->getCategory(), model->getComplexityLevel());
+    bool seeded = std::find(removed.begin(), removed.end(), prerequisiteId) == removed.end() &&
+                  std::find(lowerLevel.begin(), lowerLevel.end(), prerequisiteId) != lowerLevel.end();
+    if (!seeded && !prerequisiteGraph.hasEdge(prerequisiteId, modelId)) {
+        return false;
+    }
     
-    for (const auto& other : aiModels) {
-        if (other->getCategory() == model->getCategory() && 
-            other->getComplexityLevel() > model->getComplexityLevel()) {
-            nextLevelModels.push_back(other);
+    model = aiModels.getForWrite(modelId);
+    unindexModel(*model);
+    model->removePrerequisite(prerequisiteId);
+    indexModel(*model);
+    relinkPrerequisites(*model);
+    recordMutation(OP_REMOVE_PREREQUISITE, modelId, {std::to_string(prerequisiteId)});
+    return true;
+}
+
+// Learning path recommendations
+std::vector<std::shared_ptr<AIModel>> AIModelService::getRecommendedLearningPath(const Client& client) const {
+    buildPrerequisiteGraph();
+    
+    const SmallVector<SymbolLevel, 4>& proficiency = client.getProficiencySymbols();
+    auto cached = learningPathCache.find(client.getClientId());
+    if (cached != learningPathCache.end()) {
+        const CachedLearningPath& entry = cached->second;
+        bool current = entry.graphVersion == prerequisiteGraph.getVersion() &&
+                       entry.proficiencies.size() == proficiency.size() &&
+                       std::equal(proficiency.begin(), proficiency.end(), entry.proficiencies.begin(),
+                                  [](const SymbolLevel& a, const SymbolLevel& b) {
+                                      return a.symbol == b.symbol && a.level == b.level;
+                                  });
+        if (current) {
+            learningPathCacheStats.hits++;
+            return resolveModels(entry.modelIds);
         }
     }
+    learningPathCacheStats.misses++;
+    
+    // Walk the graph in topological order, keeping the models the client's
+    // proficiency does not yet reach
+    CachedLearningPath entry;
+    entry.graphVersion = prerequisiteGraph.getVersion();
+    entry.proficiencies.assign(proficiency.begin(), proficiency.end());
+    for (int modelId : prerequisiteGraph.getTopologicalOrder()) {
+        auto model = aiModels.get(modelId);
+        if (!model) {
+            continue;
+        }
+        
+        int level = 0;
+        Symbol symbol;
+        if (SymbolTable::aiModels().find(model->getName(), symbol)) {
+            for (const auto& known : proficiency) {
+                if (known.symbol == symbol) {
+                    level = known.level;
+                    break;
+                }
+            }
+        }
+        if (level < model->getComplexityLevel()) {
+            entry.modelIds.push_back(modelId);
+        }
+    }
+    
+    if (cached == learningPathCache.end() && learningPathCache.size() >= MAX_CACHED_LEARNING_PATHS) {
+        learningPathCache.erase(learningPathCache.begin());
+    }
+    std::vector<int>& modelIds = (learningPathCache[client.getClientId()] = entry).modelIds;
+    return resolveModels(modelIds);
+}
+
+LearningPathCacheStats AIModelService::getLearningPathCacheStats() const {
+    LearningPathCacheStats stats = learningPathCacheStats;
+    stats.entries = learningPathCache.size();
+    return stats;
+}
+
+std::vector<std::shared_ptr<AIModel>> AIModelService::getRelatedModels(int modelId, size_t count) const {
+    buildModelSimilarity();
     
-    return nextLevelModels;
-}
\ No newline at end of file
+    std::vector<int> modelIds;
+    for (const auto& match : modelSimilarity.mostSimilar(modelId, count)) {
+        modelIds.push_back(match.first);
+    }
+    return resolveModels(modelIds);
+}
+
+std::vector<std::shared_ptr<AIModel>> AIModelService::getPrerequisiteModels(int modelId) const {
+    buildPrerequisiteGraph();
+    return resolveModels(prerequisiteGraph.getAllPrerequisites(modelId));
+}
+
+std::vector<std::shared_ptr<AIModel>> AIModelService::getNextLevelModels(int modelId) const {
+    buildPrerequisiteGraph();
+    return resolveModels(prerequisiteGraph.getAllDependents(modelId));
+}
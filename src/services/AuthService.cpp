@@ -7,7 +7,8 @@
 
 
 // Constructor
-AuthService::AuthService() : currentUser(nullptr), isLoggedIn(false) {
+AuthService::AuthService()
+    : users([](const User& user) { return user.getUserId(); }), currentUser(nullptr), isLoggedIn(false) {
     loadUsers();
 }
 
@@ -28,7 +29,7 @@ void AuthService::loadUsers() {
         "admin@example.com", "555-1234", 
         "Full", true, true
     );
-    users.push_back(admin);
+    users.put(admin);
     
     // Create a tutor
     std::vector<std::string> aiSpecializations = {"Large Language Models", "Computer Vision"};
@@ -41,7 +42,7 @@ void AuthService::loadUsers() {
         aiSpecializations, domainExpertise,
         "PhD in Computer Science", 5, 75.0
     );
-    users.push_back(tutor);
+    users.put(tutor);
     
     Logger::getInstance().info("Loaded " + std::to_string(users.size()) + " users");
 }
@@ -79,19 +80,19 @@ std::shared_ptr<User> AuthService::getCurrentUser() const {
 
 // User management methods (stub implementations)
 bool AuthService::registerUser(std::shared_ptr<User> user) {
-    users.push_back(user);
+    // An existing account is never replaced by registration
+    if (users.contains(user->getUserId())) {
+        Logger::getInstance().warning("User ID " + std::to_string(user->getUserId()) + " is already registered");
+        return false;
+    }
+    
+    users.put(user);
     saveUsers();
     return true;
 }
 
 bool AuthService::deleteUser(int userId) {
-    auto it = std::find_if(users.begin(), users.end(), 
-        [userId](const std::shared_ptr<User>& user) {
-            return user->getUserId() == userId;
-        });
-    
-    if (it != users.end()) {
-        users.erase(it);
+    if (users.remove(userId)) {
         saveUsers();
         return true;
     }
@@ -125,12 +126,7 @@ bool AuthService::updateUserDetails(int userId, const std::string& firstName,
 
 // User retrieval methods
 std::shared_ptr<User> AuthService::getUserById(int userId) const {
-    for (const auto& user : users) {
-        if (user->getUserId() == userId) {
-            return user;
-        }
-    }
-    return nullptr;
+    return users.get(userId);
 }
 
 std::shared_ptr<User> AuthService::getUserByUsername(const std::string& username) const {
@@ -143,7 +139,7 @@ std::shared_ptr<User> AuthService::getUserByUsername(const std::string& username
 }
 
 std::vector<std::shared_ptr<User>> AuthService::getAllUsers() const {
-    return users;
+    return users.getAll();
 }
 
 std::vector<std::shared_ptr<Tutor>> AuthService::getAllTutors() const {
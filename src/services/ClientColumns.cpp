@@ -0,0 +1,318 @@
+#include "include/services/ClientColumns.h"
+#include "include/utils/FieldTokenizer.h"
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <iomanip>
+
+namespace {
+    // Kernels work on blocks of LANES rows with a separate accumulator per
+    // lane. The fixed-length inner loops are what compilers vectorize, and
+    // independent lanes also break the dependency chain of a scalar sum.
+    const size_t LANES = 8;
+
+    // Branch-free filter: writes every row's ID and advances only past the
+    // rows that match, so the loop has no data-dependent branch
+    template <typename Predicate>
+    std::vector<int> filterIds(const std::vector<int>& clientIds, Predicate matches) {
+        std::vector<int> result(clientIds.size());
+        size_t count = 0;
+        for (size_t row = 0; row < clientIds.size(); row++) {
+            result[count] = clientIds[row];
+            count += matches(row) ? 1 : 0;
+        }
+        result.resize(count);
+        return result;
+    }
+
+    // YYYYMMDD back to "YYYY-MM-DD"
+    std::string formatDate(int32_t date) {
+        std::ostringstream ss;
+        ss << std::setfill('0') << std::setw(4) << date / 10000 << '-'
+           << std::setw(2) << date / 100 % 100 << '-' << std::setw(2) << date % 100;
+        return ss.str();
+    }
+}
+
+// Filter
+ClientColumnFilter::ClientColumnFilter()
+    : minBudget(std::numeric_limits<double>::lowest()), minBudgetInclusive(true),
+      maxBudget(std::numeric_limits<double>::max()),
+      minSessions(std::numeric_limits<int>::min()), maxSessions(std::numeric_limits<int>::max()),
+      registeredFrom(std::numeric_limits<int32_t>::min()), registeredTo(std::numeric_limits<int32_t>::max()),
+      lastSessionBefore(std::numeric_limits<int32_t>::max()) {}
+
+bool ClientColumnFilter::isEmpty() const {
+    ClientColumnFilter all;
+    return minBudget == all.minBudget && maxBudget == all.maxBudget &&
+           minSessions == all.minSessions && maxSessions == all.maxSessions &&
+           registeredFrom == all.registeredFrom && registeredTo == all.registeredTo &&
+           lastSessionBefore == all.lastSessionBefore;
+}
+
+std::string ClientColumnFilter::describe() const {
+    ClientColumnFilter all;
+    std::vector<std::string> conditions;
+    std::ostringstream ss;
+
+    if (minBudget != all.minBudget) {
+        ss << "budget " << (minBudgetInclusive ? ">= " : "> ") << minBudget;
+        conditions.push_back(ss.str());
+        ss.str("");
+    }
+    if (maxBudget != all.maxBudget) {
+        ss << "budget <= " << maxBudget;
+        conditions.push_back(ss.str());
+        ss.str("");
+    }
+    if (minSessions != all.minSessions) {
+        conditions.push_back("sessions >= " + std::to_string(minSessions));
+    }
+    if (maxSessions != all.maxSessions) {
+        conditions.push_back("sessions <= " + std::to_string(maxSessions));
+    }
+    if (registeredFrom != all.registeredFrom) {
+        conditions.push_back("registered >= " + formatDate(registeredFrom));
+    }
+    if (registeredTo != all.registeredTo) {
+        conditions.push_back("registered <= " + formatDate(registeredTo));
+    }
+    if (lastSessionBefore != all.lastSessionBefore) {
+        conditions.push_back("no session since " + formatDate(lastSessionBefore));
+    }
+
+    std::string text;
+    for (size_t i = 0; i < conditions.size(); i++) {
+        text += (i > 0 ? ", " : "") + conditions[i];
+    }
+    return text;
+}
+
+// Helpers
+int32_t ClientColumns::encodeDate(const std::string& date) {
+    int year, month, day;
+    if (!FieldParser::parseDate(FieldView(date), year, month, day)) {
+        return 0;
+    }
+    return year * 10000 + month * 100 + day;
+}
+
+size_t ClientColumns::rowFor(int clientId) {
+    auto it = rowById.find(clientId);
+    if (it != rowById.end()) {
+        return it->second;
+    }
+
+    size_t row = clientIds.size();
+    clientIds.push_back(clientId);
+    sessionsCompleted.push_back(0);
+    budgets.push_back(0.0);
+    registrationDates.push_back(0);
+    lastSessionDates.push_back(0);
+    rowById[clientId] = row;
+    return row;
+}
+
+bool ClientColumns::rowMatches(size_t row, const ClientColumnFilter& filter) const {
+    double budget = budgets[row];
+    bool aboveMinimum = budget > filter.minBudget || (filter.minBudgetInclusive && budget == filter.minBudget);
+    return aboveMinimum && budget <= filter.maxBudget &&
+           sessionsCompleted[row] >= filter.minSessions && sessionsCompleted[row] <= filter.maxSessions &&
+           registrationDates[row] >= filter.registeredFrom && registrationDates[row] <= filter.registeredTo &&
+           lastSessionDates[row] < filter.lastSessionBefore;
+}
+
+// Row maintenance
+void ClientColumns::upsert(const Client& client) {
+    size_t row = rowFor(client.getClientId());
+    sessionsCompleted[row] = client.getSessionsCompleted();
+    budgets[row] = client.getBudget();
+    registrationDates[row] = encodeDate(client.getRegistrationDate());
+    lastSessionDates[row] = encodeDate(client.getLastSessionDate());
+}
+
+void ClientColumns::remove(int clientId) {
+    auto it = rowById.find(clientId);
+    if (it == rowById.end()) {
+        return;
+    }
+
+    size_t row = it->second;
+    size_t last = clientIds.size() - 1;
+    if (row != last) {
+        clientIds[row] = clientIds[last];
+        sessionsCompleted[row] = sessionsCompleted[last];
+        budgets[row] = budgets[last];
+        registrationDates[row] = registrationDates[last];
+        lastSessionDates[row] = lastSessionDates[last];
+        rowById[clientIds[row]] = row;
+    }
+
+    clientIds.pop_back();
+    sessionsCompleted.pop_back();
+    budgets.pop_back();
+    registrationDates.pop_back();
+    lastSessionDates.pop_back();
+    rowById.erase(clientId);
+}
+
+void ClientColumns::clear() {
+    clientIds.clear();
+    sessionsCompleted.clear();
+    budgets.clear();
+    registrationDates.clear();
+    lastSessionDates.clear();
+    rowById.clear();
+}
+
+void ClientColumns::setSessions(int clientId, int sessions, const std::string& lastSessionDate) {
+    auto it = rowById.find(clientId);
+    if (it != rowById.end()) {
+        sessionsCompleted[it->second] = sessions;
+        lastSessionDates[it->second] = encodeDate(lastSessionDate);
+    }
+}
+
+void ClientColumns::setBudget(int clientId, double budget) {
+    auto it = rowById.find(clientId);
+    if (it != rowById.end()) {
+        budgets[it->second] = budget;
+    }
+}
+
+size_t ClientColumns::size() const {
+    return clientIds.size();
+}
+
+bool ClientColumns::contains(int clientId) const {
+    return rowById.count(clientId) > 0;
+}
+
+// Aggregates
+long long ClientColumns::sumSessions() const {
+    const int* values = sessionsCompleted.data();
+    size_t count = sessionsCompleted.size();
+    size_t blocked = count - count % LANES;
+
+    long long lanes[LANES] = {};
+    for (size_t row = 0; row < blocked; row += LANES) {
+        for (size_t lane = 0; lane < LANES; lane++) {
+            lanes[lane] += values[row + lane];
+        }
+    }
+
+    long long total = 0;
+    for (size_t lane = 0; lane < LANES; lane++) {
+        total += lanes[lane];
+    }
+    for (size_t row = blocked; row < count; row++) {
+        total += values[row];
+    }
+    return total;
+}
+
+double ClientColumns::sumBudget() const {
+    const double* values = budgets.data();
+    size_t count = budgets.size();
+    size_t blocked = count - count % LANES;
+
+    double lanes[LANES] = {};
+    for (size_t row = 0; row < blocked; row += LANES) {
+        for (size_t lane = 0; lane < LANES; lane++) {
+            lanes[lane] += values[row + lane];
+        }
+    }
+
+    double total = 0.0;
+    for (size_t lane = 0; lane < LANES; lane++) {
+        total += lanes[lane];
+    }
+    for (size_t row = blocked; row < count; row++) {
+        total += values[row];
+    }
+    return total;
+}
+
+// Filters
+std::vector<int> ClientColumns::findBudgetAtLeast(double minimum) const {
+    const double* values = budgets.data();
+    return filterIds(clientIds, [values, minimum](size_t row) { return values[row] >= minimum; });
+}
+
+std::vector<int> ClientColumns::findRegisteredBetween(int32_t fromDate, int32_t toDate) const {
+    const int32_t* values = registrationDates.data();
+    return filterIds(clientIds, [values, fromDate, toDate](size_t row) {
+        return (values[row] >= fromDate) & (values[row] <= toDate);
+    });
+}
+
+std::vector<int> ClientColumns::findInactiveSince(int32_t date) const {
+    const int32_t* values = lastSessionDates.data();
+    return filterIds(clientIds, [values, date](size_t row) { return values[row] < date; });
+}
+
+// Every condition is evaluated for every row and combined with '&', so the
+// kernel stays branch-free however many of them are set
+std::vector<int> ClientColumns::find(const ClientColumnFilter& filter) const {
+    const double* budgetValues = budgets.data();
+    const int* sessionValues = sessionsCompleted.data();
+    const int32_t* registered = registrationDates.data();
+    const int32_t* lastSession = lastSessionDates.data();
+    const ClientColumnFilter f = filter;
+    return filterIds(clientIds, [=](size_t row) {
+        double budget = budgetValues[row];
+        return ((budget > f.minBudget) | (f.minBudgetInclusive & (budget == f.minBudget))) &
+               (budget <= f.maxBudget) &
+               (sessionValues[row] >= f.minSessions) & (sessionValues[row] <= f.maxSessions) &
+               (registered[row] >= f.registeredFrom) & (registered[row] <= f.registeredTo) &
+               (lastSession[row] < f.lastSessionBefore);
+    });
+}
+
+size_t ClientColumns::estimate(const ClientColumnFilter& filter, size_t sampleRows) const {
+    size_t count = clientIds.size();
+    if (count == 0 || filter.isEmpty()) {
+        return count;
+    }
+
+    size_t stride = std::max<size_t>(1, count / std::max<size_t>(1, sampleRows));
+    size_t sampled = 0;
+    size_t matched = 0;
+    for (size_t row = 0; row < count; row += stride) {
+        sampled++;
+        matched += rowMatches(row, filter) ? 1 : 0;
+    }
+    return (matched * count + sampled - 1) / sampled;
+}
+
+bool ClientColumns::matches(int clientId, const ClientColumnFilter& filter) const {
+    auto it = rowById.find(clientId);
+    return it != rowById.end() && rowMatches(it->second, filter);
+}
+
+std::vector<size_t> ClientColumns::sessionHistogram(int bucketWidth, size_t bucketCount) const {
+    std::vector<size_t> buckets(bucketCount, 0);
+    if (bucketWidth <= 0 || bucketCount == 0) {
+        return buckets;
+    }
+
+    size_t lastBucket = bucketCount - 1;
+    for (int sessions : sessionsCompleted) {
+        size_t bucket = sessions > 0 ? static_cast<size_t>(sessions / bucketWidth) : 0;
+        buckets[std::min(bucket, lastBucket)]++;
+    }
+    return buckets;
+}
+
+bool ClientColumns::matches(const Client& client) const {
+    auto it = rowById.find(client.getClientId());
+    if (it == rowById.end()) {
+        return false;
+    }
+
+    size_t row = it->second;
+    return sessionsCompleted[row] == client.getSessionsCompleted() &&
+           budgets[row] == client.getBudget() &&
+           registrationDates[row] == encodeDate(client.getRegistrationDate()) &&
+           lastSessionDates[row] == encodeDate(client.getLastSessionDate());
+}
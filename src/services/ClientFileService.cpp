@@ -0,0 +1,152 @@
+#include "include/services/ClientFileService.h"
+#include "include/utils/Exception.h"
+#include <algorithm>
+
+namespace {
+    // Snapshot column order; bump CLIENT_SCHEMA_VERSION when it changes
+    enum ClientColumn {
+        COL_ID, COL_FIRST_NAME, COL_LAST_NAME, COL_EMAIL, COL_PHONE, COL_COMPANY,
+        COL_POSITION, COL_REGISTRATION_DATE, COL_SESSIONS, COL_LAST_SESSION,
+        COL_BUDGET, COL_INTERESTS, COL_GOALS, COL_PROFICIENCY_MODELS,
+        COL_PROFICIENCY_LEVELS
+    };
+
+    const uint32_t CLIENT_SCHEMA_VERSION = 1;
+    const size_t CLIENT_TEXT_FIELDS = 14;
+}
+
+ClientFileService::ClientFileService(const std::string& filename, StorageFormat format)
+    : FileService<Client>(filename, format) {}
+
+// Text format
+std::string ClientFileService::serializeObject(const Client& client) const {
+    std::vector<std::string> proficiencies;
+    for (const auto& entry : client.getAllProficiencies()) {
+        proficiencies.push_back(entry.first + ":" + std::to_string(entry.second));
+    }
+
+    std::stringstream ss;
+    ss << client.getClientId() << "|"
+       << sanitizeField(client.getFirstName()) << "|"
+       << sanitizeField(client.getLastName()) << "|"
+       << sanitizeField(client.getEmail()) << "|"
+       << sanitizeField(client.getPhone()) << "|"
+       << sanitizeField(client.getCompany()) << "|"
+       << sanitizeField(client.getPosition()) << "|"
+       << sanitizeField(client.getRegistrationDate()) << "|"
+       << client.getSessionsCompleted() << "|"
+       << sanitizeField(client.getLastSessionDate()) << "|"
+       << FieldParser::formatDouble(client.getBudget()) << "|"
+       << joinFields(client.getAIModelsOfInterest(), ';') << "|"
+       << joinFields(client.getLearningGoals(), ';') << "|"
+       << joinFields(proficiencies, ';');
+    return ss.str();
+}
+
+Client ClientFileService::deserializeObject(const std::string& data) const {
+    FieldView fields[CLIENT_TEXT_FIELDS];
+    if (FieldTokenizer(data).split(fields, CLIENT_TEXT_FIELDS) < CLIENT_TEXT_FIELDS) {
+        throw FileException("Invalid client data format");
+    }
+
+    Client client(parseIntField(fields[0], "client ID"), fields[1].str(), fields[2].str(),
+                  fields[3].str(), fields[4].str(), fields[5].str(), fields[6].str());
+    client.setRegistrationDate(fields[7].str());
+    client.setSessionsCompleted(parseIntField(fields[8], "session count"));
+    client.setLastSessionDate(fields[9].str());
+    client.setBudget(parseDoubleField(fields[10], "budget"));
+
+    FieldView item;
+    FieldTokenizer interests(fields[11], ';');
+    while (interests.next(item)) {
+        if (!item.empty()) {
+            client.addAIModel(SymbolTable::aiModels().internStored(item.str()));
+        }
+    }
+
+    FieldTokenizer goals(fields[12], ';');
+    while (goals.next(item)) {
+        if (!item.empty()) {
+            client.addLearningGoal(item.str());
+        }
+    }
+
+    FieldTokenizer proficiencies(fields[13], ';');
+    while (proficiencies.next(item)) {
+        size_t separator = item.rfind(':');
+        if (separator != FieldView::npos) {
+            client.setAIModelProficiency(SymbolTable::aiModels().internStored(item.substr(0, separator).str()),
+                                         parseIntField(item.substr(separator + 1), "proficiency level"));
+        }
+    }
+
+    return client;
+}
+
+// Snapshot format
+bool ClientFileService::supportsSnapshot() const {
+    return true;
+}
+
+uint32_t ClientFileService::getSnapshotSchemaVersion() const {
+    return CLIENT_SCHEMA_VERSION;
+}
+
+void ClientFileService::encodeRecord(const Client& client, SnapshotBuilder& builder) const {
+    std::vector<std::string> models;
+    std::vector<int> levels;
+    for (const auto& entry : client.getAllProficiencies()) {
+        models.push_back(entry.first);
+        levels.push_back(entry.second);
+    }
+
+    builder.putInt(client.getClientId());
+    builder.putString(client.getFirstName());
+    builder.putString(client.getLastName());
+    builder.putString(client.getEmail());
+    builder.putString(client.getPhone());
+    builder.putString(client.getCompany());
+    builder.putString(client.getPosition());
+    builder.putString(client.getRegistrationDate());
+    builder.putInt(client.getSessionsCompleted());
+    builder.putString(client.getLastSessionDate());
+    builder.putDouble(client.getBudget());
+    builder.putStringList(client.getAIModelsOfInterest());
+    builder.putStringList(client.getLearningGoals());
+    builder.putStringList(models);
+    builder.putIntList(levels);
+}
+
+Client ClientFileService::decodeRecord(const SnapshotView& view, size_t row) const {
+    Client client(static_cast<int>(view.getInt(COL_ID, row)),
+                  view.getString(COL_FIRST_NAME, row),
+                  view.getString(COL_LAST_NAME, row),
+                  view.getString(COL_EMAIL, row),
+                  view.getString(COL_PHONE, row),
+                  view.getString(COL_COMPANY, row),
+                  view.getString(COL_POSITION, row));
+    client.setRegistrationDate(view.getString(COL_REGISTRATION_DATE, row));
+    client.setSessionsCompleted(static_cast<int>(view.getInt(COL_SESSIONS, row)));
+    client.setLastSessionDate(view.getString(COL_LAST_SESSION, row));
+    client.setBudget(view.getDouble(COL_BUDGET, row));
+
+    size_t interests = view.getListSize(COL_INTERESTS, row);
+    for (size_t i = 0; i < interests; i++) {
+        client.addAIModel(SymbolTable::aiModels().internStored(view.getStringListItem(COL_INTERESTS, row, i)));
+    }
+
+    size_t goals = view.getListSize(COL_GOALS, row);
+    for (size_t i = 0; i < goals; i++) {
+        client.addLearningGoal(view.getStringListItem(COL_GOALS, row, i));
+    }
+
+    size_t proficiencies = std::min(view.getListSize(COL_PROFICIENCY_MODELS, row),
+                                    view.getListSize(COL_PROFICIENCY_LEVELS, row));
+    for (size_t i = 0; i < proficiencies; i++) {
+        client.setAIModelProficiency(SymbolTable::aiModels().internStored(
+                                         view.getStringListItem(COL_PROFICIENCY_MODELS, row, i)),
+                                     static_cast<int>(view.getIntListItem(COL_PROFICIENCY_LEVELS, row, i)));
+    }
+
+    return client;
+}
@@ -0,0 +1,148 @@
+#include "include/services/ClientQuery.h"
+#include "include/utils/Validation.h"
+#include "include/utils/Logger.h"
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <iomanip>
+
+// Constructor
+ClientQuery::ClientQuery()
+    : clientIds(), hasClientIds(false), nameTexts(), companyTexts(),
+      allOfModels(), anyOfModels(), noneOfModels(), columnFilter(),
+      predicates(), maxResults(0) {}
+
+// Conditions
+ClientQuery& ClientQuery::idIn(const std::vector<int>& ids) {
+    std::vector<int> sorted = ids;
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    if (hasClientIds) {
+        std::vector<int> common;
+        std::set_intersection(clientIds.begin(), clientIds.end(), sorted.begin(), sorted.end(),
+                              std::back_inserter(common));
+        sorted.swap(common);
+    }
+    clientIds.swap(sorted);
+    hasClientIds = true;
+    return *this;
+}
+
+// An empty substring matches everyone, so it adds no condition
+ClientQuery& ClientQuery::nameContains(const std::string& text) {
+    if (!text.empty()) {
+        nameTexts.push_back(text);
+    }
+    return *this;
+}
+
+ClientQuery& ClientQuery::companyContains(const std::string& text) {
+    if (!text.empty()) {
+        companyTexts.push_back(text);
+    }
+    return *this;
+}
+
+ClientQuery& ClientQuery::interestedIn(const std::string& aiModel) {
+    allOfModels.push_back(aiModel);
+    return *this;
+}
+
+ClientQuery& ClientQuery::interestedInAny(const std::vector<std::string>& aiModels) {
+    anyOfModels.insert(anyOfModels.end(), aiModels.begin(), aiModels.end());
+    return *this;
+}
+
+ClientQuery& ClientQuery::notInterestedIn(const std::string& aiModel) {
+    noneOfModels.push_back(aiModel);
+    return *this;
+}
+
+// Range conditions only ever narrow what earlier calls allowed
+ClientQuery& ClientQuery::budgetAtLeast(double minimum) {
+    if (minimum > columnFilter.minBudget) {
+        columnFilter.minBudget = minimum;
+        columnFilter.minBudgetInclusive = true;
+    }
+    return *this;
+}
+
+ClientQuery& ClientQuery::budgetAbove(double minimum) {
+    if (minimum >= columnFilter.minBudget) {
+        columnFilter.minBudget = minimum;
+        columnFilter.minBudgetInclusive = false;
+    }
+    return *this;
+}
+
+ClientQuery& ClientQuery::budgetAtMost(double maximum) {
+    columnFilter.maxBudget = std::min(columnFilter.maxBudget, maximum);
+    return *this;
+}
+
+ClientQuery& ClientQuery::sessionsBetween(int minimum, int maximum) {
+    columnFilter.minSessions = std::max(columnFilter.minSessions, minimum);
+    columnFilter.maxSessions = std::min(columnFilter.maxSessions, maximum);
+    return *this;
+}
+
+// A malformed date would encode as 0 and silently change the range, so
+// that bound is left out instead
+ClientQuery& ClientQuery::registeredBetween(const std::string& fromDate, const std::string& toDate) {
+    if (isUsableDate(fromDate)) {
+        columnFilter.registeredFrom = std::max(columnFilter.registeredFrom, ClientColumns::encodeDate(fromDate));
+    }
+    if (isUsableDate(toDate)) {
+        columnFilter.registeredTo = std::min(columnFilter.registeredTo, ClientColumns::encodeDate(toDate));
+    }
+    return *this;
+}
+
+ClientQuery& ClientQuery::noSessionSince(const std::string& date) {
+    if (isUsableDate(date)) {
+        columnFilter.lastSessionBefore = std::min(columnFilter.lastSessionBefore, ClientColumns::encodeDate(date));
+    }
+    return *this;
+}
+
+bool ClientQuery::isUsableDate(const std::string& date) {
+    if (Validation::isValidDate(date)) {
+        return true;
+    }
+    Logger::getInstance().warning("Ignoring client query date condition with invalid date: " + date);
+    return false;
+}
+
+ClientQuery& ClientQuery::where(const std::string& description, Predicate predicate) {
+    predicates.push_back(std::make_pair(description, predicate));
+    return *this;
+}
+
+ClientQuery& ClientQuery::limit(size_t count) {
+    maxResults = count;
+    return *this;
+}
+
+// Plan output
+std::string ClientQueryPlan::toString() const {
+    static const char* const accessNames[] = {"scan", "drive", "intersect", "probe", "filter", "limit"};
+
+    std::ostringstream ss;
+    ss << "Client query plan over " << totalClients << " clients"
+       << (executed ? "" : " (not run)") << std::endl;
+    for (const auto& step : steps) {
+        std::string what = step.source;
+        if (!step.condition.empty()) {
+            what += ": " + step.condition;
+        }
+        ss << "  " << std::left << std::setw(10) << accessNames[step.access]
+           << std::setw(60) << what
+           << " est " << std::right << std::setw(8) << step.estimatedRows;
+        if (executed) {
+            ss << "  rows " << std::setw(8) << step.actualRows;
+        }
+        ss << std::endl;
+    }
+    return ss.str();
+}
@@ -3,10 +3,79 @@
 #include "include/utils/Exception.h"
 #include "include/utils/Validation.h"
 #include <algorithm>
+#include <cassert>
 #include <iostream>
+#include <thread>
+#include <functional>
+#include <iterator>
+
+namespace {
+    // Journal record types. Records carry resulting values, not deltas,
+    // so replaying one that is already in the snapshot is harmless.
+    enum ClientJournalOp : uint8_t {
+        OP_UPSERT = 1,          // fields: serialized client
+        OP_REMOVE,              // no fields
+        OP_DETAILS,             // fields: first, last, email, phone, company, position
+        OP_PROFICIENCY,         // fields: model, level
+        OP_ADD_INTEREST,        // fields: model
+        OP_REMOVE_INTEREST,     // fields: model
+        OP_SESSION_INFO,        // fields: sessions completed, last session date
+        OP_BUDGET               // fields: budget
+    };
+
+    // Runs task(begin, end) over [0, count) split into one slice per
+    // hardware thread; small inputs stay on the caller's thread
+    void forEachSliceInParallel(size_t count, const std::function<void(size_t, size_t)>& task) {
+        const size_t MIN_SLICE = 1024;
+        size_t threads = std::max(1u, std::thread::hardware_concurrency());
+        threads = std::min(threads, (count + MIN_SLICE - 1) / MIN_SLICE);
+        if (threads <= 1) {
+            task(0, count);
+            return;
+        }
+        
+        size_t slice = (count + threads - 1) / threads;
+        std::vector<std::thread> workers;
+        for (size_t begin = slice; begin < count; begin += slice) {
+            workers.emplace_back(task, begin, std::min(count, begin + slice));
+        }
+        task(0, std::min(count, slice));
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+    
+    // One indexed condition of a client query. It can either list its
+    // matching client IDs in ascending order or check one ID at a time;
+    // the costs are rough units of work the planner compares.
+    struct QueryAccessPath {
+        std::string source;
+        std::string condition;
+        size_t estimatedRows;
+        size_t listCost;
+        size_t probeCost;
+        std::function<std::vector<int>()> list;
+        std::function<bool(int)> probe;
+    };
+    
+    std::string joinQuoted(const std::vector<std::string>& values) {
+        std::string text;
+        for (size_t i = 0; i < values.size(); i++) {
+            text += (i > 0 ? ", \"" : "\"") + values[i] + "\"";
+        }
+        return text;
+    }
+}
 
 // Constructor
-ClientService::ClientService() : nextClientId(1) {
+ClientService::ClientService(const ShardLayout& layout)
+    : clients("data/clients", layout, [](const Client& client) { return client.getClientId(); },
+               [this](int clientId) { return buildUpsertRecord(clientId); }, OP_REMOVE),
+      nextClientId(1), nameIndex(), companyIndex(), searchIndexesBuilt(false),
+      interestIndex(), interestIndexClients(), interestIndexBuilt(false),
+      modelInterestCounts(), totalSessions(0), sessionLeaderboard(), columns(), aggregatesBuilt(false),
+      modelRenamesSaved(0),
+      modificationVersion(0), countMemo(), figureMemo(), histogramMemo() {
     loadClients();
 }
 
@@ -15,11 +84,25 @@ ClientService::~ClientService() {
     saveClients();
 }
 
-// Load clients from file (stub implementation)
+// Load the last snapshots (seeding sample data if none have been saved yet),
+// then replay the journals on top of them. Files are only mapped and indexed
+// by ID; clients are decoded from them as they are first accessed.
 void ClientService::loadClients() {
-    // In a real implementation, this would load from a file
-    // For now, we'll create some sample clients for testing
+    if (!clients.exists()) {
+        seedSampleClients();
+    }
     
+    size_t replayed = clients.load([this](const JournalRecord& record) {
+        applyJournalRecord(record);
+    });
+    nextClientId = std::max(nextClientId, clients.getMaxId() + 1);
+    
+    Logger::getInstance().info("Loaded " + std::to_string(clients.size()) + " clients (" +
+                              std::to_string(replayed) + " journal records replayed)");
+}
+
+// Create some sample clients for testing
+void ClientService::seedSampleClients() {
     auto client1 = std::make_shared<Client>(
         1, "John", "Doe", 
         "john.doe@example.com", "555-1111", 
@@ -45,20 +128,158 @@ void ClientService::loadClients() {
     client2->setSessionsCompleted(3);
     client2->setBudget(750.0);
     
-    clients.push_back(client1);
-    clients.push_back(client2);
+    clients.put(client1->getClientId(), client1);
+    clients.put(client2->getClientId(), client2);
     
     nextClientId = 3; // Set next ID after creating sample clients
-    
-    Logger::getInstance().info("Loaded " + std::to_string(clients.size()) + " clients");
 }
 
-// Save clients to file (stub implementation)
+// Save every shard; once its snapshot is written its journal is redundant
 void ClientService::saveClients() {
-    // In a real implementation, this would save to a file
+    // Rows copied unchanged from the previous snapshot would still carry a
+    // renamed model's old name; after a rename, write every client afresh.
+    // This includes renames replayed from the AI model journal at startup.
+    uint64_t modelRenames = SymbolTable::aiModels().getRenameCount();
+    if (modelRenames != modelRenamesSaved) {
+        for (const auto& client : clients) {
+            clients.markDirty(client->getClientId());
+        }
+    }
+    
+    if (!clients.save()) {
+        Logger::getInstance().error("Failed to save clients");
+        return;
+    }
+    modelRenamesSaved = modelRenames;
+    SymbolTable::aiModels().retireAliases(modelRenames);
     Logger::getInstance().info("Saved " + std::to_string(clients.size()) + " clients");
 }
 
+// Append a single mutation instead of rewriting the whole dataset
+void ClientService::recordMutation(uint8_t type, int clientId, const std::vector<std::string>& fields) {
+    clients.recordMutation(type, clientId, fields);
+    modificationVersion++;
+}
+
+// Full current state of one client, used when flushing deferred mutations
+JournalRecord ClientService::buildUpsertRecord(int clientId) const {
+    auto client = getClientById(clientId);
+    if (!client) {
+        return JournalRecord(OP_REMOVE, clientId);
+    }
+    return JournalRecord(OP_UPSERT, clientId, {clients.getFiles().serialize(*client)});
+}
+
+void ClientService::applyJournalRecord(const JournalRecord& record) {
+    if (record.type == OP_UPSERT) {
+        if (record.fields.empty()) {
+            return;
+        }
+        clients.put(record.id, std::make_shared<Client>(clients.getFiles().deserialize(record.fields[0])));
+        nextClientId = std::max(nextClientId, record.id + 1);
+        return;
+    }
+    
+    if (record.type == OP_REMOVE) {
+        clients.remove(record.id);
+        return;
+    }
+    
+    auto client = clients.getForWrite(record.id);
+    if (!client) {
+        return;
+    }
+    clients.markDirty(record.id);
+    
+    const auto& fields = record.fields;
+    switch (record.type) {
+        case OP_DETAILS:
+            if (fields.size() >= 6) {
+                client->setFirstName(fields[0]);
+                client->setLastName(fields[1]);
+                client->setEmail(fields[2]);
+                client->setPhone(fields[3]);
+                client->setCompany(fields[4]);
+                client->setPosition(fields[5]);
+            }
+            break;
+        case OP_PROFICIENCY:
+            if (fields.size() >= 2) {
+                client->setAIModelProficiency(SymbolTable::aiModels().internStored(fields[0]), std::stoi(fields[1]));
+            }
+            break;
+        case OP_ADD_INTEREST:
+            if (!fields.empty()) {
+                client->addAIModel(SymbolTable::aiModels().internStored(fields[0]));
+            }
+            break;
+        case OP_REMOVE_INTEREST:
+            if (!fields.empty()) {
+                client->removeAIModel(SymbolTable::aiModels().internStored(fields[0]));
+            }
+            break;
+        case OP_SESSION_INFO:
+            if (fields.size() >= 2) {
+                client->setSessionsCompleted(std::stoi(fields[0]));
+                client->setLastSessionDate(fields[1]);
+            }
+            break;
+        case OP_BUDGET:
+            if (!fields.empty()) {
+                client->setBudget(std::stod(fields[0]));
+            }
+            break;
+        default:
+            Logger::getInstance().warning("Skipping unknown client journal record type " +
+                                          std::to_string(record.type));
+            break;
+    }
+}
+
+void ClientService::setJournalSyncPolicy(JournalSyncPolicy policy, int intervalMs) {
+    clients.setJournalSyncPolicy(policy, intervalMs);
+}
+
+void ClientService::setCompactionThresholds(size_t maxRecords, uint64_t maxBytes) {
+    clients.setCompactionThresholds(maxRecords, maxBytes);
+}
+
+CompactionStats ClientService::getCompactionStats() const {
+    return clients.getCompactionStats();
+}
+
+const ShardLayout& ClientService::getShardLayout() const {
+    return clients.getLayout();
+}
+
+void ClientService::setDeferredPersistence(bool enabled, int flushIntervalMs) {
+    clients.setDeferred(enabled, flushIntervalMs);
+}
+
+bool ClientService::flush() {
+    return clients.flush();
+}
+
+void ClientService::beginTransaction() {
+    clients.beginTransaction();
+}
+
+bool ClientService::commitTransaction() {
+    return clients.commitTransaction();
+}
+
+PersistenceStats ClientService::getPersistenceStats() const {
+    return clients.getPersistenceStats();
+}
+
+void ClientService::setResidentLimit(size_t maxClients) {
+    clients.setResidentLimit(maxClients);
+}
+
+RecordCacheStats ClientService::getCacheStats() const {
+    return clients.getCacheStats();
+}
+
 // Validation methods
 bool ClientService::isValidEmail(const std::string& email) const {
     return Validation::isValidEmail(email);
@@ -68,6 +289,197 @@ bool ClientService::isValidPhone(const std::string& phone) const {
     return Validation::isValidPhone(phone);
 }
 
+// Drop every index and analytics total built from the clients; each is
+// rebuilt in one pass by its next query. Used when a bulk change makes
+// that cheaper than updating them row by row.
+void ClientService::resetDerivedIndexes() {
+    nameIndex.clear();
+    companyIndex.clear();
+    searchIndexesBuilt = false;
+    
+    interestIndex.clear();
+    interestIndexClients.clear();
+    interestIndexBuilt = false;
+    
+    modelInterestCounts.clear();
+    totalSessions = 0;
+    sessionLeaderboard.clear();
+    columns.clear();
+    aggregatesBuilt = false;
+}
+
+// Search index maintenance. Until the first search there is nothing to
+// maintain; the indexes are then built from the current records.
+void ClientService::buildSearchIndexes() const {
+    if (searchIndexesBuilt) {
+        return;
+    }
+    
+    for (const auto& client : clients) {
+        nameIndex.add(client->getClientId(), client->getFullName());
+        companyIndex.add(client->getClientId(), client->getCompany());
+    }
+    searchIndexesBuilt = true;
+}
+
+void ClientService::indexClient(const Client& client) {
+    if (searchIndexesBuilt) {
+        nameIndex.add(client.getClientId(), client.getFullName());
+        companyIndex.add(client.getClientId(), client.getCompany());
+    }
+}
+
+void ClientService::unindexClient(int clientId) {
+    if (searchIndexesBuilt) {
+        nameIndex.remove(clientId);
+        companyIndex.remove(clientId);
+    }
+}
+
+std::vector<std::shared_ptr<Client>> ClientService::resolveClients(const std::vector<int>& clientIds) const {
+    std::vector<std::shared_ptr<Client>> results;
+    results.reserve(clientIds.size());
+    for (int clientId : clientIds) {
+        if (auto client = clients.get(clientId)) {
+            results.push_back(client);
+        }
+    }
+    return results;
+}
+
+// Interest index maintenance, following the same build-on-first-query rule
+void ClientService::buildInterestIndex() const {
+    if (interestIndexBuilt) {
+        return;
+    }
+    
+    for (const auto& client : clients) {
+        uint32_t clientId = static_cast<uint32_t>(client->getClientId());
+        interestIndexClients.add(clientId);
+        for (Symbol model : client->getAIModelSymbols()) {
+            interestIndex[model].add(clientId);
+        }
+    }
+    interestIndexBuilt = true;
+}
+
+// Callers unindex the client's previous record first
+void ClientService::indexInterests(const Client& client) {
+    if (interestIndexBuilt) {
+        uint32_t clientId = static_cast<uint32_t>(client.getClientId());
+        interestIndexClients.add(clientId);
+        for (Symbol model : client.getAIModelSymbols()) {
+            interestIndex[model].add(clientId);
+        }
+    }
+}
+
+// Only the bitmaps of the client's own interests can hold it
+void ClientService::unindexInterests(const Client& client) {
+    if (!interestIndexBuilt) {
+        return;
+    }
+    
+    uint32_t clientId = static_cast<uint32_t>(client.getClientId());
+    interestIndexClients.remove(clientId);
+    for (Symbol model : client.getAIModelSymbols()) {
+        auto it = interestIndex.find(model);
+        if (it == interestIndex.end()) {
+            continue;
+        }
+        it->second.remove(clientId);
+        if (it->second.empty()) {
+            interestIndex.erase(it);
+        }
+    }
+}
+
+CompressedBitmap ClientService::interestedClients(const std::string& aiModel) const {
+    Symbol symbol;
+    if (!SymbolTable::aiModels().find(aiModel, symbol)) {
+        return CompressedBitmap();
+    }
+    auto it = interestIndex.find(symbol);
+    return it != interestIndex.end() ? it->second : CompressedBitmap();
+}
+
+CompressedBitmap ClientService::interestMatches(const std::vector<std::string>& allOf,
+                                               const std::vector<std::string>& anyOf,
+                                               const std::vector<std::string>& noneOf) const {
+    CompressedBitmap matches = interestIndexClients;
+    for (const auto& model : allOf) {
+        matches = matches.intersect(interestedClients(model));
+    }
+    
+    if (!anyOf.empty()) {
+        CompressedBitmap any;
+        for (const auto& model : anyOf) {
+            any = any.unite(interestedClients(model));
+        }
+        matches = matches.intersect(any);
+    }
+    
+    for (const auto& model : noneOf) {
+        matches = matches.subtract(interestedClients(model));
+    }
+    return matches;
+}
+
+// Counts keyed by each model's current name
+std::map<std::string, int> ClientService::countInterestsByName(const std::unordered_map<Symbol, int>& counts) const {
+    std::map<std::string, int> byName;
+    for (const auto& entry : counts) {
+        byName[SymbolTable::aiModels().getName(entry.first)] = entry.second;
+    }
+    return byName;
+}
+
+// Analytics totals, following the same build-on-first-query rule
+void ClientService::buildAggregates() const {
+    if (aggregatesBuilt) {
+        return;
+    }
+    
+    for (const auto& client : clients) {
+        for (Symbol model : client->getAIModelSymbols()) {
+            modelInterestCounts[model]++;
+        }
+        totalSessions += client->getSessionsCompleted();
+        sessionLeaderboard.set(client->getClientId(), client->getSessionsCompleted());
+        columns.upsert(*client);
+    }
+    aggregatesBuilt = true;
+}
+
+// Add (sign 1) or withdraw (sign -1) one client's contribution
+void ClientService::addToAggregates(const Client& client, int sign) {
+    if (aggregatesBuilt) {
+        for (Symbol model : client.getAIModelSymbols()) {
+            adjustInterestCount(model, sign);
+        }
+        totalSessions += sign * client.getSessionsCompleted();
+        if (sign > 0) {
+            sessionLeaderboard.set(client.getClientId(), client.getSessionsCompleted());
+            columns.upsert(client);
+        } else {
+            sessionLeaderboard.remove(client.getClientId());
+            columns.remove(client.getClientId());
+        }
+    }
+}
+
+void ClientService::adjustInterestCount(Symbol aiModel, int delta) {
+    if (!aggregatesBuilt) {
+        return;
+    }
+    
+    auto it = modelInterestCounts.insert(std::make_pair(aiModel, 0)).first;
+    it->second += delta;
+    if (it->second == 0) {
+        modelInterestCounts.erase(it);
+    }
+}
+
 // Client management methods
 bool ClientService::addClient(std::shared_ptr<Client> client) {
     // Validate client data
@@ -79,39 +491,139 @@ bool ClientService::addClient(std::shared_ptr<Client> client) {
         throw ValidationException("Invalid phone number");
     }
     
-    // Set client ID if not already set
+    // Set client ID if not already set; a caller-supplied ID is reserved
     if (client->getClientId() == 0) {
         client->setClientId(nextClientId++);
+    } else {
+        nextClientId = std::max(nextClientId, client->getClientId() + 1);
     }
     
-    clients.push_back(client);
-    saveClients();
+    if (aggregatesBuilt || interestIndexBuilt) {
+        if (auto previous = clients.get(client->getClientId())) {
+            addToAggregates(*previous, -1);
+            unindexInterests(*previous);
+        }
+    }
+    clients.put(client->getClientId(), client);
+    addToAggregates(*client, 1);
+    indexClient(*client);
+    indexInterests(*client);
+    recordMutation(OP_UPSERT, client->getClientId(), {clients.getFiles().serialize(*client)});
     
     Logger::getInstance().info("Added new client: " + client->getFullName());
     return true;
 }
 
+ClientImportReport ClientService::addClients(const std::vector<std::shared_ptr<Client>>& batch) {
+    ClientImportReport report;
+    
+    // Validate every row; each thread fills its own slice of the results
+    std::vector<const char*> rowErrors(batch.size(), nullptr);
+    forEachSliceInParallel(batch.size(), [&](size_t begin, size_t end) {
+        for (size_t row = begin; row < end; row++) {
+            const auto& client = batch[row];
+            if (!client) {
+                rowErrors[row] = "Missing client";
+            } else if (!isValidEmail(client->getEmail())) {
+                rowErrors[row] = "Invalid email address";
+            } else if (!isValidPhone(client->getPhone())) {
+                rowErrors[row] = "Invalid phone number";
+            }
+        }
+    });
+    
+    // Explicit IDs must be unique within the batch; a row may still replace
+    // an existing client, as addClient does
+    std::unordered_map<int, size_t> explicitIds;
+    size_t unassigned = 0;
+    int maxExplicitId = 0;
+    for (size_t row = 0; row < batch.size(); row++) {
+        if (rowErrors[row]) {
+            continue;
+        }
+        int clientId = batch[row]->getClientId();
+        if (clientId == 0) {
+            unassigned++;
+        } else if (!explicitIds.insert(std::make_pair(clientId, row)).second) {
+            rowErrors[row] = "Duplicate client ID in batch";
+        } else {
+            maxExplicitId = std::max(maxExplicitId, clientId);
+        }
+    }
+    
+    // Reserve the new IDs past both existing clients and explicit IDs
+    int assignedId = std::max(nextClientId, maxExplicitId + 1);
+    nextClientId = assignedId + static_cast<int>(unassigned);
+    if (unassigned > 0) {
+        report.firstAssignedId = assignedId;
+        report.lastAssignedId = nextClientId - 1;
+    }
+    
+    // Large batches invalidate the derived indexes instead of updating them
+    // row by row; they are rebuilt once, on their next query
+    bool incremental = batch.size() < 1024 || batch.size() * 8 < clients.size();
+    if (!incremental) {
+        resetDerivedIndexes();
+    }
+    
+    // Insert and persist the valid rows as one group commit
+    clients.beginTransaction();
+    for (size_t row = 0; row < batch.size(); row++) {
+        if (rowErrors[row]) {
+            report.errors.push_back(ClientImportError(row, rowErrors[row]));
+            continue;
+        }
+        
+        const auto& client = batch[row];
+        if (client->getClientId() == 0) {
+            client->setClientId(assignedId++);
+        }
+        
+        if (incremental && (aggregatesBuilt || interestIndexBuilt)) {
+            if (auto previous = clients.get(client->getClientId())) {
+                addToAggregates(*previous, -1);
+                unindexInterests(*previous);
+            }
+        }
+        clients.put(client->getClientId(), client);
+        if (incremental) {
+            addToAggregates(*client, 1);
+            indexClient(*client);
+            indexInterests(*client);
+        }
+        recordMutation(OP_UPSERT, client->getClientId());
+        report.imported++;
+    }
+    if (!clients.commitTransaction()) {
+        report.persisted = false;
+        Logger::getInstance().error("Failed to persist imported clients");
+    }
+    
+    Logger::getInstance().info("Imported " + std::to_string(report.imported) + " clients (" +
+                               std::to_string(report.errors.size()) + " rows rejected)");
+    return report;
+}
+
 bool ClientService::removeClient(int clientId) {
-    auto it = std::find_if(clients.begin(), clients.end(), 
-        [clientId](const std::shared_ptr<Client>& client) {
-            return client->getClientId() == clientId;
-        });
-    
-    if (it != clients.end()) {
-        Logger::getInstance().info("Removed client: " + (*it)->getFullName());
-        clients.erase(it);
-        saveClients();
-        return true;
+    auto client = clients.get(clientId);
+    if (!client) {
+        return false;
     }
     
-    return false;
+    Logger::getInstance().info("Removed client: " + client->getFullName());
+    clients.remove(clientId);
+    addToAggregates(*client, -1);
+    unindexClient(clientId);
+    unindexInterests(*client);
+    recordMutation(OP_REMOVE, clientId);
+    return true;
 }
 
 bool ClientService::updateClientDetails(int clientId, const std::string& firstName, 
                                       const std::string& lastName, const std::string& email,
                                       const std::string& phone, const std::string& company,
                                       const std::string& position) {
-    auto client = getClientById(clientId);
+    auto client = clients.getForWrite(clientId);
     if (!client) {
         return false;
     }
@@ -131,85 +643,299 @@ bool ClientService::updateClientDetails(int clientId, const std::string& firstNa
     client->setPhone(phone);
     client->setCompany(company);
     client->setPosition(position);
+    indexClient(*client);
     
-    saveClients();
+    recordMutation(OP_DETAILS, clientId, {firstName, lastName, email, phone, company, position});
     Logger::getInstance().info("Updated client details: " + client->getFullName());
     return true;
 }
 
 // Client retrieval methods
 std::shared_ptr<Client> ClientService::getClientById(int clientId) const {
-    for (const auto& client : clients) {
-        if (client->getClientId() == clientId) {
-            return client;
-        }
-    }
-    return nullptr;
+    return clients.get(clientId);
 }
 
 std::vector<std::shared_ptr<Client>> ClientService::getAllClients() const {
-    return clients;
+    return clients.getAll();
 }
 
 std::vector<std::shared_ptr<Client>> ClientService::searchClientsByName(const std::string& name) const {
+    buildSearchIndexes();
+    return resolveClients(nameIndex.search(name));
+}
+
+std::vector<std::shared_ptr<Client>> ClientService::searchClientsByCompany(const std::string& company) const {
+    buildSearchIndexes();
+    return resolveClients(companyIndex.search(company));
+}
+
+std::vector<std::shared_ptr<Client>> ClientService::searchClientsByName(const std::string& name,
+                                                                        size_t limit) const {
+    buildSearchIndexes();
+    return resolveClients(nameIndex.searchRanked(name, limit));
+}
+
+std::vector<std::shared_ptr<Client>> ClientService::searchClientsByCompany(const std::string& company,
+                                                                           size_t limit) const {
+    buildSearchIndexes();
+    return resolveClients(companyIndex.searchRanked(company, limit));
+}
+
+std::vector<std::shared_ptr<Client>> ClientService::getClientsInterestedInModel(const std::string& aiModel) const {
+    return getClientsByIds(getInterestedClientIds(aiModel));
+}
+
+std::vector<std::shared_ptr<Client>> ClientService::getClientsByInterest(const std::vector<std::string>& allOf,
+                                                                         const std::vector<std::string>& anyOf,
+                                                                         const std::vector<std::string>& noneOf) const {
+    buildInterestIndex();
+    return getClientsByIds(interestMatches(allOf, anyOf, noneOf));
+}
+
+CompressedBitmap ClientService::getInterestedClientIds(const std::string& aiModel) const {
+    buildInterestIndex();
+    return interestedClients(aiModel);
+}
+
+std::vector<std::shared_ptr<Client>> ClientService::getClientsByIds(const CompressedBitmap& clientIds) const {
     std::vector<std::shared_ptr<Client>> results;
-    
-    std::string searchName = name;
-    // Convert search name to lowercase for case-insensitive search
-    std::transform(searchName.begin(), searchName.end(), searchName.begin(), ::tolower);
-    
-    for (const auto& client : clients) {
-        std::string fullName = client->getFullName();
-        std::transform(fullName.begin(), fullName.end(), fullName.begin(), ::tolower);
-        
-        if (fullName.find(searchName) != std::string::npos) {
+    results.reserve(clientIds.size());
+    for (uint32_t clientId : clientIds.toVector()) {
+        if (auto client = clients.get(static_cast<int>(clientId))) {
             results.push_back(client);
         }
     }
-    
     return results;
 }
 
-std::vector<std::shared_ptr<Client>> ClientService::searchClientsByCompany(const std::string& company) const {
-    std::vector<std::shared_ptr<Client>> results;
+// Query planning
+std::vector<int> ClientService::runClientQuery(const ClientQuery& query, bool execute, ClientQueryPlan& plan) const {
+    size_t total = clients.size();
+    plan = ClientQueryPlan();
+    plan.totalClients = total;
+    plan.executed = execute;
     
-    std::string searchCompany = company;
-    // Convert search company to lowercase for case-insensitive search
-    std::transform(searchCompany.begin(), searchCompany.end(), searchCompany.begin(), ::tolower);
+    // Gather an access path for every condition an index can answer
+    std::vector<QueryAccessPath> paths;
     
-    for (const auto& client : clients) {
-        std::string clientCompany = client->getCompany();
-        std::transform(clientCompany.begin(), clientCompany.end(), clientCompany.begin(), ::tolower);
+    if (query.hasClientIds) {
+        const std::vector<int>& clientIds = query.clientIds;
+        QueryAccessPath path;
+        path.source = "client IDs";
+        path.condition = std::to_string(clientIds.size()) + " listed";
+        path.estimatedRows = clientIds.size();
+        path.listCost = clientIds.size();
+        path.probeCost = 1;
+        path.list = [this, &clientIds]() {
+            std::vector<int> existing;
+            for (int clientId : clientIds) {
+                if (clients.contains(clientId)) {
+                    existing.push_back(clientId);
+                }
+            }
+            return existing;
+        };
+        path.probe = [&clientIds](int clientId) {
+            return std::binary_search(clientIds.begin(), clientIds.end(), clientId);
+        };
+        paths.push_back(path);
+    }
+    
+    if (!query.nameTexts.empty() || !query.companyTexts.empty()) {
+        buildSearchIndexes();
+    }
+    for (int field = 0; field < 2; field++) {
+        const TrigramIndex& index = field == 0 ? nameIndex : companyIndex;
+        for (const auto& text : field == 0 ? query.nameTexts : query.companyTexts) {
+            QueryAccessPath path;
+            path.source = field == 0 ? "name trigram index" : "company trigram index";
+            path.condition = "contains \"" + text + "\"";
+            path.estimatedRows = index.estimate(text);
+            // Text shorter than a trigram can only be found by scanning
+            path.listCost = text.size() < 3 ? total * 2 : path.estimatedRows;
+            path.probeCost = 2;
+            path.list = [&index, &text]() { return index.search(text); };
+            path.probe = [&index, &text](int clientId) { return index.contains(clientId, text); };
+            paths.push_back(path);
+        }
+    }
+    
+    if (!query.allOfModels.empty() || !query.anyOfModels.empty() || !query.noneOfModels.empty()) {
+        buildInterestIndex();
+        std::shared_ptr<CompressedBitmap> matches = std::make_shared<CompressedBitmap>(
+            interestMatches(query.allOfModels, query.anyOfModels, query.noneOfModels));
         
-        if (clientCompany.find(searchCompany) != std::string::npos) {
-            results.push_back(client);
+        std::vector<std::string> parts;
+        if (!query.allOfModels.empty()) {
+            parts.push_back("all of " + joinQuoted(query.allOfModels));
+        }
+        if (!query.anyOfModels.empty()) {
+            parts.push_back("any of " + joinQuoted(query.anyOfModels));
+        }
+        if (!query.noneOfModels.empty()) {
+            parts.push_back("none of " + joinQuoted(query.noneOfModels));
+        }
+        
+        QueryAccessPath path;
+        path.source = "interest bitmaps";
+        for (size_t i = 0; i < parts.size(); i++) {
+            path.condition += (i > 0 ? "; " : "") + parts[i];
         }
+        path.estimatedRows = matches->size();     // Exact: the bitmaps are already combined
+        path.listCost = matches->size() / 4;
+        path.probeCost = 1;
+        path.list = [matches]() {
+            std::vector<int> clientIds;
+            clientIds.reserve(matches->size());
+            for (uint32_t clientId : matches->toVector()) {
+                clientIds.push_back(static_cast<int>(clientId));
+            }
+            return clientIds;
+        };
+        path.probe = [matches](int clientId) { return matches->contains(static_cast<uint32_t>(clientId)); };
+        paths.push_back(path);
     }
     
-    return results;
-}
-
-std::vector<std::shared_ptr<Client>> ClientService::getClientsInterestedInModel(const std::string& aiModel) const {
-    std::vector<std::shared_ptr<Client>> results;
+    const ClientColumnFilter& filter = query.columnFilter;
+    if (!filter.isEmpty()) {
+        buildAggregates();
+        QueryAccessPath path;
+        path.source = "columns";
+        path.condition = filter.describe();
+        path.estimatedRows = columns.estimate(filter);
+        path.listCost = total / 4 + path.estimatedRows;     // Column scan, then sort into ID order
+        path.probeCost = 2;
+        path.list = [this, &filter]() {
+            std::vector<int> clientIds = columns.find(filter);
+            std::sort(clientIds.begin(), clientIds.end());
+            return clientIds;
+        };
+        path.probe = [this, &filter](int clientId) { return columns.matches(clientId, filter); };
+        paths.push_back(path);
+    }
     
-    for (const auto& client : clients) {
-        if (client->isInterestedIn(aiModel)) {
-            results.push_back(client);
+    std::stable_sort(paths.begin(), paths.end(), [](const QueryAccessPath& a, const QueryAccessPath& b) {
+        return a.estimatedRows < b.estimatedRows;
+    });
+    
+    // Start from the most selective path, or from every client if no
+    // condition is indexed. Choices are made on estimates only, so a run
+    // follows the same plan explainClientQuery reports.
+    std::vector<int> candidates;
+    size_t expected;
+    if (paths.empty()) {
+        plan.steps.push_back(ClientQueryStep(ACCESS_SCAN, "all clients", "", total));
+        if (execute) {
+            buildAggregates();
+            candidates = columns.find(ClientColumnFilter());
+            std::sort(candidates.begin(), candidates.end());
         }
+        expected = total;
+    } else {
+        plan.steps.push_back(ClientQueryStep(ACCESS_DRIVE, paths[0].source, paths[0].condition,
+                                             paths[0].estimatedRows));
+        if (execute) {
+            candidates = paths[0].list();
+        }
+        expected = paths[0].estimatedRows;
+    }
+    if (execute) {
+        plan.steps.back().actualRows = candidates.size();
     }
     
-    return results;
+    // Each further path is listed and intersected when that is cheaper than
+    // probing it for every candidate. Candidate counts are estimated as if
+    // the conditions were independent.
+    for (size_t i = 1; i < paths.size(); i++) {
+        const QueryAccessPath& path = paths[i];
+        bool intersect = path.listCost < expected * path.probeCost;
+        plan.steps.push_back(ClientQueryStep(intersect ? ACCESS_INTERSECT : ACCESS_PROBE,
+                                             path.source, path.condition, path.estimatedRows));
+        if (execute) {
+            if (intersect) {
+                std::vector<int> listed = path.list();
+                std::vector<int> common;
+                std::set_intersection(candidates.begin(), candidates.end(), listed.begin(), listed.end(),
+                                      std::back_inserter(common));
+                candidates.swap(common);
+            } else {
+                candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                                [&path](int clientId) { return !path.probe(clientId); }),
+                                 candidates.end());
+            }
+            plan.steps.back().actualRows = candidates.size();
+        }
+        expected = total > 0 ? static_cast<size_t>(static_cast<double>(expected) * path.estimatedRows / total) : 0;
+    }
+    
+    // Remaining conditions need the client itself. Candidates are tested in
+    // ID order, so a limit can stop the loading early.
+    size_t limit = query.maxResults;
+    if (!query.predicates.empty()) {
+        size_t firstFilter = plan.steps.size();
+        for (const auto& predicate : query.predicates) {
+            plan.steps.push_back(ClientQueryStep(ACCESS_FILTER, "where", predicate.first, expected));
+        }
+        
+        if (execute) {
+            std::vector<int> kept;
+            for (int clientId : candidates) {
+                std::shared_ptr<Client> client = clients.get(clientId);
+                if (!client) {
+                    continue;
+                }
+                
+                bool matches = true;
+                for (size_t k = 0; k < query.predicates.size() && matches; k++) {
+                    matches = query.predicates[k].second(*client);
+                    if (matches) {
+                        plan.steps[firstFilter + k].actualRows++;
+                    }
+                }
+                if (matches) {
+                    kept.push_back(clientId);
+                    if (limit > 0 && kept.size() == limit) {
+                        break;
+                    }
+                }
+            }
+            candidates.swap(kept);
+        }
+    }
+    
+    if (limit > 0) {
+        plan.steps.push_back(ClientQueryStep(ACCESS_LIMIT, "limit", std::to_string(limit), std::min(limit, expected)));
+        if (execute) {
+            if (candidates.size() > limit) {
+                candidates.resize(limit);
+            }
+            plan.steps.back().actualRows = candidates.size();
+        }
+    }
+    
+    return candidates;
+}
+
+std::vector<std::shared_ptr<Client>> ClientService::findClients(const ClientQuery& query, ClientQueryPlan* plan) const {
+    ClientQueryPlan localPlan;
+    return resolveClients(runClientQuery(query, true, plan ? *plan : localPlan));
+}
+
+ClientQueryPlan ClientService::explainClientQuery(const ClientQuery& query) const {
+    ClientQueryPlan plan;
+    runClientQuery(query, false, plan);
+    return plan;
 }
 
 // Client progress tracking methods
 bool ClientService::updateClientProgress(int clientId, const std::string& aiModel, int proficiencyLevel) {
-    auto client = getClientById(clientId);
+    auto client = clients.getForWrite(clientId);
     if (!client) {
         return false;
     }
     
     client->setAIModelProficiency(aiModel, proficiencyLevel);
-    saveClients();
+    recordMutation(OP_PROFICIENCY, clientId, {aiModel, std::to_string(client->getAIModelProficiency(aiModel))});
     
     Logger::getInstance().info("Updated progress for client " + client->getFullName() + 
                               " on " + aiModel + " to level " + std::to_string(proficiencyLevel));
@@ -227,26 +953,46 @@ std::map<std::string, int> ClientService::getClientProficiencies(int clientId) c
 
 // Client AI model management
 bool ClientService::addClientInterest(int clientId, const std::string& aiModel) {
-    auto client = getClientById(clientId);
+    auto client = clients.getForWrite(clientId);
     if (!client) {
         return false;
     }
     
-    client->addAIModel(aiModel);
-    saveClients();
+    Symbol model = SymbolTable::aiModels().intern(aiModel);
+    if (!client->isInterestedIn(model)) {
+        adjustInterestCount(model, 1);
+    }
+    client->addAIModel(model);
+    if (interestIndexBuilt) {
+        interestIndex[model].add(static_cast<uint32_t>(clientId));
+    }
+    recordMutation(OP_ADD_INTEREST, clientId, {aiModel});
     
     Logger::getInstance().info("Added interest in " + aiModel + " for client " + client->getFullName());
     return true;
 }
 
 bool ClientService::removeClientInterest(int clientId, const std::string& aiModel) {
-    auto client = getClientById(clientId);
+    auto client = clients.getForWrite(clientId);
     if (!client) {
         return false;
     }
     
-    client->removeAIModel(aiModel);
-    saveClients();
+    Symbol model;
+    if (SymbolTable::aiModels().find(aiModel, model) && client->isInterestedIn(model)) {
+        adjustInterestCount(model, -1);
+        client->removeAIModel(model);
+        if (interestIndexBuilt) {
+            auto it = interestIndex.find(model);
+            if (it != interestIndex.end()) {
+                it->second.remove(static_cast<uint32_t>(clientId));
+                if (it->second.empty()) {
+                    interestIndex.erase(it);
+                }
+            }
+        }
+    }
+    recordMutation(OP_REMOVE_INTEREST, clientId, {aiModel});
     
     Logger::getInstance().info("Removed interest in " + aiModel + " for client " + client->getFullName());
     return true;
@@ -254,14 +1000,20 @@ bool ClientService::removeClientInterest(int clientId, const std::string& aiMode
 
 // Client session management
 bool ClientService::updateClientSessionInfo(int clientId, const std::string& sessionDate) {
-    auto client = getClientById(clientId);
+    auto client = clients.getForWrite(clientId);
     if (!client) {
         return false;
     }
     
     client->incrementSessionsCompleted();
     client->setLastSessionDate(sessionDate);
-    saveClients();
+    if (aggregatesBuilt) {
+        totalSessions++;
+        sessionLeaderboard.set(clientId, client->getSessionsCompleted());
+        columns.setSessions(clientId, client->getSessionsCompleted(), client->getLastSessionDate());
+    }
+    recordMutation(OP_SESSION_INFO, clientId,
+                   {std::to_string(client->getSessionsCompleted()), client->getLastSessionDate()});
     
     Logger::getInstance().info("Updated session info for client " + client->getFullName() + 
                               ", total sessions: " + std::to_string(client->getSessionsCompleted()));
@@ -279,7 +1031,7 @@ int ClientService::getClientCompletedSessions(int clientId) const {
 
 // Client budget management
 bool ClientService::updateClientBudget(int clientId, double amount, bool isAddition) {
-    auto client = getClientById(clientId);
+    auto client = clients.getForWrite(clientId);
     if (!client) {
         return false;
     }
@@ -294,7 +1046,10 @@ bool ClientService::updateClientBudget(int clientId, double amount, bool isAddit
                                   client->getFullName());
     }
     
-    saveClients();
+    if (aggregatesBuilt) {
+        columns.setBudget(clientId, client->getBudget());
+    }
+    recordMutation(OP_BUDGET, clientId, {FieldParser::formatDouble(client->getBudget())});
     return true;
 }
 
@@ -308,43 +1063,134 @@ double ClientService::getClientBudget(int clientId) const {
 }
 
 // Analytics methods
+// Both counters only grow, so their sum changes whenever either does
+uint64_t ClientService::analyticsVersion() const {
+    return modificationVersion + SymbolTable::aiModels().getRenameCount();
+}
+
 std::map<std::string, int> ClientService::getPopularAIModels() const {
-    std::map<std::string, int> modelCounts;
+    buildAggregates();
+    assert(checkAggregates());
+    return countMemo.get("popularAIModels", analyticsVersion(), [this]() {
+        return countInterestsByName(modelInterestCounts);
+    });
+}
+
+double ClientService::getAverageClientSessions() const {
+    if (clients.empty()) {
+        return 0.0;
+    }
     
-    for (const auto& client : clients) {
-        const auto& interests = client->getAIModelsOfInterest();
-        for (const auto& model : interests) {
-            modelCounts[model]++;
-        }
+    buildAggregates();
+    assert(checkAggregates());
+    return static_cast<double>(totalSessions) / clients.size();
+}
+
+std::vector<std::shared_ptr<Client>> ClientService::getTopClients(int count) const {
+    if (count <= 0) {
+        return {};
     }
     
-    return modelCounts;
+    // Most completed sessions first; ties go to the lower client ID
+    buildAggregates();
+    return resolveClients(sessionLeaderboard.top(static_cast<size_t>(count)));
 }
 
-double ClientService::getAverageClientSessions() const {
+double ClientService::getTotalClientBudget() const {
+    buildAggregates();
+    return figureMemo.get("totalBudget", analyticsVersion(), [this]() { return columns.sumBudget(); });
+}
+
+double ClientService::getAverageClientBudget() const {
     if (clients.empty()) {
         return 0.0;
     }
     
-    int totalSessions = 0;
+    return getTotalClientBudget() / clients.size();
+}
+
+std::vector<std::shared_ptr<Client>> ClientService::getClientsWithBudgetAtLeast(double minimum) const {
+    buildAggregates();
+    return resolveClients(columns.findBudgetAtLeast(minimum));
+}
+
+std::vector<std::shared_ptr<Client>> ClientService::getClientsRegisteredBetween(const std::string& fromDate,
+                                                                                const std::string& toDate) const {
+    buildAggregates();
+    return resolveClients(columns.findRegisteredBetween(ClientColumns::encodeDate(fromDate),
+                                                        ClientColumns::encodeDate(toDate)));
+}
+
+// Clients whose last session was before date, including those with none
+std::vector<std::shared_ptr<Client>> ClientService::getClientsInactiveSince(const std::string& date) const {
+    buildAggregates();
+    return resolveClients(columns.findInactiveSince(ClientColumns::encodeDate(date)));
+}
+
+std::vector<size_t> ClientService::getSessionHistogram(int bucketWidth, size_t bucketCount) const {
+    buildAggregates();
+    std::string key = "sessionHistogram:" + std::to_string(bucketWidth) + ":" + std::to_string(bucketCount);
+    return histogramMemo.get(key, analyticsVersion(), [this, bucketWidth, bucketCount]() {
+        return columns.sessionHistogram(bucketWidth, bucketCount);
+    });
+}
+
+uint64_t ClientService::getModificationVersion() const {
+    return modificationVersion;
+}
+
+MemoStats ClientService::getAnalyticsMemoStats() const {
+    MemoStats stats = countMemo.getStats();
+    stats += figureMemo.getStats();
+    stats += histogramMemo.getStats();
+    return stats;
+}
+
+bool ClientService::checkAggregates() const {
+    if (!aggregatesBuilt) {
+        return true;
+    }
+    
+    std::unordered_map<Symbol, int> modelCounts;
+    long long sessions = 0;
     for (const auto& client : clients) {
-        totalSessions += client->getSessionsCompleted();
+        for (Symbol model : client->getAIModelSymbols()) {
+            modelCounts[model]++;
+        }
+        sessions += client->getSessionsCompleted();
+        if (sessionLeaderboard.getScore(client->getClientId()) != client->getSessionsCompleted() ||
+            !sessionLeaderboard.contains(client->getClientId())) {
+            Logger::getInstance().error("Client aggregates: leaderboard entry for client " +
+                                        std::to_string(client->getClientId()) + " is stale");
+            return false;
+        }
+        if (!columns.matches(*client)) {
+            Logger::getInstance().error("Client aggregates: column row for client " +
+                                        std::to_string(client->getClientId()) + " is stale");
+            return false;
+        }
     }
     
-    return static_cast<double>(totalSessions) / clients.size();
+    bool consistent = true;
+    if (columns.size() != clients.size()) {
+        Logger::getInstance().error("Client aggregates: columns hold " + std::to_string(columns.size()) +
+                                    " clients, expected " + std::to_string(clients.size()));
+        consistent = false;
+    }
+    if (sessionLeaderboard.size() != clients.size()) {
+        Logger::getInstance().error("Client aggregates: leaderboard holds " +
+                                    std::to_string(sessionLeaderboard.size()) + " clients, expected " +
+                                    std::to_string(clients.size()));
+        consistent = false;
+    }
+    if (modelCounts != modelInterestCounts) {
+        Logger::getInstance().error("Client aggregates: maintained AI model interest counts differ from recompute");
+        consistent = false;
+    }
+    if (sessions != totalSessions) {
+        Logger::getInstance().error("Client aggregates: maintained session total " + std::to_string(totalSessions) +
+                                    " differs from recompute " + std::to_string(sessions));
+        consistent = false;
+    }
+    return consistent;
 }
-
-std::vector<std::shared_ptr<Client>> ClientService::getTopClients(int count) const {
-    // Create a copy of clients
-    auto sortedClients = clients;
-    
-    // Sort by number of completed sessions (descending)
-    std::sort(sortedClients.begin(), sortedClients.end(),
-              [](const std::shared_ptr<Client>& a, const std::shared_ptr<Client>& b) {
-                  return a->getSessionsCompleted() > b->getSessionsCompleted();
-              });
-    
-    // Return the requested number (or all if count is larger)
-    int resultCount = std::min(static_cast<int>(sortedClients.size()), count);
-    return std::vector<std::shared_ptr<Client>>(sortedClients.begin(), sortedClients.begin() + resultCount);
-}
\ No newline at end of file
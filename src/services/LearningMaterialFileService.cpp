@@ -0,0 +1,128 @@
+#include "include/services/LearningMaterialFileService.h"
+#include "include/utils/Exception.h"
+
+namespace {
+    // Snapshot column order; bump MATERIAL_SCHEMA_VERSION when it changes
+    enum MaterialColumn {
+        COL_ID, COL_TITLE, COL_DESCRIPTION, COL_TYPE, COL_FORMAT, COL_AUTHOR,
+        COL_CREATED, COL_MODELS, COL_TAGS, COL_DIFFICULTY, COL_URL, COL_LOCAL_PATH,
+        COL_MINUTES, COL_RATING, COL_USAGE
+    };
+
+    const uint32_t MATERIAL_SCHEMA_VERSION = 1;
+    const size_t MATERIAL_TEXT_FIELDS = 15;
+}
+
+LearningMaterialFileService::LearningMaterialFileService(const std::string& filename, StorageFormat format)
+    : FileService<LearningMaterial>(filename, format) {}
+
+std::string LearningMaterialFileService::serializeObject(const LearningMaterial& material) const {
+    std::stringstream ss;
+    ss << material.getMaterialId() << "|"
+       << sanitizeField(material.getTitle()) << "|"
+       << sanitizeField(material.getDescription()) << "|"
+       << sanitizeField(material.getType()) << "|"
+       << sanitizeField(material.getFormat()) << "|"
+       << sanitizeField(material.getAuthor()) << "|"
+       << sanitizeField(material.getCreationDate()) << "|"
+       << joinInts(material.getAIModelIds(), ';') << "|"
+       << joinFields(material.getTags(), ';') << "|"
+       << material.getDifficultyLevel() << "|"
+       << sanitizeField(material.getURL()) << "|"
+       << sanitizeField(material.getLocalPath()) << "|"
+       << material.getEstimatedTimeMinutes() << "|"
+       << FieldParser::formatDouble(material.getRating()) << "|"
+       << material.getUsageCount();
+    return ss.str();
+}
+
+LearningMaterial LearningMaterialFileService::deserializeObject(const std::string& data) const {
+    FieldView fields[MATERIAL_TEXT_FIELDS];
+    if (FieldTokenizer(data).split(fields, MATERIAL_TEXT_FIELDS) < MATERIAL_TEXT_FIELDS) {
+        throw FileException("Invalid learning material data format");
+    }
+
+    LearningMaterial material(parseIntField(fields[0], "material ID"), fields[1].str(),
+                              fields[2].str(), fields[3].str(), fields[4].str(), fields[5].str());
+    material.setCreationDate(fields[6].str());
+    material.setDifficultyLevel(parseIntField(fields[9], "difficulty level"));
+    material.setURL(fields[10].str());
+    material.setLocalPath(fields[11].str());
+    material.setEstimatedTimeMinutes(parseIntField(fields[12], "estimated time"));
+
+    // The running average is seeded before the usage count it is weighted by
+    material.updateRating(parseDoubleField(fields[13], "rating"));
+    material.setUsageCount(parseIntField(fields[14], "usage count"));
+
+    FieldView item;
+    FieldTokenizer models(fields[7], ';');
+    while (models.next(item)) {
+        if (!item.empty()) {
+            material.addAIModel(parseIntField(item, "AI model ID"));
+        }
+    }
+
+    FieldTokenizer tags(fields[8], ';');
+    while (tags.next(item)) {
+        if (!item.empty()) {
+            material.addTag(item.str());
+        }
+    }
+
+    return material;
+}
+
+// Snapshot format
+bool LearningMaterialFileService::supportsSnapshot() const {
+    return true;
+}
+
+uint32_t LearningMaterialFileService::getSnapshotSchemaVersion() const {
+    return MATERIAL_SCHEMA_VERSION;
+}
+
+void LearningMaterialFileService::encodeRecord(const LearningMaterial& material, SnapshotBuilder& builder) const {
+    builder.putInt(material.getMaterialId());
+    builder.putString(material.getTitle());
+    builder.putString(material.getDescription());
+    builder.putString(material.getType());
+    builder.putString(material.getFormat());
+    builder.putString(material.getAuthor());
+    builder.putString(material.getCreationDate());
+    builder.putIntList(material.getAIModelIds());
+    builder.putStringList(material.getTags());
+    builder.putInt(material.getDifficultyLevel());
+    builder.putString(material.getURL());
+    builder.putString(material.getLocalPath());
+    builder.putInt(material.getEstimatedTimeMinutes());
+    builder.putDouble(material.getRating());
+    builder.putInt(material.getUsageCount());
+}
+
+LearningMaterial LearningMaterialFileService::decodeRecord(const SnapshotView& view, size_t row) const {
+    LearningMaterial material(static_cast<int>(view.getInt(COL_ID, row)),
+                              view.getString(COL_TITLE, row),
+                              view.getString(COL_DESCRIPTION, row),
+                              view.getString(COL_TYPE, row),
+                              view.getString(COL_FORMAT, row),
+                              view.getString(COL_AUTHOR, row));
+    material.setCreationDate(view.getString(COL_CREATED, row));
+    material.setDifficultyLevel(static_cast<int>(view.getInt(COL_DIFFICULTY, row)));
+    material.setURL(view.getString(COL_URL, row));
+    material.setLocalPath(view.getString(COL_LOCAL_PATH, row));
+    material.setEstimatedTimeMinutes(static_cast<int>(view.getInt(COL_MINUTES, row)));
+    material.updateRating(view.getDouble(COL_RATING, row));
+    material.setUsageCount(static_cast<int>(view.getInt(COL_USAGE, row)));
+
+    size_t models = view.getListSize(COL_MODELS, row);
+    for (size_t i = 0; i < models; i++) {
+        material.addAIModel(static_cast<int>(view.getIntListItem(COL_MODELS, row, i)));
+    }
+
+    size_t tags = view.getListSize(COL_TAGS, row);
+    for (size_t i = 0; i < tags; i++) {
+        material.addTag(view.getStringListItem(COL_TAGS, row, i));
+    }
+
+    return material;
+}
@@ -0,0 +1,388 @@
+#include "include/services/MutationJournal.h"
+#include "include/utils/MappedFile.h"
+#include "include/utils/FileSync.h"
+#include "include/utils/Logger.h"
+#include <chrono>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <fcntl.h>
+
+#ifdef _WIN32
+#include <io.h>
+#define JOURNAL_OPEN(path) _open(path, _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, 0644)
+#define JOURNAL_WRITE _write
+#define JOURNAL_SYNC _commit
+#define JOURNAL_DUP _dup
+#define JOURNAL_CLOSE _close
+#define JOURNAL_TRUNCATE(fd, size) _chsize(fd, static_cast<long>(size))
+#else
+#include <unistd.h>
+#define JOURNAL_OPEN(path) ::open(path, O_WRONLY | O_CREAT | O_APPEND, 0644)
+#define JOURNAL_WRITE ::write
+#define JOURNAL_SYNC ::fsync
+#define JOURNAL_DUP ::dup
+#define JOURNAL_CLOSE ::close
+#define JOURNAL_TRUNCATE(fd, size) ::ftruncate(fd, static_cast<off_t>(size))
+#endif
+
+namespace {
+    // Frame: [u32 payload length][u32 checksum][payload]
+    // Payload: [u8 type][i32 id][u32 field count]([u32 length][bytes])*
+    const size_t FRAME_HEADER_SIZE = 8;
+
+    uint32_t checksum(const char* data, size_t length) {
+        // FNV-1a
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < length; i++) {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    void putU32(std::string& out, uint32_t value) {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    uint32_t getU32(const char* data) {
+        uint32_t value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    std::string encode(const JournalRecord& record) {
+        std::string payload;
+        payload.push_back(static_cast<char>(record.type));
+        putU32(payload, static_cast<uint32_t>(record.id));
+        putU32(payload, static_cast<uint32_t>(record.fields.size()));
+        for (const auto& field : record.fields) {
+            putU32(payload, static_cast<uint32_t>(field.size()));
+            payload.append(field);
+        }
+
+        std::string frame;
+        frame.reserve(FRAME_HEADER_SIZE + payload.size());
+        putU32(frame, static_cast<uint32_t>(payload.size()));
+        putU32(frame, checksum(payload.data(), payload.size()));
+        frame.append(payload);
+        return frame;
+    }
+
+    // Decode one payload; returns false if it is malformed
+    bool decode(const char* data, size_t length, JournalRecord& record) {
+        if (length < 9) {
+            return false;
+        }
+
+        record.type = static_cast<uint8_t>(data[0]);
+        record.id = static_cast<int>(getU32(data + 1));
+        uint32_t fieldCount = getU32(data + 5);
+        record.fields.clear();
+
+        size_t offset = 9;
+        for (uint32_t i = 0; i < fieldCount; i++) {
+            if (offset + 4 > length) {
+                return false;
+            }
+            uint32_t fieldLength = getU32(data + offset);
+            offset += 4;
+            if (offset + fieldLength > length) {
+                return false;
+            }
+            record.fields.push_back(std::string(data + offset, fieldLength));
+            offset += fieldLength;
+        }
+
+        return offset == length;
+    }
+}
+
+// Constructor
+MutationJournal::MutationJournal(const std::string& filename, JournalSyncPolicy policy, int syncIntervalMs)
+    : filename(filename), fd(-1), syncPolicy(policy), syncIntervalMs(syncIntervalMs),
+      recordCount(0), sizeBytes(0), unsyncedWrites(false), writeGeneration(0), stopSync(false) {
+    startSyncThread();
+}
+
+// Destructor
+MutationJournal::~MutationJournal() {
+    stopSyncThread();
+
+    std::lock_guard<std::mutex> lock(journalMutex);
+    if (fd >= 0) {
+        syncLocked();
+        JOURNAL_CLOSE(fd);
+        fd = -1;
+    }
+}
+
+bool MutationJournal::openForAppend() {
+    if (fd >= 0) {
+        return true;
+    }
+
+    fd = JOURNAL_OPEN(filename.c_str());
+    if (fd < 0) {
+        Logger::getInstance().error("Could not open journal for appending: " + filename);
+        return false;
+    }
+
+    // Appends are synced through fd, but a freshly created journal (or the
+    // rename that set the old one aside) only survives once its directory is
+    if (!FileSync::syncParentDirectory(filename)) {
+        Logger::getInstance().error("Could not sync journal directory: " + filename);
+        JOURNAL_CLOSE(fd);
+        fd = -1;
+        return false;
+    }
+    return true;
+}
+
+// Replay
+size_t MutationJournal::replay(const std::function<void(const JournalRecord&)>& apply) {
+    std::lock_guard<std::mutex> lock(journalMutex);
+
+    size_t validBytes = 0;
+    size_t fileBytes = 0;
+
+    // Records from an interrupted compaction predate the live journal
+    size_t applied = replayFile(getCompactingFilename(), apply, validBytes, fileBytes);
+
+    size_t liveRecords = replayFile(filename, apply, validBytes, fileBytes);
+    applied += liveRecords;
+
+    // Drop a torn tail so new records are not appended after garbage
+    if (validBytes < fileBytes) {
+        Logger::getInstance().warning("Discarding " + std::to_string(fileBytes - validBytes) +
+                                      " bytes of incomplete journal data in " + filename);
+        if (openForAppend()) {
+            JOURNAL_TRUNCATE(fd, validBytes);
+        }
+    }
+
+    recordCount = liveRecords;
+    sizeBytes = validBytes;
+    return applied;
+}
+
+size_t MutationJournal::replayFile(const std::string& path,
+                                   const std::function<void(const JournalRecord&)>& apply,
+                                   size_t& validBytes, size_t& fileBytes) {
+    validBytes = 0;
+    fileBytes = 0;
+
+    MappedFile file;
+    if (!file.open(path)) {
+        return 0;   // No journal yet
+    }
+
+    const char* data = file.getData();
+    size_t size = file.getSize();
+    size_t offset = 0;
+    size_t applied = 0;
+    JournalRecord record;
+
+    while (offset + FRAME_HEADER_SIZE <= size) {
+        uint32_t payloadLength = getU32(data + offset);
+        uint32_t expected = getU32(data + offset + 4);
+        const char* payload = data + offset + FRAME_HEADER_SIZE;
+
+        if (offset + FRAME_HEADER_SIZE + payloadLength > size ||
+            checksum(payload, payloadLength) != expected ||
+            !decode(payload, payloadLength, record)) {
+            break;
+        }
+
+        apply(record);
+        applied++;
+        offset += FRAME_HEADER_SIZE + payloadLength;
+    }
+
+    validBytes = offset;
+    fileBytes = size;
+    return applied;
+}
+
+// Append
+bool MutationJournal::append(const JournalRecord& record) {
+    return writeFrames(encode(record), 1);
+}
+
+bool MutationJournal::appendBatch(const std::vector<JournalRecord>& records) {
+    if (records.empty()) {
+        return true;
+    }
+
+    std::string frames;
+    for (const auto& record : records) {
+        frames.append(encode(record));
+    }
+    return writeFrames(frames, records.size());
+}
+
+bool MutationJournal::writeFrames(const std::string& frames, size_t count) {
+    std::lock_guard<std::mutex> lock(journalMutex);
+    if (!openForAppend()) {
+        return false;
+    }
+
+    size_t written = 0;
+    while (written < frames.size()) {
+        auto result = JOURNAL_WRITE(fd, frames.data() + written, static_cast<unsigned>(frames.size() - written));
+        if (result <= 0) {
+            Logger::getInstance().error("Failed to append to journal: " + filename);
+            return false;
+        }
+        written += static_cast<size_t>(result);
+    }
+
+    recordCount += count;
+    sizeBytes += frames.size();
+    unsyncedWrites = true;
+    writeGeneration++;
+
+    if (syncPolicy == JournalSyncPolicy::EveryWrite) {
+        return syncLocked();
+    }
+    return true;
+}
+
+// Sync
+bool MutationJournal::sync() {
+    std::lock_guard<std::mutex> lock(journalMutex);
+    return syncLocked();
+}
+
+bool MutationJournal::syncLocked() {
+    if (fd < 0 || !unsyncedWrites) {
+        return true;
+    }
+    unsyncedWrites = false;
+    return JOURNAL_SYNC(fd) == 0;
+}
+
+// Truncate
+bool MutationJournal::truncate() {
+    std::lock_guard<std::mutex> lock(journalMutex);
+    if (!openForAppend()) {
+        return false;
+    }
+
+    if (JOURNAL_TRUNCATE(fd, 0) != 0) {
+        Logger::getInstance().error("Failed to truncate journal: " + filename);
+        return false;
+    }
+
+    // A full snapshot also supersedes records left by a failed compaction
+    std::remove(getCompactingFilename().c_str());
+
+    recordCount = 0;
+    sizeBytes = 0;
+    unsyncedWrites = true;
+    writeGeneration++;
+    return syncLocked();
+}
+
+// Compaction support
+bool MutationJournal::beginCompaction(size_t& recordsMoved, uint64_t& bytesMoved) {
+    std::lock_guard<std::mutex> lock(journalMutex);
+
+    std::string compacting = getCompactingFilename();
+    std::ifstream pending(compacting);
+    if (pending.good()) {
+        return false;   // A previous compaction has not been folded yet
+    }
+
+    if (fd >= 0) {
+        syncLocked();
+        JOURNAL_CLOSE(fd);
+        fd = -1;
+    }
+
+    if (std::rename(filename.c_str(), compacting.c_str()) != 0) {
+        return false;
+    }
+
+    recordsMoved = recordCount;
+    bytesMoved = sizeBytes;
+    recordCount = 0;
+    sizeBytes = 0;
+    unsyncedWrites = false;
+    return true;
+}
+
+void MutationJournal::finishCompaction() {
+    std::lock_guard<std::mutex> lock(journalMutex);
+    std::remove(getCompactingFilename().c_str());
+}
+
+std::string MutationJournal::getCompactingFilename() const {
+    return filename + ".compacting";
+}
+
+// Background sync for the Interval policy
+void MutationJournal::startSyncThread() {
+    if (syncPolicy != JournalSyncPolicy::Interval || syncThread.joinable()) {
+        return;
+    }
+    stopSync = false;
+    syncThread = std::thread(&MutationJournal::syncLoop, this);
+}
+
+void MutationJournal::stopSyncThread() {
+    {
+        std::lock_guard<std::mutex> lock(journalMutex);
+        stopSync = true;
+    }
+    syncSignal.notify_all();
+    if (syncThread.joinable()) {
+        syncThread.join();
+    }
+}
+
+void MutationJournal::syncLoop() {
+    std::unique_lock<std::mutex> lock(journalMutex);
+    while (!stopSync) {
+        syncSignal.wait_for(lock, std::chrono::milliseconds(syncIntervalMs));
+        if (fd < 0 || !unsyncedWrites) {
+            continue;
+        }
+
+        // fsync a duplicate without holding the lock so appends are not
+        // stalled. Rotation or close may retire fd meanwhile; the duplicate
+        // keeps the same file open until its sync is done. The writes count
+        // as synced only if none arrived during it, so a rotation still
+        // syncs the old file itself rather than trusting this one.
+        int target = JOURNAL_DUP(fd);
+        if (target < 0) {
+            continue;
+        }
+        uint64_t generation = writeGeneration;
+        lock.unlock();
+        bool synced = JOURNAL_SYNC(target) == 0;
+        JOURNAL_CLOSE(target);
+        lock.lock();
+        if (synced && generation == writeGeneration) {
+            unsyncedWrites = false;
+        }
+    }
+}
+
+void MutationJournal::setSyncPolicy(JournalSyncPolicy policy, int intervalMs) {
+    stopSyncThread();
+    {
+        std::lock_guard<std::mutex> lock(journalMutex);
+        syncPolicy = policy;
+        syncIntervalMs = intervalMs;
+        syncLocked();
+    }
+    startSyncThread();
+}
+
+JournalSyncPolicy MutationJournal::getSyncPolicy() const { return syncPolicy; }
+
+// Statistics
+std::string MutationJournal::getFilename() const { return filename; }
+size_t MutationJournal::getRecordCount() const { return recordCount; }
+uint64_t MutationJournal::getSizeBytes() const { return sizeBytes; }
@@ -0,0 +1,195 @@
+#include "include/services/PersistenceScheduler.h"
+#include <chrono>
+#include <vector>
+
+// Constructor
+PersistenceScheduler::PersistenceScheduler(MutationJournal& journal, RecordBuilder buildUpsert,
+                                           uint8_t removeType)
+    : journal(journal), buildUpsert(buildUpsert), removeType(removeType), pending(),
+      transactionDirty(), transactionDepth(0), deferred(false), flushIntervalMs(0),
+      stats(), flushInProgress(false), stopTimer(false) {}
+
+// Destructor
+PersistenceScheduler::~PersistenceScheduler() {
+    stopTimerThread();
+}
+
+// Deferred mode
+void PersistenceScheduler::setDeferred(bool enabled, int intervalMs) {
+    stopTimerThread();
+    {
+        std::unique_lock<std::mutex> lock(schedulerMutex);
+        deferred = enabled;
+        flushIntervalMs = intervalMs;
+        if (!enabled) {
+            flushLocked(lock);
+        }
+    }
+    startTimer();
+}
+
+bool PersistenceScheduler::isDeferred() const {
+    std::lock_guard<std::mutex> lock(schedulerMutex);
+    return deferred;
+}
+
+bool PersistenceScheduler::isTracking() const {
+    std::lock_guard<std::mutex> lock(schedulerMutex);
+    return deferred || transactionDepth > 0;
+}
+
+// Dirty tracking
+void PersistenceScheduler::markDirty(int id) {
+    {
+        std::lock_guard<std::mutex> lock(schedulerMutex);
+        if (transactionDepth > 0) {
+            if (!transactionDirty.insert(id).second) {
+                stats.mutationsCoalesced++;
+            }
+            return;
+        }
+    }
+
+    // Build outside the lock; the builder reads service state
+    JournalRecord record = buildUpsert(id);
+
+    std::lock_guard<std::mutex> lock(schedulerMutex);
+    if (pending.count(id) > 0) {
+        stats.mutationsCoalesced++;
+    }
+    pending[id] = record;
+}
+
+void PersistenceScheduler::markRemoved(int id) {
+    std::lock_guard<std::mutex> lock(schedulerMutex);
+    transactionDirty.erase(id);
+    if (pending.count(id) > 0) {
+        stats.mutationsCoalesced++;
+    }
+    pending[id] = JournalRecord(removeType, id);
+}
+
+// Flushing
+bool PersistenceScheduler::flush() {
+    std::unique_lock<std::mutex> lock(schedulerMutex);
+    return flushLocked(lock);
+}
+
+bool PersistenceScheduler::flushLocked(std::unique_lock<std::mutex>& lock) {
+    flushDone.wait(lock, [this]() { return !flushInProgress; });
+    if (pending.empty()) {
+        return true;
+    }
+
+    std::vector<JournalRecord> batch;
+    batch.reserve(pending.size());
+    for (auto& entry : pending) {
+        batch.push_back(entry.second);
+    }
+    std::map<int, JournalRecord> written;
+    written.swap(pending);
+
+    // Write without holding the lock so mutators are not stalled on I/O
+    flushInProgress = true;
+    lock.unlock();
+    bool ok = journal.appendBatch(batch);
+    lock.lock();
+    flushInProgress = false;
+    flushDone.notify_all();
+
+    if (!ok) {
+        // Keep anything not superseded while we were writing for the next flush
+        for (auto& entry : written) {
+            pending.insert(entry);
+        }
+        return false;
+    }
+
+    stats.flushes++;
+    stats.recordsWritten += batch.size();
+    return true;
+}
+
+void PersistenceScheduler::discardPending() {
+    std::lock_guard<std::mutex> lock(schedulerMutex);
+    pending.clear();
+    transactionDirty.clear();
+}
+
+// Transactions
+void PersistenceScheduler::beginTransaction() {
+    std::lock_guard<std::mutex> lock(schedulerMutex);
+    transactionDepth++;
+}
+
+bool PersistenceScheduler::commitTransaction() {
+    std::set<int> dirty;
+    {
+        std::lock_guard<std::mutex> lock(schedulerMutex);
+        if (transactionDepth == 0) {
+            return true;
+        }
+        if (--transactionDepth > 0) {
+            return true;
+        }
+        dirty.swap(transactionDirty);
+    }
+
+    std::map<int, JournalRecord> built;
+    for (int id : dirty) {
+        built[id] = buildUpsert(id);
+    }
+
+    std::unique_lock<std::mutex> lock(schedulerMutex);
+    for (auto& entry : built) {
+        pending[entry.first] = entry.second;
+    }
+    return flushLocked(lock);
+}
+
+bool PersistenceScheduler::inTransaction() const {
+    std::lock_guard<std::mutex> lock(schedulerMutex);
+    return transactionDepth > 0;
+}
+
+size_t PersistenceScheduler::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(schedulerMutex);
+    return pending.size() + transactionDirty.size();
+}
+
+PersistenceStats PersistenceScheduler::getStats() const {
+    std::lock_guard<std::mutex> lock(schedulerMutex);
+    return stats;
+}
+
+// Background timer for deferred mode
+void PersistenceScheduler::startTimer() {
+    std::lock_guard<std::mutex> lock(schedulerMutex);
+    if (!deferred || flushIntervalMs <= 0 || timerThread.joinable()) {
+        return;
+    }
+    stopTimer = false;
+    timerThread = std::thread(&PersistenceScheduler::timerLoop, this);
+}
+
+void PersistenceScheduler::stopTimerThread() {
+    {
+        std::lock_guard<std::mutex> lock(schedulerMutex);
+        stopTimer = true;
+    }
+    timerSignal.notify_all();
+    if (timerThread.joinable()) {
+        timerThread.join();
+    }
+}
+
+void PersistenceScheduler::timerLoop() {
+    std::unique_lock<std::mutex> lock(schedulerMutex);
+    while (!stopTimer) {
+        timerSignal.wait_for(lock, std::chrono::milliseconds(flushIntervalMs));
+        // Transactions flush on commit; don't split them
+        if (!stopTimer && transactionDepth == 0) {
+            flushLocked(lock);
+        }
+    }
+}
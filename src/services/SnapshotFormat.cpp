@@ -0,0 +1,461 @@
+#include "include/services/SnapshotFormat.h"
+#include "include/utils/Exception.h"
+#include <fstream>
+#include <cstring>
+#include <limits>
+
+namespace {
+    const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    size_t alignTo8(size_t offset) {
+        return (offset + 7) & ~static_cast<size_t>(7);
+    }
+
+    void writePadding(std::ofstream& file, size_t& written, size_t target) {
+        static const char zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+        if (target > written) {
+            file.write(zeros, target - written);
+            written = target;
+        }
+    }
+
+    template <typename V>
+    void writeArray(std::ofstream& file, size_t& written, const std::vector<V>& values) {
+        if (!values.empty()) {
+            file.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(V));
+            written += values.size() * sizeof(V);
+        }
+    }
+
+    bool isListType(SnapshotColumnType type) {
+        return type == SnapshotColumnType::IntList || type == SnapshotColumnType::StringList;
+    }
+
+    // [offset, offset + length) lies within [0, limit), without overflow
+    bool fitsWithin(uint64_t offset, uint64_t length, uint64_t limit) {
+        return offset <= limit && length <= limit - offset;
+    }
+
+    // Every {offset, length} or {first, count} pair of an array lies within limit
+    bool pairsFitWithin(const char* pairs, uint64_t pairCount, uint64_t limit) {
+        for (uint64_t i = 0; i < pairCount; i++) {
+            uint32_t pair[2];
+            std::memcpy(pair, pairs + i * 8, sizeof(pair));
+            if (!fitsWithin(pair[0], pair[1], limit)) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+const char SnapshotView::MAGIC[8] = {'C', 'R', 'M', 'S', 'N', 'A', 'P', '\0'};
+
+// ---------------------------------------------------------------------------
+// SnapshotBuilder
+// ---------------------------------------------------------------------------
+
+SnapshotBuilder::SnapshotBuilder() : columns(), heap(), recordCount(0), cursor(0) {}
+
+void SnapshotBuilder::beginRecord() {
+    if (recordCount > 0) {
+        finishRecord();
+    }
+    recordCount++;
+    cursor = 0;
+}
+
+void SnapshotBuilder::finishRecord() const {
+    if (cursor != columns.size()) {
+        throw FileException("Snapshot record has " + std::to_string(cursor) +
+                            " columns, expected " + std::to_string(columns.size()));
+    }
+}
+
+SnapshotBuilder::Column& SnapshotBuilder::nextColumn(SnapshotColumnType type) {
+    if (recordCount == 0) {
+        throw FileException("Snapshot field written before beginRecord()");
+    }
+
+    // The first record defines the schema
+    if (recordCount == 1 && cursor == columns.size()) {
+        columns.push_back(Column(type));
+    }
+
+    if (cursor >= columns.size() || columns[cursor].type != type) {
+        throw FileException("Snapshot column " + std::to_string(cursor) + " does not match the schema");
+    }
+
+    return columns[cursor++];
+}
+
+void SnapshotBuilder::appendString(std::vector<uint32_t>& refs, const char* data, size_t length) {
+    if (heap.size() + length > std::numeric_limits<uint32_t>::max()) {
+        throw FileException("Snapshot string heap exceeds 4 GB");
+    }
+    refs.push_back(static_cast<uint32_t>(heap.size()));
+    refs.push_back(static_cast<uint32_t>(length));
+    heap.append(data, length);
+}
+
+void SnapshotBuilder::putInt(int64_t value) {
+    nextColumn(SnapshotColumnType::Int).ints.push_back(value);
+}
+
+void SnapshotBuilder::putDouble(double value) {
+    nextColumn(SnapshotColumnType::Double).doubles.push_back(value);
+}
+
+void SnapshotBuilder::putString(const std::string& value) {
+    putString(value.data(), value.size());
+}
+
+void SnapshotBuilder::putString(const char* data, size_t length) {
+    Column& column = nextColumn(SnapshotColumnType::String);
+    appendString(column.refs, data, length);
+}
+
+void SnapshotBuilder::putIntList(const std::vector<int>& values) {
+    Column& column = nextColumn(SnapshotColumnType::IntList);
+    column.ranges.push_back(static_cast<uint32_t>(column.ints.size()));
+    column.ranges.push_back(static_cast<uint32_t>(values.size()));
+    column.ints.insert(column.ints.end(), values.begin(), values.end());
+}
+
+void SnapshotBuilder::putStringList(const std::vector<std::string>& values) {
+    Column& column = nextColumn(SnapshotColumnType::StringList);
+    column.ranges.push_back(static_cast<uint32_t>(column.refs.size() / 2));
+    column.ranges.push_back(static_cast<uint32_t>(values.size()));
+    for (const auto& value : values) {
+        appendString(column.refs, value.data(), value.size());
+    }
+}
+
+void SnapshotBuilder::copyRecord(const SnapshotView& view, size_t row) {
+    beginRecord();
+    for (size_t index = 0; index < view.getColumnCount(); index++) {
+        switch (view.getColumnType(index)) {
+            case SnapshotColumnType::Int:
+                putInt(view.getInt(index, row));
+                break;
+            case SnapshotColumnType::Double:
+                putDouble(view.getDouble(index, row));
+                break;
+            case SnapshotColumnType::String: {
+                size_t length = 0;
+                const char* data = view.getStringData(index, row, length);
+                putString(data, length);
+                break;
+            }
+            case SnapshotColumnType::IntList: {
+                Column& column = nextColumn(SnapshotColumnType::IntList);
+                size_t count = view.getListSize(index, row);
+                column.ranges.push_back(static_cast<uint32_t>(column.ints.size()));
+                column.ranges.push_back(static_cast<uint32_t>(count));
+                for (size_t item = 0; item < count; item++) {
+                    column.ints.push_back(view.getIntListItem(index, row, item));
+                }
+                break;
+            }
+            case SnapshotColumnType::StringList: {
+                Column& column = nextColumn(SnapshotColumnType::StringList);
+                size_t count = view.getListSize(index, row);
+                column.ranges.push_back(static_cast<uint32_t>(column.refs.size() / 2));
+                column.ranges.push_back(static_cast<uint32_t>(count));
+                for (size_t item = 0; item < count; item++) {
+                    size_t length = 0;
+                    const char* data = view.getStringListItemData(index, row, item, length);
+                    appendString(column.refs, data, length);
+                }
+                break;
+            }
+        }
+    }
+}
+
+size_t SnapshotBuilder::getRecordCount() const {
+    return recordCount;
+}
+
+bool SnapshotBuilder::writeTo(const std::string& filename, uint32_t schemaVersion) const {
+    if (recordCount > 0) {
+        finishRecord();
+    }
+
+    // Lay out column data, then list items, then the heap
+    std::vector<SnapshotColumnEntry> entries(columns.size());
+    size_t offset = alignTo8(sizeof(SnapshotHeader) + columns.size() * sizeof(SnapshotColumnEntry));
+
+    for (size_t i = 0; i < columns.size(); i++) {
+        entries[i].type = static_cast<uint32_t>(columns[i].type);
+        entries[i].reserved = 0;
+        entries[i].dataOffset = offset;
+        entries[i].itemsOffset = 0;
+        entries[i].itemCount = 0;
+        offset = alignTo8(offset + recordCount * 8);
+    }
+
+    for (size_t i = 0; i < columns.size(); i++) {
+        if (columns[i].type == SnapshotColumnType::IntList) {
+            entries[i].itemsOffset = offset;
+            entries[i].itemCount = columns[i].ints.size();
+            offset = alignTo8(offset + columns[i].ints.size() * 8);
+        } else if (columns[i].type == SnapshotColumnType::StringList) {
+            entries[i].itemsOffset = offset;
+            entries[i].itemCount = columns[i].refs.size() / 2;
+            offset = alignTo8(offset + columns[i].refs.size() * 4);
+        }
+    }
+
+    SnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, SnapshotView::MAGIC, sizeof(header.magic));
+    header.formatVersion = SnapshotView::FORMAT_VERSION;
+    header.byteOrderMark = BYTE_ORDER_MARK;
+    header.schemaVersion = schemaVersion;
+    header.columnCount = static_cast<uint32_t>(columns.size());
+    header.recordCount = recordCount;
+    header.heapOffset = offset;
+    header.heapSize = heap.size();
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    size_t written = 0;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    written += sizeof(header);
+    writeArray(file, written, entries);
+
+    for (size_t i = 0; i < columns.size(); i++) {
+        writePadding(file, written, entries[i].dataOffset);
+        switch (columns[i].type) {
+            case SnapshotColumnType::Int:    writeArray(file, written, columns[i].ints); break;
+            case SnapshotColumnType::Double: writeArray(file, written, columns[i].doubles); break;
+            case SnapshotColumnType::String: writeArray(file, written, columns[i].refs); break;
+            default:                         writeArray(file, written, columns[i].ranges); break;
+        }
+    }
+
+    for (size_t i = 0; i < columns.size(); i++) {
+        if (columns[i].type == SnapshotColumnType::IntList) {
+            writePadding(file, written, entries[i].itemsOffset);
+            writeArray(file, written, columns[i].ints);
+        } else if (columns[i].type == SnapshotColumnType::StringList) {
+            writePadding(file, written, entries[i].itemsOffset);
+            writeArray(file, written, columns[i].refs);
+        }
+    }
+
+    writePadding(file, written, header.heapOffset);
+    file.write(heap.data(), heap.size());
+
+    file.close();
+    return !file.fail();
+}
+
+// ---------------------------------------------------------------------------
+// SnapshotView
+// ---------------------------------------------------------------------------
+
+SnapshotView::SnapshotView() : file(), header(nullptr), columns() {}
+
+SnapshotView::SnapshotView(const std::string& filename) : file(), header(nullptr), columns() {
+    open(filename);
+}
+
+bool SnapshotView::open(const std::string& filename) {
+    header = nullptr;
+    columns.clear();
+
+    if (!file.open(filename)) {
+        return false;
+    }
+
+    const char* base = file.getData();
+    size_t size = file.getSize();
+
+    if (size < sizeof(SnapshotHeader) || std::memcmp(base, MAGIC, sizeof(MAGIC)) != 0) {
+        throw FileException("Not a snapshot file: " + filename);
+    }
+
+    const SnapshotHeader* candidate = reinterpret_cast<const SnapshotHeader*>(base);
+    if (candidate->byteOrderMark != BYTE_ORDER_MARK) {
+        throw FileException("Snapshot written with a different byte order: " + filename);
+    }
+    if (candidate->formatVersion != FORMAT_VERSION) {
+        throw FileException("Unsupported snapshot format version " +
+                            std::to_string(candidate->formatVersion) + ": " + filename);
+    }
+
+    uint64_t records = candidate->recordCount;
+    if (!fitsWithin(sizeof(SnapshotHeader), uint64_t(candidate->columnCount) * sizeof(SnapshotColumnEntry), size) ||
+        !fitsWithin(candidate->heapOffset, candidate->heapSize, size) || records > size / 8) {
+        throw FileException("Truncated snapshot file: " + filename);
+    }
+
+    const SnapshotColumnEntry* directory =
+        reinterpret_cast<const SnapshotColumnEntry*>(base + sizeof(SnapshotHeader));
+    columns.assign(directory, directory + candidate->columnCount);
+
+    // Check every reference once here, so the accessors can follow them
+    // without bounds checks
+    for (const auto& entry : columns) {
+        SnapshotColumnType type = static_cast<SnapshotColumnType>(entry.type);
+        if (entry.type < static_cast<uint32_t>(SnapshotColumnType::Int) ||
+            entry.type > static_cast<uint32_t>(SnapshotColumnType::StringList)) {
+            throw FileException("Unknown snapshot column type " + std::to_string(entry.type) + " in: " + filename);
+        }
+        if (entry.dataOffset % 8 != 0 || !fitsWithin(entry.dataOffset, records * 8, size) ||
+            (isListType(type) && (entry.itemsOffset % 8 != 0 || entry.itemCount > size / 8 ||
+                                  !fitsWithin(entry.itemsOffset, entry.itemCount * 8, size)))) {
+            throw FileException("Truncated snapshot column in: " + filename);
+        }
+
+        const char* data = base + entry.dataOffset;
+        bool valid = true;
+        if (type == SnapshotColumnType::String) {
+            valid = pairsFitWithin(data, records, candidate->heapSize);
+        } else if (isListType(type)) {
+            valid = pairsFitWithin(data, records, entry.itemCount) &&
+                    (type != SnapshotColumnType::StringList ||
+                     pairsFitWithin(base + entry.itemsOffset, entry.itemCount, candidate->heapSize));
+        }
+        if (!valid) {
+            throw FileException("Snapshot reference out of range in: " + filename);
+        }
+    }
+
+    header = candidate;
+    return true;
+}
+
+bool SnapshotView::isOpen() const {
+    return header != nullptr;
+}
+
+bool SnapshotView::isSnapshotFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    char magic[sizeof(MAGIC)];
+    if (!file.read(magic, sizeof(magic))) {
+        return false;
+    }
+    return std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+size_t SnapshotView::getRecordCount() const {
+    return header ? static_cast<size_t>(header->recordCount) : 0;
+}
+
+size_t SnapshotView::getColumnCount() const {
+    return columns.size();
+}
+
+SnapshotColumnType SnapshotView::getColumnType(size_t index) const {
+    if (index >= columns.size()) {
+        throw FileException("Snapshot column " + std::to_string(index) + " does not exist");
+    }
+    return static_cast<SnapshotColumnType>(columns[index].type);
+}
+
+uint32_t SnapshotView::getSchemaVersion() const {
+    return header ? header->schemaVersion : 0;
+}
+
+const SnapshotColumnEntry& SnapshotView::column(size_t index, SnapshotColumnType type) const {
+    if (index >= columns.size() || columns[index].type != static_cast<uint32_t>(type)) {
+        throw FileException("Snapshot column " + std::to_string(index) + " has an unexpected type");
+    }
+    return columns[index];
+}
+
+const uint32_t* SnapshotView::slot(const SnapshotColumnEntry& entry, size_t row) const {
+    return reinterpret_cast<const uint32_t*>(file.getData() + entry.dataOffset + row * 8);
+}
+
+int64_t SnapshotView::getInt(size_t index, size_t row) const {
+    const SnapshotColumnEntry& entry = column(index, SnapshotColumnType::Int);
+    int64_t value;
+    std::memcpy(&value, file.getData() + entry.dataOffset + row * 8, sizeof(value));
+    return value;
+}
+
+double SnapshotView::getDouble(size_t index, size_t row) const {
+    const SnapshotColumnEntry& entry = column(index, SnapshotColumnType::Double);
+    double value;
+    std::memcpy(&value, file.getData() + entry.dataOffset + row * 8, sizeof(value));
+    return value;
+}
+
+const char* SnapshotView::getStringData(size_t index, size_t row, size_t& length) const {
+    const uint32_t* ref = slot(column(index, SnapshotColumnType::String), row);
+    length = ref[1];
+    return file.getData() + header->heapOffset + ref[0];
+}
+
+std::string SnapshotView::getString(size_t index, size_t row) const {
+    size_t length = 0;
+    const char* text = getStringData(index, row, length);
+    return std::string(text, length);
+}
+
+std::vector<int> SnapshotView::getIntList(size_t index, size_t row) const {
+    const SnapshotColumnEntry& entry = column(index, SnapshotColumnType::IntList);
+    const uint32_t* range = slot(entry, row);
+    const char* items = file.getData() + entry.itemsOffset;
+
+    std::vector<int> values;
+    values.reserve(range[1]);
+    for (uint32_t i = 0; i < range[1]; i++) {
+        int64_t value;
+        std::memcpy(&value, items + (range[0] + i) * 8, sizeof(value));
+        values.push_back(static_cast<int>(value));
+    }
+    return values;
+}
+
+std::vector<std::string> SnapshotView::getStringList(size_t index, size_t row) const {
+    const SnapshotColumnEntry& entry = column(index, SnapshotColumnType::StringList);
+    const uint32_t* range = slot(entry, row);
+    const uint32_t* refs = reinterpret_cast<const uint32_t*>(file.getData() + entry.itemsOffset);
+    const char* heapBase = file.getData() + header->heapOffset;
+
+    std::vector<std::string> values;
+    values.reserve(range[1]);
+    for (uint32_t i = 0; i < range[1]; i++) {
+        const uint32_t* ref = refs + (range[0] + i) * 2;
+        values.push_back(std::string(heapBase + ref[0], ref[1]));
+    }
+    return values;
+}
+
+size_t SnapshotView::getListSize(size_t index, size_t row) const {
+    if (index >= columns.size() || !isListType(static_cast<SnapshotColumnType>(columns[index].type))) {
+        throw FileException("Snapshot column " + std::to_string(index) + " is not a list");
+    }
+    return slot(columns[index], row)[1];
+}
+
+int64_t SnapshotView::getIntListItem(size_t index, size_t row, size_t item) const {
+    const SnapshotColumnEntry& entry = column(index, SnapshotColumnType::IntList);
+    const uint32_t* range = slot(entry, row);
+    int64_t value;
+    std::memcpy(&value, file.getData() + entry.itemsOffset + (range[0] + item) * 8, sizeof(value));
+    return value;
+}
+
+const char* SnapshotView::getStringListItemData(size_t index, size_t row, size_t item, size_t& length) const {
+    const SnapshotColumnEntry& entry = column(index, SnapshotColumnType::StringList);
+    const uint32_t* range = slot(entry, row);
+    const uint32_t* ref = reinterpret_cast<const uint32_t*>(file.getData() + entry.itemsOffset) +
+                          (range[0] + item) * 2;
+    length = ref[1];
+    return file.getData() + header->heapOffset + ref[0];
+}
+
+std::string SnapshotView::getStringListItem(size_t index, size_t row, size_t item) const {
+    size_t length = 0;
+    const char* data = getStringListItemData(index, row, item, length);
+    return std::string(data, length);
+}
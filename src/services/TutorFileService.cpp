@@ -0,0 +1,155 @@
+#include "include/services/TutorFileService.h"
+#include "include/utils/Exception.h"
+#include <algorithm>
+
+namespace {
+    // Snapshot column order; bump TUTOR_SCHEMA_VERSION when it changes
+    enum TutorColumn {
+        COL_ID, COL_USERNAME, COL_PASSWORD, COL_FIRST_NAME, COL_LAST_NAME, COL_EMAIL,
+        COL_PHONE, COL_QUALIFICATION, COL_EXPERIENCE, COL_HOURLY_RATE, COL_SESSIONS,
+        COL_AVERAGE_RATING, COL_SPECIALIZATIONS, COL_DOMAINS, COL_EXPERIENCE_MODELS,
+        COL_EXPERIENCE_LEVELS
+    };
+
+    const uint32_t TUTOR_SCHEMA_VERSION = 1;
+    const size_t TUTOR_TEXT_FIELDS = 15;
+}
+
+TutorFileService::TutorFileService(const std::string& filename, StorageFormat format)
+    : FileService<Tutor>(filename, format) {}
+
+std::string TutorFileService::serializeObject(const Tutor& tutor) const {
+    std::vector<std::string> experience;
+    for (const auto& entry : tutor.getAllAIModelExperience()) {
+        experience.push_back(entry.first + ":" + std::to_string(entry.second));
+    }
+
+    std::stringstream ss;
+    ss << tutor.getUserId() << "|"
+       << sanitizeField(tutor.getUsername()) << "|"
+       << sanitizeField(tutor.getPassword()) << "|"
+       << sanitizeField(tutor.getFirstName()) << "|"
+       << sanitizeField(tutor.getLastName()) << "|"
+       << sanitizeField(tutor.getEmail()) << "|"
+       << sanitizeField(tutor.getPhone()) << "|"
+       << sanitizeField(tutor.getQualification()) << "|"
+       << tutor.getExperienceYears() << "|"
+       << FieldParser::formatDouble(tutor.getHourlyRate()) << "|"
+       << tutor.getSessionsCompleted() << "|"
+       << FieldParser::formatDouble(tutor.getAverageRating()) << "|"
+       << joinFields(tutor.getAISpecializations(), ';') << "|"
+       << joinFields(tutor.getDomainExpertise(), ';') << "|"
+       << joinFields(experience, ';');
+    return ss.str();
+}
+
+Tutor TutorFileService::deserializeObject(const std::string& data) const {
+    FieldView fields[TUTOR_TEXT_FIELDS];
+    if (FieldTokenizer(data).split(fields, TUTOR_TEXT_FIELDS) < TUTOR_TEXT_FIELDS) {
+        throw FileException("Invalid tutor data format");
+    }
+
+    Tutor tutor(parseIntField(fields[0], "tutor ID"), fields[1].str(), fields[2].str(),
+                fields[3].str(), fields[4].str(), fields[5].str(), fields[6].str(),
+                std::vector<std::string>(), std::vector<std::string>(), fields[7].str(),
+                parseIntField(fields[8], "experience years"),
+                parseDoubleField(fields[9], "hourly rate"));
+
+    // The running average is seeded before the session count it is weighted by
+    tutor.updateRating(parseDoubleField(fields[11], "average rating"));
+    tutor.setSessionsCompleted(parseIntField(fields[10], "session count"));
+
+    FieldView item;
+    FieldTokenizer specializations(fields[12], ';');
+    while (specializations.next(item)) {
+        if (!item.empty()) {
+            tutor.addAISpecialization(SymbolTable::aiModels().internStored(item.str()));
+        }
+    }
+
+    FieldTokenizer domains(fields[13], ';');
+    while (domains.next(item)) {
+        if (!item.empty()) {
+            tutor.addDomainExpertise(item.str());
+        }
+    }
+
+    FieldTokenizer experience(fields[14], ';');
+    while (experience.next(item)) {
+        size_t separator = item.rfind(':');
+        if (separator != FieldView::npos) {
+            tutor.setAIModelExperience(SymbolTable::aiModels().internStored(item.substr(0, separator).str()),
+                                       parseIntField(item.substr(separator + 1), "experience level"));
+        }
+    }
+
+    return tutor;
+}
+
+// Snapshot format
+bool TutorFileService::supportsSnapshot() const {
+    return true;
+}
+
+uint32_t TutorFileService::getSnapshotSchemaVersion() const {
+    return TUTOR_SCHEMA_VERSION;
+}
+
+void TutorFileService::encodeRecord(const Tutor& tutor, SnapshotBuilder& builder) const {
+    std::vector<std::string> models;
+    std::vector<int> levels;
+    for (const auto& entry : tutor.getAllAIModelExperience()) {
+        models.push_back(entry.first);
+        levels.push_back(entry.second);
+    }
+
+    builder.putInt(tutor.getUserId());
+    builder.putString(tutor.getUsername());
+    builder.putString(tutor.getPassword());
+    builder.putString(tutor.getFirstName());
+    builder.putString(tutor.getLastName());
+    builder.putString(tutor.getEmail());
+    builder.putString(tutor.getPhone());
+    builder.putString(tutor.getQualification());
+    builder.putInt(tutor.getExperienceYears());
+    builder.putDouble(tutor.getHourlyRate());
+    builder.putInt(tutor.getSessionsCompleted());
+    builder.putDouble(tutor.getAverageRating());
+    builder.putStringList(tutor.getAISpecializations());
+    builder.putStringList(tutor.getDomainExpertise());
+    builder.putStringList(models);
+    builder.putIntList(levels);
+}
+
+Tutor TutorFileService::decodeRecord(const SnapshotView& view, size_t row) const {
+    Tutor tutor(static_cast<int>(view.getInt(COL_ID, row)),
+                view.getString(COL_USERNAME, row),
+                view.getString(COL_PASSWORD, row),
+                view.getString(COL_FIRST_NAME, row),
+                view.getString(COL_LAST_NAME, row),
+                view.getString(COL_EMAIL, row),
+                view.getString(COL_PHONE, row),
+                std::vector<std::string>(),
+                view.getStringList(COL_DOMAINS, row),
+                view.getString(COL_QUALIFICATION, row),
+                static_cast<int>(view.getInt(COL_EXPERIENCE, row)),
+                view.getDouble(COL_HOURLY_RATE, row));
+    tutor.updateRating(view.getDouble(COL_AVERAGE_RATING, row));
+    tutor.setSessionsCompleted(static_cast<int>(view.getInt(COL_SESSIONS, row)));
+
+    size_t specializations = view.getListSize(COL_SPECIALIZATIONS, row);
+    for (size_t i = 0; i < specializations; i++) {
+        tutor.addAISpecialization(SymbolTable::aiModels().internStored(
+                                      view.getStringListItem(COL_SPECIALIZATIONS, row, i)));
+    }
+
+    size_t experience = std::min(view.getListSize(COL_EXPERIENCE_MODELS, row),
+                                 view.getListSize(COL_EXPERIENCE_LEVELS, row));
+    for (size_t i = 0; i < experience; i++) {
+        tutor.setAIModelExperience(SymbolTable::aiModels().internStored(
+                                       view.getStringListItem(COL_EXPERIENCE_MODELS, row, i)),
+                                   static_cast<int>(view.getIntListItem(COL_EXPERIENCE_LEVELS, row, i)));
+    }
+
+    return tutor;
+}
@@ -0,0 +1,117 @@
+#include "include/services/TutorSchedule.h"
+#include "include/utils/Validation.h"
+
+namespace {
+    // Days from 1970-01-01 to a proleptic Gregorian date, with March as the
+    // first month of a 400-year era so leap days fall at the end
+    int64_t daysFromCivil(int year, int month, int day) {
+        year -= month <= 2 ? 1 : 0;
+        int64_t era = (year >= 0 ? year : year - 399) / 400;
+        int64_t yearOfEra = year - era * 400;
+        int64_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + dayOfEra - 719468;
+    }
+}
+
+// Constructor
+TutorSchedule::TutorSchedule() : bookingsByTutor(), bookings() {}
+
+// Helpers
+bool TutorSchedule::encode(const std::string& date, const std::string& time, int64_t& minutes) {
+    int year, month, day, hour, minute;
+    if (!FieldParser::parseDate(FieldView(date), year, month, day) ||
+        !Validation::parseTime(time.data(), time.size(), hour, minute)) {
+        return false;
+    }
+
+    minutes = daysFromCivil(year, month, day) * 1440 + hour * 60 + minute;
+    return true;
+}
+
+bool TutorSchedule::encodeRange(const std::string& date, const std::string& startTime, int durationMinutes,
+                                int64_t& start, int64_t& end) {
+    if (durationMinutes <= 0 || !encode(date, startTime, start)) {
+        return false;
+    }
+    end = start + durationMinutes;
+    return true;
+}
+
+// Bookings
+bool TutorSchedule::book(int sessionId, int tutorId, const std::string& date, const std::string& startTime,
+                         int durationMinutes) {
+    int64_t start;
+    int64_t end;
+    if (!encodeRange(date, startTime, durationMinutes, start, end)) {
+        return false;
+    }
+
+    release(sessionId);
+    bookingsByTutor[tutorId].insert(start, end, sessionId);
+    bookings[sessionId] = Booking{tutorId, start, end};
+    return true;
+}
+
+bool TutorSchedule::release(int sessionId) {
+    auto found = bookings.find(sessionId);
+    if (found == bookings.end()) {
+        return false;
+    }
+
+    auto tutor = bookingsByTutor.find(found->second.tutorId);
+    tutor->second.remove(found->second.start, sessionId);
+    if (tutor->second.empty()) {
+        bookingsByTutor.erase(tutor);
+    }
+    bookings.erase(found);
+    return true;
+}
+
+void TutorSchedule::clear() {
+    bookingsByTutor.clear();
+    bookings.clear();
+}
+
+// Queries
+bool TutorSchedule::isAvailable(int tutorId, const std::string& date, const std::string& startTime,
+                                int durationMinutes, int ignoreSessionId) const {
+    int64_t start;
+    int64_t end;
+    if (!encodeRange(date, startTime, durationMinutes, start, end)) {
+        return false;
+    }
+
+    auto tutor = bookingsByTutor.find(tutorId);
+    return tutor == bookingsByTutor.end() || !tutor->second.overlaps(start, end, ignoreSessionId);
+}
+
+std::vector<int> TutorSchedule::getConflicts(int tutorId, const std::string& fromDate, const std::string& fromTime,
+                                             const std::string& toDate, const std::string& toTime) const {
+    int64_t start;
+    int64_t end;
+    auto tutor = bookingsByTutor.find(tutorId);
+    if (tutor == bookingsByTutor.end() || !encode(fromDate, fromTime, start) || !encode(toDate, toTime, end)) {
+        return {};
+    }
+    return tutor->second.findOverlapping(start, end);
+}
+
+std::vector<int> TutorSchedule::getConflicts(int tutorId, const std::string& date, const std::string& startTime,
+                                             int durationMinutes) const {
+    int64_t start;
+    int64_t end;
+    auto tutor = bookingsByTutor.find(tutorId);
+    if (tutor == bookingsByTutor.end() || !encodeRange(date, startTime, durationMinutes, start, end)) {
+        return {};
+    }
+    return tutor->second.findOverlapping(start, end);
+}
+
+bool TutorSchedule::isBooked(int sessionId) const {
+    return bookings.count(sessionId) > 0;
+}
+
+size_t TutorSchedule::size() const {
+    return bookings.size();
+}
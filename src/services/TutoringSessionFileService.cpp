@@ -0,0 +1,145 @@
+#include "include/services/TutoringSessionFileService.h"
+#include "include/utils/Exception.h"
+
+namespace {
+    // Snapshot column order; bump SESSION_SCHEMA_VERSION when it changes
+    enum SessionColumn {
+        COL_ID, COL_CLIENT, COL_TUTOR, COL_MODELS, COL_DATE, COL_START_TIME,
+        COL_DURATION, COL_STATUS, COL_RATING, COL_OBJECTIVES, COL_NOTES, COL_TOPICS,
+        COL_SKILLS, COL_HOMEWORK, COL_COST, COL_PAYMENT, COL_REMOTE, COL_PLATFORM
+    };
+
+    const uint32_t SESSION_SCHEMA_VERSION = 1;
+    const size_t SESSION_TEXT_FIELDS = 18;
+}
+
+TutoringSessionFileService::TutoringSessionFileService(const std::string& filename, StorageFormat format)
+    : FileService<TutoringSession>(filename, format) {}
+
+std::string TutoringSessionFileService::serializeObject(const TutoringSession& session) const {
+    std::stringstream ss;
+    ss << session.getSessionId() << "|"
+       << session.getClientId() << "|"
+       << session.getTutorId() << "|"
+       << joinInts(session.getAIModelIds(), ';') << "|"
+       << sanitizeField(session.getSessionDate()) << "|"
+       << sanitizeField(session.getStartTime()) << "|"
+       << session.getDurationMinutes() << "|"
+       << sanitizeField(session.getStatus()) << "|"
+       << FieldParser::formatDouble(session.getClientRating()) << "|"
+       << sanitizeField(session.getLearningObjectives()) << "|"
+       << sanitizeField(session.getSessionNotes()) << "|"
+       << joinFields(session.getTopics(), ';') << "|"
+       << sanitizeField(session.getSkillsGained()) << "|"
+       << sanitizeField(session.getHomeworkAssigned()) << "|"
+       << FieldParser::formatDouble(session.getSessionCost()) << "|"
+       << sanitizeField(session.getPaymentStatus()) << "|"
+       << (session.getIsRemote() ? 1 : 0) << "|"
+       << sanitizeField(session.getPlatform());
+    return ss.str();
+}
+
+TutoringSession TutoringSessionFileService::deserializeObject(const std::string& data) const {
+    FieldView fields[SESSION_TEXT_FIELDS];
+    if (FieldTokenizer(data).split(fields, SESSION_TEXT_FIELDS) < SESSION_TEXT_FIELDS) {
+        throw FileException("Invalid tutoring session data format");
+    }
+
+    // Dates and times are validated here so that scheduling code can rely on them
+    int year, month, day, hour, minute;
+    if (!fields[4].empty() && !FieldParser::parseDate(fields[4], year, month, day)) {
+        throw FileException("Invalid session date: " + fields[4].str());
+    }
+    if (!fields[5].empty() && !FieldParser::parseTime(fields[5], hour, minute)) {
+        throw FileException("Invalid session start time: " + fields[5].str());
+    }
+
+    TutoringSession session(parseIntField(fields[0], "session ID"),
+                            parseIntField(fields[1], "client ID"),
+                            parseIntField(fields[2], "tutor ID"),
+                            std::vector<int>(), fields[4].str(), fields[5].str(),
+                            parseIntField(fields[6], "duration"),
+                            fields[16] == "1", fields[17].str());
+    session.setStatus(fields[7].str());
+    session.setClientRating(parseDoubleField(fields[8], "client rating"));
+    session.setLearningObjectives(fields[9].str());
+    session.setSessionNotes(fields[10].str());
+    session.setSkillsGained(fields[12].str());
+    session.setHomeworkAssigned(fields[13].str());
+    session.setSessionCost(parseDoubleField(fields[14], "session cost"));
+    session.setPaymentStatus(fields[15].str());
+
+    FieldView item;
+    FieldTokenizer models(fields[3], ';');
+    while (models.next(item)) {
+        if (!item.empty()) {
+            session.addAIModel(parseIntField(item, "AI model ID"));
+        }
+    }
+
+    FieldTokenizer topics(fields[11], ';');
+    while (topics.next(item)) {
+        if (!item.empty()) {
+            session.addTopic(item.str());
+        }
+    }
+
+    return session;
+}
+
+// Snapshot format
+bool TutoringSessionFileService::supportsSnapshot() const {
+    return true;
+}
+
+uint32_t TutoringSessionFileService::getSnapshotSchemaVersion() const {
+    return SESSION_SCHEMA_VERSION;
+}
+
+void TutoringSessionFileService::encodeRecord(const TutoringSession& session, SnapshotBuilder& builder) const {
+    builder.putInt(session.getSessionId());
+    builder.putInt(session.getClientId());
+    builder.putInt(session.getTutorId());
+    builder.putIntList(session.getAIModelIds());
+    builder.putString(session.getSessionDate());
+    builder.putString(session.getStartTime());
+    builder.putInt(session.getDurationMinutes());
+    builder.putString(session.getStatus());
+    builder.putDouble(session.getClientRating());
+    builder.putString(session.getLearningObjectives());
+    builder.putString(session.getSessionNotes());
+    builder.putStringList(session.getTopics());
+    builder.putString(session.getSkillsGained());
+    builder.putString(session.getHomeworkAssigned());
+    builder.putDouble(session.getSessionCost());
+    builder.putString(session.getPaymentStatus());
+    builder.putInt(session.getIsRemote() ? 1 : 0);
+    builder.putString(session.getPlatform());
+}
+
+TutoringSession TutoringSessionFileService::decodeRecord(const SnapshotView& view, size_t row) const {
+    TutoringSession session(static_cast<int>(view.getInt(COL_ID, row)),
+                            static_cast<int>(view.getInt(COL_CLIENT, row)),
+                            static_cast<int>(view.getInt(COL_TUTOR, row)),
+                            view.getIntList(COL_MODELS, row),
+                            view.getString(COL_DATE, row),
+                            view.getString(COL_START_TIME, row),
+                            static_cast<int>(view.getInt(COL_DURATION, row)),
+                            view.getInt(COL_REMOTE, row) != 0,
+                            view.getString(COL_PLATFORM, row));
+    session.setStatus(view.getString(COL_STATUS, row));
+    session.setClientRating(view.getDouble(COL_RATING, row));
+    session.setLearningObjectives(view.getString(COL_OBJECTIVES, row));
+    session.setSessionNotes(view.getString(COL_NOTES, row));
+    session.setSkillsGained(view.getString(COL_SKILLS, row));
+    session.setHomeworkAssigned(view.getString(COL_HOMEWORK, row));
+    session.setSessionCost(view.getDouble(COL_COST, row));
+    session.setPaymentStatus(view.getString(COL_PAYMENT, row));
+
+    size_t topics = view.getListSize(COL_TOPICS, row);
+    for (size_t i = 0; i < topics; i++) {
+        session.addTopic(view.getStringListItem(COL_TOPICS, row, i));
+    }
+
+    return session;
+}
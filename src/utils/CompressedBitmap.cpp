@@ -0,0 +1,366 @@
+#include "include/utils/CompressedBitmap.h"
+#include <algorithm>
+#include <iterator>
+
+const size_t CompressedBitmap::ARRAY_MAX;
+const size_t CompressedBitmap::BITMAP_WORDS;
+
+namespace {
+
+inline uint32_t popcount(uint64_t word) {
+#if defined(__GNUC__)
+    return static_cast<uint32_t>(__builtin_popcountll(word));
+#else
+    uint32_t count = 0;
+    for (; word; word &= word - 1) {
+        count++;
+    }
+    return count;
+#endif
+}
+
+inline uint32_t lowestBit(uint64_t word) {
+#if defined(__GNUC__)
+    return static_cast<uint32_t>(__builtin_ctzll(word));
+#else
+    uint32_t index = 0;
+    while (!(word & 1)) {
+        word >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+inline bool testBit(const std::vector<uint64_t>& bits, uint16_t low) {
+    return (bits[low >> 6] >> (low & 63)) & 1;
+}
+
+}
+
+// Container helpers
+bool CompressedBitmap::Container::contains(uint16_t low) const {
+    if (isBitmap()) {
+        return testBit(bits, low);
+    }
+    return std::binary_search(array.begin(), array.end(), low);
+}
+
+size_t CompressedBitmap::findContainer(uint16_t key) const {
+    auto it = std::lower_bound(containers.begin(), containers.end(), key,
+                               [](const Container& container, uint16_t k) { return container.key < k; });
+    return static_cast<size_t>(it - containers.begin());
+}
+
+void CompressedBitmap::toBitmap(Container& container) {
+    container.bits.assign(BITMAP_WORDS, 0);
+    for (uint16_t low : container.array) {
+        container.bits[low >> 6] |= uint64_t(1) << (low & 63);
+    }
+    std::vector<uint16_t>().swap(container.array);
+}
+
+void CompressedBitmap::toArray(Container& container) {
+    std::vector<uint16_t> values;
+    values.reserve(container.cardinality);
+    for (size_t word = 0; word < container.bits.size(); word++) {
+        for (uint64_t w = container.bits[word]; w; w &= w - 1) {
+            values.push_back(static_cast<uint16_t>(word * 64 + lowestBit(w)));
+        }
+    }
+    container.array.swap(values);
+    std::vector<uint64_t>().swap(container.bits);
+}
+
+// Pick the smaller representation after a container has shrunk
+void CompressedBitmap::shrink(Container& container) {
+    if (container.isBitmap() && container.cardinality <= ARRAY_MAX) {
+        toArray(container);
+    }
+}
+
+CompressedBitmap::Container CompressedBitmap::intersect(const Container& left, const Container& right) {
+    Container result;
+    result.key = left.key;
+    result.cardinality = 0;
+
+    if (left.isBitmap() && right.isBitmap()) {
+        result.bits.resize(BITMAP_WORDS);
+        for (size_t word = 0; word < BITMAP_WORDS; word++) {
+            result.bits[word] = left.bits[word] & right.bits[word];
+            result.cardinality += popcount(result.bits[word]);
+        }
+        shrink(result);
+    } else if (left.isBitmap() || right.isBitmap()) {
+        const Container& sparse = left.isBitmap() ? right : left;
+        const Container& dense = left.isBitmap() ? left : right;
+        for (uint16_t low : sparse.array) {
+            if (testBit(dense.bits, low)) {
+                result.array.push_back(low);
+            }
+        }
+        result.cardinality = static_cast<uint32_t>(result.array.size());
+    } else {
+        std::set_intersection(left.array.begin(), left.array.end(),
+                              right.array.begin(), right.array.end(),
+                              std::back_inserter(result.array));
+        result.cardinality = static_cast<uint32_t>(result.array.size());
+    }
+    return result;
+}
+
+CompressedBitmap::Container CompressedBitmap::unite(const Container& left, const Container& right) {
+    Container result;
+    result.key = left.key;
+    result.cardinality = 0;
+
+    if (!left.isBitmap() && !right.isBitmap() && left.array.size() + right.array.size() <= ARRAY_MAX) {
+        std::set_union(left.array.begin(), left.array.end(),
+                       right.array.begin(), right.array.end(),
+                       std::back_inserter(result.array));
+        result.cardinality = static_cast<uint32_t>(result.array.size());
+        return result;
+    }
+
+    result.bits.assign(BITMAP_WORDS, 0);
+    for (const Container* side : {&left, &right}) {
+        if (side->isBitmap()) {
+            for (size_t word = 0; word < BITMAP_WORDS; word++) {
+                result.bits[word] |= side->bits[word];
+            }
+        } else {
+            for (uint16_t low : side->array) {
+                result.bits[low >> 6] |= uint64_t(1) << (low & 63);
+            }
+        }
+    }
+    for (uint64_t word : result.bits) {
+        result.cardinality += popcount(word);
+    }
+    shrink(result);
+    return result;
+}
+
+CompressedBitmap::Container CompressedBitmap::subtract(const Container& left, const Container& right) {
+    Container result;
+    result.key = left.key;
+    result.cardinality = 0;
+
+    if (!left.isBitmap()) {
+        if (right.isBitmap()) {
+            for (uint16_t low : left.array) {
+                if (!testBit(right.bits, low)) {
+                    result.array.push_back(low);
+                }
+            }
+        } else {
+            std::set_difference(left.array.begin(), left.array.end(),
+                                right.array.begin(), right.array.end(),
+                                std::back_inserter(result.array));
+        }
+        result.cardinality = static_cast<uint32_t>(result.array.size());
+        return result;
+    }
+
+    result.bits = left.bits;
+    if (right.isBitmap()) {
+        for (size_t word = 0; word < BITMAP_WORDS; word++) {
+            result.bits[word] &= ~right.bits[word];
+        }
+    } else {
+        for (uint16_t low : right.array) {
+            result.bits[low >> 6] &= ~(uint64_t(1) << (low & 63));
+        }
+    }
+    for (uint64_t word : result.bits) {
+        result.cardinality += popcount(word);
+    }
+    shrink(result);
+    return result;
+}
+
+// Constructor
+CompressedBitmap::CompressedBitmap() : containers() {}
+
+// Single-value updates
+bool CompressedBitmap::add(uint32_t value) {
+    uint16_t key = static_cast<uint16_t>(value >> 16);
+    uint16_t low = static_cast<uint16_t>(value & 0xFFFF);
+
+    size_t index = findContainer(key);
+    if (index == containers.size() || containers[index].key != key) {
+        Container container;
+        container.key = key;
+        container.array.push_back(low);
+        container.cardinality = 1;
+        containers.insert(containers.begin() + index, container);
+        return true;
+    }
+
+    Container& container = containers[index];
+    if (container.isBitmap()) {
+        uint64_t& word = container.bits[low >> 6];
+        uint64_t mask = uint64_t(1) << (low & 63);
+        if (word & mask) {
+            return false;
+        }
+        word |= mask;
+    } else {
+        auto it = std::lower_bound(container.array.begin(), container.array.end(), low);
+        if (it != container.array.end() && *it == low) {
+            return false;
+        }
+        container.array.insert(it, low);
+        if (container.array.size() > ARRAY_MAX) {
+            toBitmap(container);
+        }
+    }
+    container.cardinality++;
+    return true;
+}
+
+bool CompressedBitmap::remove(uint32_t value) {
+    uint16_t key = static_cast<uint16_t>(value >> 16);
+    uint16_t low = static_cast<uint16_t>(value & 0xFFFF);
+
+    size_t index = findContainer(key);
+    if (index == containers.size() || containers[index].key != key) {
+        return false;
+    }
+
+    Container& container = containers[index];
+    if (container.isBitmap()) {
+        uint64_t& word = container.bits[low >> 6];
+        uint64_t mask = uint64_t(1) << (low & 63);
+        if (!(word & mask)) {
+            return false;
+        }
+        word &= ~mask;
+        container.cardinality--;
+        // Convert back only well below the threshold, so a container that
+        // hovers around it doesn't flip representation on every update
+        if (container.cardinality <= ARRAY_MAX / 2) {
+            toArray(container);
+        }
+    } else {
+        auto it = std::lower_bound(container.array.begin(), container.array.end(), low);
+        if (it == container.array.end() || *it != low) {
+            return false;
+        }
+        container.array.erase(it);
+        container.cardinality--;
+    }
+
+    if (container.cardinality == 0) {
+        containers.erase(containers.begin() + index);
+    }
+    return true;
+}
+
+bool CompressedBitmap::contains(uint32_t value) const {
+    uint16_t key = static_cast<uint16_t>(value >> 16);
+    size_t index = findContainer(key);
+    return index < containers.size() && containers[index].key == key &&
+           containers[index].contains(static_cast<uint16_t>(value & 0xFFFF));
+}
+
+void CompressedBitmap::clear() {
+    containers.clear();
+}
+
+size_t CompressedBitmap::size() const {
+    size_t count = 0;
+    for (const auto& container : containers) {
+        count += container.cardinality;
+    }
+    return count;
+}
+
+bool CompressedBitmap::empty() const {
+    return containers.empty();
+}
+
+// Set algebra. Containers are matched by key with a merge over the two
+// sorted container lists; empty results are dropped.
+CompressedBitmap CompressedBitmap::intersect(const CompressedBitmap& other) const {
+    CompressedBitmap result;
+    size_t i = 0, j = 0;
+    while (i < containers.size() && j < other.containers.size()) {
+        if (containers[i].key < other.containers[j].key) {
+            i++;
+        } else if (other.containers[j].key < containers[i].key) {
+            j++;
+        } else {
+            Container container = intersect(containers[i++], other.containers[j++]);
+            if (container.cardinality > 0) {
+                result.containers.push_back(std::move(container));
+            }
+        }
+    }
+    return result;
+}
+
+CompressedBitmap CompressedBitmap::unite(const CompressedBitmap& other) const {
+    CompressedBitmap result;
+    result.containers.reserve(containers.size() + other.containers.size());
+    size_t i = 0, j = 0;
+    while (i < containers.size() || j < other.containers.size()) {
+        if (j == other.containers.size() ||
+            (i < containers.size() && containers[i].key < other.containers[j].key)) {
+            result.containers.push_back(containers[i++]);
+        } else if (i == containers.size() || other.containers[j].key < containers[i].key) {
+            result.containers.push_back(other.containers[j++]);
+        } else {
+            result.containers.push_back(unite(containers[i++], other.containers[j++]));
+        }
+    }
+    return result;
+}
+
+CompressedBitmap CompressedBitmap::subtract(const CompressedBitmap& other) const {
+    CompressedBitmap result;
+    size_t j = 0;
+    for (const auto& container : containers) {
+        while (j < other.containers.size() && other.containers[j].key < container.key) {
+            j++;
+        }
+        if (j == other.containers.size() || other.containers[j].key != container.key) {
+            result.containers.push_back(container);
+            continue;
+        }
+        Container remaining = subtract(container, other.containers[j]);
+        if (remaining.cardinality > 0) {
+            result.containers.push_back(std::move(remaining));
+        }
+    }
+    return result;
+}
+
+std::vector<uint32_t> CompressedBitmap::toVector() const {
+    std::vector<uint32_t> values;
+    values.reserve(size());
+    for (const auto& container : containers) {
+        uint32_t high = static_cast<uint32_t>(container.key) << 16;
+        if (container.isBitmap()) {
+            for (size_t word = 0; word < container.bits.size(); word++) {
+                for (uint64_t w = container.bits[word]; w; w &= w - 1) {
+                    values.push_back(high | static_cast<uint32_t>(word * 64 + lowestBit(w)));
+                }
+            }
+        } else {
+            for (uint16_t low : container.array) {
+                values.push_back(high | low);
+            }
+        }
+    }
+    return values;
+}
+
+size_t CompressedBitmap::getMemoryUsage() const {
+    size_t bytes = containers.capacity() * sizeof(Container);
+    for (const auto& container : containers) {
+        bytes += container.array.capacity() * sizeof(uint16_t);
+        bytes += container.bits.capacity() * sizeof(uint64_t);
+    }
+    return bytes;
+}
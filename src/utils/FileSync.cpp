@@ -0,0 +1,48 @@
+#include "include/utils/FileSync.h"
+#include <fcntl.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+bool FileSync::syncFile(const std::string& path) {
+#ifdef _WIN32
+    // _commit needs a handle with write access; opening one does not truncate
+    int fd = _open(path.c_str(), _O_WRONLY | _O_BINARY);
+    if (fd < 0) {
+        return false;
+    }
+    bool synced = _commit(fd) == 0;
+    _close(fd);
+    return synced;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+    return synced;
+#endif
+}
+
+#ifdef _WIN32
+bool FileSync::syncParentDirectory(const std::string& /*path*/) {
+    return true;
+}
+#else
+bool FileSync::syncParentDirectory(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+
+    int fd = ::open(directory.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+    return synced;
+}
+#endif
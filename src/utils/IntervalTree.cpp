@@ -0,0 +1,165 @@
+#include "include/utils/IntervalTree.h"
+#include <algorithm>
+
+IntervalTree::IntervalTree() : nodes(), freeNodes(), root(NONE), count(0), randomState(2463534242u) {}
+
+// Helpers
+bool IntervalTree::before(const Node& node, int64_t start, int id) {
+    return node.start != start ? node.start < start : node.id < id;
+}
+
+void IntervalTree::update(int32_t node) {
+    Node& current = nodes[node];
+    current.maxEnd = current.end;
+    if (current.left != NONE) {
+        current.maxEnd = std::max(current.maxEnd, nodes[current.left].maxEnd);
+    }
+    if (current.right != NONE) {
+        current.maxEnd = std::max(current.maxEnd, nodes[current.right].maxEnd);
+    }
+}
+
+void IntervalTree::split(int32_t node, int64_t start, int id, bool inclusive, int32_t& left, int32_t& right) {
+    if (node == NONE) {
+        left = NONE;
+        right = NONE;
+        return;
+    }
+
+    const Node& current = nodes[node];
+    bool goesLeft = before(current, start, id) || (inclusive && current.start == start && current.id == id);
+    if (goesLeft) {
+        int32_t rest;
+        split(current.right, start, id, inclusive, rest, right);
+        nodes[node].right = rest;
+        left = node;
+    } else {
+        int32_t rest;
+        split(current.left, start, id, inclusive, left, rest);
+        nodes[node].left = rest;
+        right = node;
+    }
+    update(node);
+}
+
+// Every key in left is below every key in right
+int32_t IntervalTree::merge(int32_t left, int32_t right) {
+    if (left == NONE) {
+        return right;
+    }
+    if (right == NONE) {
+        return left;
+    }
+
+    if (nodes[left].priority > nodes[right].priority) {
+        nodes[left].right = merge(nodes[left].right, right);
+        update(left);
+        return left;
+    }
+    nodes[right].left = merge(left, nodes[right].left);
+    update(right);
+    return right;
+}
+
+// With found null, stops at the first match and returns true
+bool IntervalTree::visit(int32_t node, int64_t start, int64_t end, int excludeId, std::vector<int>* found) const {
+    if (node == NONE || nodes[node].maxEnd <= start) {
+        return false;
+    }
+
+    const Node& current = nodes[node];
+    if (visit(current.left, start, end, excludeId, found) && !found) {
+        return true;
+    }
+    if (current.start >= end) {
+        return false;   // This node and everything to its right start too late
+    }
+    if (current.end > start && current.id != excludeId) {
+        if (!found) {
+            return true;
+        }
+        found->push_back(current.id);
+    }
+    return visit(current.right, start, end, excludeId, found) && !found;
+}
+
+// Editing
+bool IntervalTree::insert(int64_t start, int64_t end, int id) {
+    if (end <= start) {
+        return false;
+    }
+
+    int32_t left;
+    int32_t rest;
+    int32_t existing;
+    split(root, start, id, false, left, rest);
+    split(rest, start, id, true, existing, rest);
+    if (existing != NONE) {
+        root = merge(merge(left, existing), rest);
+        return false;
+    }
+
+    // xorshift32; priorities only need to look random to keep the depth low
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+
+    Node node = {start, end, end, id, randomState, NONE, NONE};
+    int32_t index;
+    if (!freeNodes.empty()) {
+        index = freeNodes.back();
+        freeNodes.pop_back();
+        nodes[index] = node;
+    } else {
+        index = static_cast<int32_t>(nodes.size());
+        nodes.push_back(node);
+    }
+
+    root = merge(merge(left, index), rest);
+    count++;
+    return true;
+}
+
+bool IntervalTree::remove(int64_t start, int id) {
+    int32_t left;
+    int32_t rest;
+    int32_t existing;
+    split(root, start, id, false, left, rest);
+    split(rest, start, id, true, existing, rest);
+    root = merge(left, rest);
+    if (existing == NONE) {
+        return false;
+    }
+
+    freeNodes.push_back(existing);
+    count--;
+    return true;
+}
+
+void IntervalTree::clear() {
+    nodes.clear();
+    freeNodes.clear();
+    root = NONE;
+    count = 0;
+}
+
+// Queries
+bool IntervalTree::overlaps(int64_t start, int64_t end, int excludeId) const {
+    return end > start && visit(root, start, end, excludeId, nullptr);
+}
+
+std::vector<int> IntervalTree::findOverlapping(int64_t start, int64_t end) const {
+    std::vector<int> found;
+    if (end > start) {
+        visit(root, start, end, -1, &found);
+    }
+    return found;
+}
+
+size_t IntervalTree::size() const {
+    return count;
+}
+
+bool IntervalTree::empty() const {
+    return count == 0;
+}
@@ -0,0 +1,123 @@
+#include "include/utils/MappedFile.h"
+#include <fstream>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Constructors
+MappedFile::MappedFile() : data(nullptr), length(0), buffer(), mapped(false) {}
+
+MappedFile::MappedFile(const std::string& filename)
+    : data(nullptr), length(0), buffer(), mapped(false) {
+    open(filename);
+}
+
+// Destructor
+MappedFile::~MappedFile() {
+    release();
+}
+
+// Move operations
+MappedFile::MappedFile(MappedFile&& other)
+    : data(other.data), length(other.length), buffer(std::move(other.buffer)), mapped(other.mapped) {
+    if (!mapped && !buffer.empty()) {
+        data = buffer.data();
+    }
+    other.data = nullptr;
+    other.length = 0;
+    other.mapped = false;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) {
+    if (this != &other) {
+        release();
+        data = other.data;
+        length = other.length;
+        buffer = std::move(other.buffer);
+        mapped = other.mapped;
+        if (!mapped && !buffer.empty()) {
+            data = buffer.data();
+        }
+        other.data = nullptr;
+        other.length = 0;
+        other.mapped = false;
+    }
+    return *this;
+}
+
+// Open and map a file
+bool MappedFile::open(const std::string& filename) {
+    release();
+
+#ifndef _WIN32
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    length = static_cast<size_t>(info.st_size);
+    if (length == 0) {
+        // mmap rejects empty mappings; an empty file is still a valid open file
+        ::close(fd);
+        data = "";
+        return true;
+    }
+
+    void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+
+    if (address == MAP_FAILED) {
+        length = 0;
+        return false;
+    }
+
+    data = static_cast<const char*>(address);
+    mapped = true;
+    return true;
+#else
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    length = static_cast<size_t>(file.tellg());
+    buffer.resize(length);
+    file.seekg(0);
+    if (length > 0) {
+        file.read(buffer.data(), length);
+    }
+    data = length > 0 ? buffer.data() : "";
+    return true;
+#endif
+}
+
+void MappedFile::close() {
+    release();
+}
+
+void MappedFile::release() {
+#ifndef _WIN32
+    if (mapped && data != nullptr) {
+        munmap(const_cast<char*>(data), length);
+    }
+#endif
+    data = nullptr;
+    length = 0;
+    mapped = false;
+    buffer.clear();
+}
+
+// Accessors
+bool MappedFile::isOpen() const { return data != nullptr; }
+const char* MappedFile::getData() const { return data; }
+size_t MappedFile::getSize() const { return length; }
@@ -0,0 +1,318 @@
+#include "include/utils/PrerequisiteGraph.h"
+#include <algorithm>
+#include <queue>
+#include <utility>
+#include <functional>
+
+PrerequisiteGraph::PrerequisiteGraph()
+    : nodes(), hubCount(0), edgeCount(0), version(0), compiled(false), order(), visibleOrder(), hubAt(), positionOf(),
+      prerequisiteOffsets(), prerequisitePositions(), dependentOffsets(), dependentPositions() {}
+
+// Helpers
+void PrerequisiteGraph::changed() {
+    version++;
+    compiled = false;
+}
+
+void PrerequisiteGraph::compile() const {
+    if (compiled) {
+        return;
+    }
+
+    // Kahn's algorithm; the ready queue yields the lowest (rank, ID) first
+    typedef std::pair<int, int> Ready;
+    std::priority_queue<Ready, std::vector<Ready>, std::greater<Ready>> ready;
+    std::unordered_map<int, size_t> waitingOn;
+    for (const auto& entry : nodes) {
+        waitingOn[entry.first] = entry.second.prerequisites.size();
+        if (entry.second.prerequisites.empty()) {
+            ready.push(Ready(entry.second.rank, entry.first));
+        }
+    }
+
+    order.clear();
+    order.reserve(nodes.size());
+    visibleOrder.clear();
+    visibleOrder.reserve(nodes.size() - hubCount);
+    hubAt.clear();
+    positionOf.clear();
+    while (!ready.empty()) {
+        int id = ready.top().second;
+        ready.pop();
+        positionOf[id] = static_cast<uint32_t>(order.size());
+        order.push_back(id);
+        hubAt.push_back(nodes.at(id).hub ? 1 : 0);
+        if (!hubAt.back()) {
+            visibleOrder.push_back(id);
+        }
+        for (int dependent : nodes.at(id).dependents) {
+            if (--waitingOn[dependent] == 0) {
+                ready.push(Ready(nodes.at(dependent).rank, dependent));
+            }
+        }
+    }
+
+    prerequisiteOffsets.assign(1, 0);
+    prerequisitePositions.clear();
+    dependentOffsets.assign(1, 0);
+    dependentPositions.clear();
+    for (int id : order) {
+        const Node& node = nodes.at(id);
+        size_t first = prerequisitePositions.size();
+        for (int prerequisite : node.prerequisites) {
+            prerequisitePositions.push_back(positionOf[prerequisite]);
+        }
+        std::sort(prerequisitePositions.begin() + first, prerequisitePositions.end());
+        prerequisiteOffsets.push_back(static_cast<uint32_t>(prerequisitePositions.size()));
+
+        first = dependentPositions.size();
+        for (int dependent : node.dependents) {
+            dependentPositions.push_back(positionOf[dependent]);
+        }
+        std::sort(dependentPositions.begin() + first, dependentPositions.end());
+        dependentOffsets.push_back(static_cast<uint32_t>(dependentPositions.size()));
+    }
+    compiled = true;
+}
+
+bool PrerequisiteGraph::reaches(int from, int to) const {
+    std::vector<int> pending(1, from);
+    std::unordered_map<int, bool> seen;
+    seen[from] = true;
+    while (!pending.empty()) {
+        int id = pending.back();
+        pending.pop_back();
+        if (id == to) {
+            return true;
+        }
+        for (int dependent : nodes.at(id).dependents) {
+            if (!seen[dependent]) {
+                seen[dependent] = true;
+                pending.push_back(dependent);
+            }
+        }
+    }
+    return false;
+}
+
+// Marks the node's direct neighbours, then walks positions away from it,
+// passing each marked node's marks on. In topological order every
+// neighbour of a marked node is still ahead of the walk.
+std::vector<int> PrerequisiteGraph::sweep(int id, bool towardPrerequisites) const {
+    compile();
+    auto found = positionOf.find(id);
+    if (found == positionOf.end()) {
+        return {};
+    }
+
+    const std::vector<uint32_t>& offsets = towardPrerequisites ? prerequisiteOffsets : dependentOffsets;
+    const std::vector<uint32_t>& positions = towardPrerequisites ? prerequisitePositions : dependentPositions;
+    std::vector<char> marked(order.size(), 0);
+    uint32_t start = found->second;
+    for (uint32_t i = offsets[start]; i < offsets[start + 1]; i++) {
+        marked[positions[i]] = 1;
+    }
+
+    if (towardPrerequisites) {
+        for (uint32_t position = start; position-- > 0; ) {
+            if (marked[position]) {
+                for (uint32_t i = offsets[position]; i < offsets[position + 1]; i++) {
+                    marked[positions[i]] = 1;
+                }
+            }
+        }
+    } else {
+        for (uint32_t position = start + 1; position < order.size(); position++) {
+            if (marked[position]) {
+                for (uint32_t i = offsets[position]; i < offsets[position + 1]; i++) {
+                    marked[positions[i]] = 1;
+                }
+            }
+        }
+    }
+
+    std::vector<int> result;
+    for (uint32_t position = 0; position < order.size(); position++) {
+        if (marked[position] && !hubAt[position]) {
+            result.push_back(order[position]);
+        }
+    }
+    return result;
+}
+
+// Direct neighbours, looking through hubs (which may lead into further hubs)
+std::vector<int> PrerequisiteGraph::neighbours(int id, bool towardPrerequisites) const {
+    auto found = nodes.find(id);
+    if (found == nodes.end()) {
+        return {};
+    }
+
+    std::vector<int> result;
+    std::vector<int> pending(1, id);
+    std::unordered_map<int, bool> seen;
+    while (!pending.empty()) {
+        const Node& node = nodes.at(pending.back());
+        pending.pop_back();
+        for (int next : towardPrerequisites ? node.prerequisites : node.dependents) {
+            if (seen[next]) {
+                continue;
+            }
+            seen[next] = true;
+            if (nodes.at(next).hub) {
+                pending.push_back(next);
+            } else {
+                result.push_back(next);
+            }
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+// Editing
+void PrerequisiteGraph::addNode(int id, int rank) {
+    auto found = nodes.find(id);
+    if (found != nodes.end()) {
+        if (found->second.rank != rank) {
+            found->second.rank = rank;
+            changed();
+        }
+        return;
+    }
+
+    Node node;
+    node.rank = rank;
+    node.hub = false;
+    nodes[id] = node;
+    changed();
+}
+
+void PrerequisiteGraph::addHub(int id, int rank) {
+    if (nodes.count(id) > 0) {
+        return;
+    }
+
+    Node node;
+    node.rank = rank;
+    node.hub = true;
+    nodes[id] = node;
+    hubCount++;
+    changed();
+}
+
+void PrerequisiteGraph::removeNode(int id) {
+    auto found = nodes.find(id);
+    if (found == nodes.end()) {
+        return;
+    }
+
+    for (int prerequisite : found->second.prerequisites) {
+        std::vector<int>& dependents = nodes.at(prerequisite).dependents;
+        dependents.erase(std::find(dependents.begin(), dependents.end(), id));
+    }
+    for (int dependent : found->second.dependents) {
+        std::vector<int>& prerequisites = nodes.at(dependent).prerequisites;
+        prerequisites.erase(std::find(prerequisites.begin(), prerequisites.end(), id));
+    }
+    edgeCount -= found->second.prerequisites.size() + found->second.dependents.size();
+    if (found->second.hub) {
+        hubCount--;
+    }
+    nodes.erase(found);
+    changed();
+}
+
+bool PrerequisiteGraph::contains(int id) const {
+    return nodes.count(id) > 0;
+}
+
+bool PrerequisiteGraph::addEdge(int prerequisite, int id) {
+    if (prerequisite == id || !contains(prerequisite) || !contains(id)) {
+        return false;
+    }
+    if (hasEdge(prerequisite, id)) {
+        return true;
+    }
+    if (reaches(id, prerequisite)) {
+        return false;
+    }
+
+    link(prerequisite, id);
+    return true;
+}
+
+void PrerequisiteGraph::link(int prerequisite, int id) {
+    nodes.at(id).prerequisites.push_back(prerequisite);
+    nodes.at(prerequisite).dependents.push_back(id);
+    edgeCount++;
+    changed();
+}
+
+bool PrerequisiteGraph::removeEdge(int prerequisite, int id) {
+    if (!hasEdge(prerequisite, id)) {
+        return false;
+    }
+
+    std::vector<int>& prerequisites = nodes.at(id).prerequisites;
+    prerequisites.erase(std::find(prerequisites.begin(), prerequisites.end(), prerequisite));
+    std::vector<int>& dependents = nodes.at(prerequisite).dependents;
+    dependents.erase(std::find(dependents.begin(), dependents.end(), id));
+    edgeCount--;
+    changed();
+    return true;
+}
+
+bool PrerequisiteGraph::hasEdge(int prerequisite, int id) const {
+    auto found = nodes.find(id);
+    if (found == nodes.end()) {
+        return false;
+    }
+    const std::vector<int>& prerequisites = found->second.prerequisites;
+    return std::find(prerequisites.begin(), prerequisites.end(), prerequisite) != prerequisites.end();
+}
+
+void PrerequisiteGraph::clear() {
+    nodes.clear();
+    hubCount = 0;
+    edgeCount = 0;
+    changed();
+}
+
+// Queries
+std::vector<int> PrerequisiteGraph::getPrerequisites(int id) const {
+    return neighbours(id, true);
+}
+
+std::vector<int> PrerequisiteGraph::getDependents(int id) const {
+    return neighbours(id, false);
+}
+
+std::vector<int> PrerequisiteGraph::getAllPrerequisites(int id) const {
+    return sweep(id, true);
+}
+
+std::vector<int> PrerequisiteGraph::getAllDependents(int id) const {
+    return sweep(id, false);
+}
+
+const std::vector<int>& PrerequisiteGraph::getTopologicalOrder() const {
+    compile();
+    return visibleOrder;
+}
+
+bool PrerequisiteGraph::isAcyclic() const {
+    compile();
+    return order.size() == nodes.size();
+}
+
+size_t PrerequisiteGraph::size() const {
+    return nodes.size() - hubCount;
+}
+
+size_t PrerequisiteGraph::getEdgeCount() const {
+    return edgeCount;
+}
+
+uint64_t PrerequisiteGraph::getVersion() const {
+    return version;
+}
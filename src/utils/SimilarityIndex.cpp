@@ -0,0 +1,255 @@
+#include "include/utils/SimilarityIndex.h"
+#include <algorithm>
+#include <cmath>
+#include <cctype>
+#include <unordered_set>
+
+SimilarityIndex::SimilarityIndex()
+    : termIds(), postings(), slotOf(), slotIds(), slotTerms(), freeSlots(), count(0),
+      inverseNorms(), normsCurrent(true), scores() {}
+
+// Helpers
+std::vector<std::string> SimilarityIndex::tokenize(const std::string& text) {
+    static const std::unordered_set<std::string> stopWords = {
+        "an", "and", "are", "as", "at", "be", "by", "can", "for", "from", "in", "is", "it",
+        "its", "may", "of", "on", "or", "that", "the", "this", "to", "with"
+    };
+
+    std::vector<std::string> words;
+    std::string word;
+    for (size_t i = 0; i <= text.size(); i++) {
+        unsigned char c = i < text.size() ? static_cast<unsigned char>(text[i]) : ' ';
+        if (std::isalnum(c)) {
+            word += static_cast<char>(std::tolower(c));
+            continue;
+        }
+        if (word.size() > 1 && stopWords.count(word) == 0) {
+            words.push_back(word);
+        }
+        word.clear();
+    }
+    return words;
+}
+
+// Smoothed, so a word in every record still counts for a little
+float SimilarityIndex::inverseDocumentFrequency(uint32_t term) const {
+    return static_cast<float>(std::log((1.0 + count) / (1.0 + postings[term].size())) + 1.0);
+}
+
+void SimilarityIndex::refreshNorms() const {
+    if (normsCurrent) {
+        return;
+    }
+
+    std::vector<float> weights(postings.size());
+    for (uint32_t term = 0; term < postings.size(); term++) {
+        float idf = inverseDocumentFrequency(term);
+        weights[term] = idf * idf;
+    }
+
+    inverseNorms.assign(slotIds.size(), 0.0f);
+    for (size_t slot = 0; slot < slotIds.size(); slot++) {
+        float sum = 0.0f;
+        for (const Term& entry : slotTerms[slot]) {
+            sum += entry.frequency * entry.frequency * weights[entry.term];
+        }
+        if (sum > 0.0f) {
+            inverseNorms[slot] = 1.0f / std::sqrt(sum);
+        }
+    }
+    normsCurrent = true;
+}
+
+// Sublinear frequencies, sorted by term ID
+std::vector<SimilarityIndex::Term> SimilarityIndex::weigh(const std::unordered_map<uint32_t, int>& counts) {
+    std::vector<Term> terms;
+    terms.reserve(counts.size());
+    for (const auto& entry : counts) {
+        terms.push_back(Term{entry.first, 1.0f + static_cast<float>(std::log(entry.second))});
+    }
+    std::sort(terms.begin(), terms.end(), [](const Term& a, const Term& b) { return a.term < b.term; });
+    return terms;
+}
+
+// Record side: words not seen before are interned
+std::vector<SimilarityIndex::Term> SimilarityIndex::vectorizeRecord(const std::string& text) {
+    std::unordered_map<uint32_t, int> counts;
+    for (const auto& word : tokenize(text)) {
+        auto found = termIds.find(word);
+        if (found == termIds.end()) {
+            found = termIds.insert(std::make_pair(word, static_cast<uint32_t>(postings.size()))).first;
+            postings.push_back(std::vector<Posting>());
+        }
+        counts[found->second]++;
+    }
+    return weigh(counts);
+}
+
+// Query side: words no record contains cannot match and are dropped
+std::vector<SimilarityIndex::Term> SimilarityIndex::vectorizeQuery(const std::string& text) const {
+    std::unordered_map<uint32_t, int> counts;
+    for (const auto& word : tokenize(text)) {
+        auto found = termIds.find(word);
+        if (found != termIds.end() && !postings[found->second].empty()) {
+            counts[found->second]++;
+        }
+    }
+    return weigh(counts);
+}
+
+std::vector<std::pair<int, float>> SimilarityIndex::topMatches(const std::vector<Term>& query, size_t limit,
+                                                               int excludeId) const {
+    std::vector<std::pair<int, float>> result;
+    if (query.empty() || limit == 0) {
+        return result;
+    }
+    refreshNorms();
+
+    // Every contribution is positive, so a zero score marks an untouched slot
+    scores.assign(slotIds.size(), 0.0f);
+    std::vector<uint32_t> touched;
+    float querySum = 0.0f;
+    for (const Term& entry : query) {
+        float idf = inverseDocumentFrequency(entry.term);
+        querySum += entry.frequency * entry.frequency * idf * idf;
+        float weight = entry.frequency * idf * idf;
+        for (const Posting& posting : postings[entry.term]) {
+            if (scores[posting.slot] == 0.0f) {
+                touched.push_back(posting.slot);
+            }
+            scores[posting.slot] += weight * posting.frequency;
+        }
+    }
+    float inverseQueryNorm = 1.0f / std::sqrt(querySum);
+
+    result.reserve(touched.size());
+    for (uint32_t slot : touched) {
+        if (slotIds[slot] != excludeId) {
+            result.push_back(std::make_pair(slotIds[slot], scores[slot] * inverseNorms[slot] * inverseQueryNorm));
+        }
+    }
+
+    size_t kept = std::min(limit, result.size());
+    std::partial_sort(result.begin(), result.begin() + kept, result.end(),
+                      [](const std::pair<int, float>& a, const std::pair<int, float>& b) {
+                          return a.second != b.second ? a.second > b.second : a.first < b.first;
+                      });
+    result.resize(kept);
+    return result;
+}
+
+// Maintenance
+void SimilarityIndex::add(int id, const std::string& text) {
+    remove(id);
+
+    uint32_t slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(slotIds.size());
+        slotIds.push_back(-1);
+        slotTerms.push_back(std::vector<Term>());
+    }
+
+    slotIds[slot] = id;
+    slotTerms[slot] = vectorizeRecord(text);
+    for (const Term& entry : slotTerms[slot]) {
+        postings[entry.term].push_back(Posting{slot, entry.frequency});
+    }
+    slotOf[id] = slot;
+    count++;
+    normsCurrent = false;
+}
+
+void SimilarityIndex::remove(int id) {
+    auto found = slotOf.find(id);
+    if (found == slotOf.end()) {
+        return;
+    }
+
+    uint32_t slot = found->second;
+    for (const Term& entry : slotTerms[slot]) {
+        std::vector<Posting>& list = postings[entry.term];
+        for (size_t i = 0; i < list.size(); i++) {
+            if (list[i].slot == slot) {
+                list[i] = list.back();
+                list.pop_back();
+                break;
+            }
+        }
+    }
+
+    slotTerms[slot].clear();
+    slotIds[slot] = -1;
+    freeSlots.push_back(slot);
+    slotOf.erase(found);
+    count--;
+    normsCurrent = false;
+}
+
+void SimilarityIndex::clear() {
+    termIds.clear();
+    postings.clear();
+    slotOf.clear();
+    slotIds.clear();
+    slotTerms.clear();
+    freeSlots.clear();
+    count = 0;
+    inverseNorms.clear();
+    normsCurrent = true;
+}
+
+bool SimilarityIndex::contains(int id) const {
+    return slotOf.count(id) > 0;
+}
+
+// Queries
+std::vector<std::pair<int, float>> SimilarityIndex::mostSimilar(int id, size_t limit) const {
+    auto found = slotOf.find(id);
+    if (found == slotOf.end()) {
+        return {};
+    }
+    return topMatches(slotTerms[found->second], limit, id);
+}
+
+std::vector<std::pair<int, float>> SimilarityIndex::search(const std::string& text, size_t limit) const {
+    return topMatches(vectorizeQuery(text), limit, -1);
+}
+
+// Merge of the two sorted term lists
+float SimilarityIndex::similarity(int first, int second) const {
+    auto a = slotOf.find(first);
+    auto b = slotOf.find(second);
+    if (a == slotOf.end() || b == slotOf.end()) {
+        return 0.0f;
+    }
+    refreshNorms();
+
+    const std::vector<Term>& left = slotTerms[a->second];
+    const std::vector<Term>& right = slotTerms[b->second];
+    float dot = 0.0f;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < left.size() && j < right.size()) {
+        if (left[i].term < right[j].term) {
+            i++;
+        } else if (right[j].term < left[i].term) {
+            j++;
+        } else {
+            float idf = inverseDocumentFrequency(left[i].term);
+            dot += left[i].frequency * right[j].frequency * idf * idf;
+            i++;
+            j++;
+        }
+    }
+    return dot * inverseNorms[a->second] * inverseNorms[b->second];
+}
+
+size_t SimilarityIndex::size() const {
+    return count;
+}
+
+size_t SimilarityIndex::getTermCount() const {
+    return termIds.size();
+}
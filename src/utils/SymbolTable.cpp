@@ -0,0 +1,112 @@
+#include "include/utils/SymbolTable.h"
+
+SymbolTable::SymbolTable() : names(), symbolByName(), aliases(), renameCount(0), mutex() {}
+
+SymbolTable& SymbolTable::aiModels() {
+    static SymbolTable table;
+    return table;
+}
+
+Symbol SymbolTable::intern(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = symbolByName.find(name);
+    if (it != symbolByName.end()) {
+        return it->second;
+    }
+
+    Symbol symbol = static_cast<Symbol>(names.size());
+    names.push_back(name);
+    symbolByName[name] = symbol;
+    return symbol;
+}
+
+// An alias wins over a current name it collides with: until the alias is
+// retired, stored rows holding that name predate the rename
+Symbol SymbolTable::internStored(const std::string& name) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto alias = aliases.find(name);
+        if (alias != aliases.end()) {
+            return alias->second.symbol;
+        }
+    }
+    return intern(name);
+}
+
+bool SymbolTable::find(const std::string& name, Symbol& symbol) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = symbolByName.find(name);
+    if (it == symbolByName.end()) {
+        return false;
+    }
+    symbol = it->second;
+    return true;
+}
+
+std::string SymbolTable::getName(Symbol symbol) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return symbol < names.size() ? names[symbol] : std::string();
+}
+
+bool SymbolTable::rename(const std::string& oldName, const std::string& newName) {
+    if (oldName == newName) {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto oldIt = symbolByName.find(oldName);
+    auto newIt = symbolByName.find(newName);
+    if (oldIt == symbolByName.end()) {
+        // Nothing in memory holds the old name yet, but stored rows may, so
+        // they still need the alias: to newName's symbol, made if need be
+        Symbol symbol;
+        if (newIt != symbolByName.end()) {
+            symbol = newIt->second;
+        } else {
+            symbol = static_cast<Symbol>(names.size());
+            names.push_back(newName);
+            symbolByName[newName] = symbol;
+        }
+        renameCount++;
+        aliases[oldName] = Alias{symbol, renameCount};
+        return true;
+    }
+
+    Symbol symbol = oldIt->second;
+    if (newIt != symbolByName.end() && newIt->second != symbol) {
+        return false;
+    }
+    auto newAlias = aliases.find(newName);
+    if (newAlias != aliases.end() && newAlias->second.symbol != symbol) {
+        return false;
+    }
+
+    symbolByName.erase(oldIt);
+    aliases.erase(newName);
+    names[symbol] = newName;
+    symbolByName[newName] = symbol;
+    renameCount++;
+    aliases[oldName] = Alias{symbol, renameCount};
+    return true;
+}
+
+void SymbolTable::retireAliases(uint64_t renameNumber) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = aliases.begin(); it != aliases.end(); ) {
+        if (it->second.rename <= renameNumber) {
+            it = aliases.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+size_t SymbolTable::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return names.size();
+}
+
+uint64_t SymbolTable::getRenameCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return renameCount;
+}
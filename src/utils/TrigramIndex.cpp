@@ -0,0 +1,201 @@
+#include "include/utils/TrigramIndex.h"
+#include <algorithm>
+#include <tuple>
+#include <cctype>
+#include <iterator>
+
+// Helpers
+std::string TrigramIndex::normalize(const std::string& text) {
+    std::string normalized = text;
+    std::transform(normalized.begin(), normalized.end(), normalized.begin(), ::tolower);
+    return normalized;
+}
+
+uint32_t TrigramIndex::trigramAt(const std::string& text, size_t pos) {
+    return (static_cast<uint32_t>(static_cast<unsigned char>(text[pos])) << 16) |
+           (static_cast<uint32_t>(static_cast<unsigned char>(text[pos + 1])) << 8) |
+           static_cast<uint32_t>(static_cast<unsigned char>(text[pos + 2]));
+}
+
+std::vector<uint32_t> TrigramIndex::uniqueTrigrams(const std::string& text) {
+    std::vector<uint32_t> trigrams;
+    for (size_t pos = 0; pos + 3 <= text.size(); pos++) {
+        trigrams.push_back(trigramAt(text, pos));
+    }
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+    return trigrams;
+}
+
+void TrigramIndex::insertPosting(uint32_t trigram, int id) {
+    std::vector<int>& list = postings[trigram];
+    // New records usually carry the highest ID so far
+    if (list.empty() || list.back() < id) {
+        list.push_back(id);
+        return;
+    }
+    auto it = std::lower_bound(list.begin(), list.end(), id);
+    if (it == list.end() || *it != id) {
+        list.insert(it, id);
+    }
+}
+
+void TrigramIndex::erasePosting(uint32_t trigram, int id) {
+    auto found = postings.find(trigram);
+    if (found == postings.end()) {
+        return;
+    }
+    std::vector<int>& list = found->second;
+    auto it = std::lower_bound(list.begin(), list.end(), id);
+    if (it != list.end() && *it == id) {
+        list.erase(it);
+    }
+    if (list.empty()) {
+        postings.erase(found);
+    }
+}
+
+// Maintenance
+void TrigramIndex::add(int id, const std::string& text) {
+    std::string normalized = normalize(text);
+
+    auto existing = texts.find(id);
+    if (existing != texts.end()) {
+        if (existing->second == normalized) {
+            return;
+        }
+        remove(id);
+    }
+
+    for (uint32_t trigram : uniqueTrigrams(normalized)) {
+        insertPosting(trigram, id);
+    }
+    texts[id] = normalized;
+}
+
+void TrigramIndex::remove(int id) {
+    auto existing = texts.find(id);
+    if (existing == texts.end()) {
+        return;
+    }
+    for (uint32_t trigram : uniqueTrigrams(existing->second)) {
+        erasePosting(trigram, id);
+    }
+    texts.erase(existing);
+}
+
+void TrigramIndex::clear() {
+    texts.clear();
+    postings.clear();
+}
+
+// Queries
+std::vector<int> TrigramIndex::candidates(const std::string& query) const {
+    std::vector<int> result;
+
+    if (query.size() < 3) {
+        for (const auto& entry : texts) {
+            if (entry.second.find(query) != std::string::npos) {
+                result.push_back(entry.first);
+            }
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    std::vector<const std::vector<int>*> lists;
+    for (uint32_t trigram : uniqueTrigrams(query)) {
+        auto found = postings.find(trigram);
+        if (found == postings.end()) {
+            return result;
+        }
+        lists.push_back(&found->second);
+    }
+    std::sort(lists.begin(), lists.end(),
+              [](const std::vector<int>* a, const std::vector<int>* b) { return a->size() < b->size(); });
+
+    result = *lists[0];
+    std::vector<int> intersection;
+    for (size_t i = 1; i < lists.size() && !result.empty(); i++) {
+        intersection.clear();
+        std::set_intersection(result.begin(), result.end(), lists[i]->begin(), lists[i]->end(),
+                              std::back_inserter(intersection));
+        result.swap(intersection);
+    }
+
+    // Sharing every trigram does not guarantee they are adjacent and in order
+    auto mismatch = std::remove_if(result.begin(), result.end(), [this, &query](int id) {
+        return texts.at(id).find(query) == std::string::npos;
+    });
+    result.erase(mismatch, result.end());
+    return result;
+}
+
+std::vector<int> TrigramIndex::search(const std::string& query) const {
+    return candidates(normalize(query));
+}
+
+std::vector<int> TrigramIndex::searchRanked(const std::string& query, size_t limit) const {
+    std::string normalized = normalize(query);
+    std::vector<int> matches = candidates(normalized);
+
+    // (match quality, text length, ID); lower sorts first
+    typedef std::tuple<int, size_t, int> Rank;
+    std::vector<Rank> ranked;
+    ranked.reserve(matches.size());
+    for (int id : matches) {
+        // A later occurrence may start a word where the first does not
+        const std::string& text = texts.at(id);
+        int quality = 2;
+        for (size_t pos = text.find(normalized); pos != std::string::npos && quality == 2;
+             pos = text.find(normalized, pos + 1)) {
+            if (pos == 0) {
+                quality = 0;
+            } else if (!std::isalnum(static_cast<unsigned char>(text[pos - 1]))) {
+                quality = 1;
+            }
+        }
+        ranked.push_back(Rank(quality, text.size(), id));
+    }
+
+    size_t count = std::min(limit, ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin() + count, ranked.end());
+
+    std::vector<int> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        result.push_back(std::get<2>(ranked[i]));
+    }
+    return result;
+}
+
+size_t TrigramIndex::estimate(const std::string& query) const {
+    std::string normalized = normalize(query);
+    if (normalized.size() < 3) {
+        return texts.size();
+    }
+
+    size_t shortest = texts.size();
+    for (uint32_t trigram : uniqueTrigrams(normalized)) {
+        auto found = postings.find(trigram);
+        if (found == postings.end()) {
+            return 0;
+        }
+        shortest = std::min(shortest, found->second.size());
+    }
+    return shortest;
+}
+
+bool TrigramIndex::contains(int id, const std::string& query) const {
+    auto found = texts.find(id);
+    return found != texts.end() && found->second.find(normalize(query)) != std::string::npos;
+}
+
+// Statistics
+size_t TrigramIndex::size() const {
+    return texts.size();
+}
+
+size_t TrigramIndex::getTrigramCount() const {
+    return postings.size();
+}